@@ -0,0 +1,444 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+/*
+ * sst-effects-bench runs every bus effect (through ConcreteConfig) and every
+ * voice effect (through a small VFXConfig) over a fixed stretch of audio and
+ * reports the cost of doing so. For each effect and sample rate we report
+ *
+ * - ns/sample, measured with the steady clock
+ * - the percentage of one core needed to run the effect in realtime
+ * - cycles per block, from the time stamp counter where we have one
+ *
+ * A human readable table goes to stdout and, with --json, a JSON document
+ * goes to a file (or stdout with `--json -`) so runs can be diffed in CI.
+ *
+ * Usage: sst-effects-bench [--seconds s] [--filter substr] [--json file]
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fmt/core.h>
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) &&          \
+    !defined(_M_ARM64EC)
+#define SST_EFFECTS_BENCH_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define SST_EFFECTS_BENCH_HAS_TSC 0
+#endif
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/effects/ConcreteConfig.h"
+
+#include "sst/effects/Delay.h"
+#include "sst/effects/FloatyDelay.h"
+#include "sst/effects/Flanger.h"
+#include "sst/effects/Reverb1.h"
+#include "sst/effects/Bonsai.h"
+#include "sst/effects/Phaser.h"
+#include "sst/effects/Reverb2.h"
+#include "sst/effects/TreeMonster.h"
+#include "sst/effects/Nimbus.h"
+#include "sst/effects/NimbusImpl.h"
+#include "sst/effects/RotarySpeaker.h"
+
+#include "sst/voice-effects/distortion/BitCrusher.h"
+#include "sst/voice-effects/delay/Microgate.h"
+#include "sst/voice-effects/distortion/Slewer.h"
+#include "sst/voice-effects/distortion/TreeMonster.h"
+#include "sst/voice-effects/modulation/RingMod.h"
+#include "sst/voice-effects/waveshaper/WaveShaper.h"
+#include "sst/voice-effects/modulation/FreqShiftMod.h"
+#include "sst/voice-effects/modulation/PhaseMod.h"
+#include "sst/voice-effects/generator/GenCorrelatedNoise.h"
+#include "sst/voice-effects/eq/EqNBandParametric.h"
+#include "sst/voice-effects/eq/MorphEQ.h"
+#include "sst/voice-effects/eq/TiltEQ.h"
+#include "sst/voice-effects/eq/EqGraphic6Band.h"
+#include "sst/voice-effects/delay/Widener.h"
+#include "sst/voice-effects/delay/ShortDelay.h"
+#include "sst/voice-effects/generator/StringResonator.h"
+#include "sst/voice-effects/generator/FourVoiceResonator.h"
+#include "sst/voice-effects/filter/StaticPhaser.h"
+#include "sst/voice-effects/modulation/ShepardPhaser.h"
+#include "sst/voice-effects/modulation/Tremolo.h"
+#include "sst/voice-effects/modulation/Flanger.h"
+#include "sst/voice-effects/modulation/Phaser.h"
+#include "sst/voice-effects/modulation/FMFilter.h"
+#include "sst/voice-effects/generator/TiltNoise.h"
+#include "sst/voice-effects/generator/EllipticBlepWaveforms.h"
+#include "sst/voice-effects/modulation/NoiseAM.h"
+#include "sst/voice-effects/utilities/StereoTool.h"
+#include "sst/voice-effects/utilities/VolumeAndPan.h"
+#include "sst/voice-effects/utilities/GainMatrix.h"
+
+#include "sst/voice-effects/lifted_bus_effects/LiftedReverb1.h"
+#include "sst/voice-effects/lifted_bus_effects/LiftedReverb2.h"
+#include "sst/voice-effects/lifted_bus_effects/LiftedDelay.h"
+
+namespace sfx = sst::effects;
+namespace svfx = sst::voice_effects;
+
+struct BenchVFXConfig
+{
+    struct BaseClass
+    {
+        std::array<float, 256> fb{};
+        std::array<int, 256> ib{};
+        float sampleRate{48000.f};
+    };
+    static constexpr int blockSize{16};
+    static void setFloatParam(BaseClass *b, int i, float f) { b->fb[i] = f; }
+    static float getFloatParam(const BaseClass *b, int i) { return b->fb[i]; }
+
+    static void setIntParam(BaseClass *b, int i, int v) { b->ib[i] = v; }
+    static int getIntParam(const BaseClass *b, int i) { return b->ib[i]; }
+
+    static float dbToLinear(const BaseClass *, float f) { return std::pow(10.f, f / 20.f); }
+    static float equalNoteToPitch(const BaseClass *, float f) { return pow(2.f, (f + 69) / 12.f); }
+    static float getSampleRate(const BaseClass *b) { return b->sampleRate; }
+    static float getSampleRateInv(const BaseClass *b) { return 1.0 / b->sampleRate; }
+
+    static void preReservePool(BaseClass *, size_t) {}
+    static void preReserveSingleInstancePool(BaseClass *, size_t) {}
+    static uint8_t *checkoutBlock(BaseClass *, size_t s) { return (uint8_t *)malloc(s); }
+    static void returnBlock(BaseClass *, uint8_t *p, size_t) { free(p); }
+};
+
+static_assert(sfx::core::ConcreteConfig::blockSize == BenchVFXConfig::blockSize);
+static constexpr int blockSize{BenchVFXConfig::blockSize};
+
+struct BenchOptions
+{
+    double seconds{5.0};
+    std::string filter{};
+    std::string jsonFile{};
+    std::vector<double> sampleRates{44100.0, 48000.0, 96000.0, 192000.0};
+};
+
+struct BenchResult
+{
+    std::string name;
+    std::string kind;
+    double sampleRate{0};
+    uint64_t blocks{0};
+    double nsPerSample{0};
+    double cpuPercent{0};
+    double cyclesPerBlock{0};
+};
+
+inline uint64_t cycleCount()
+{
+#if SST_EFFECTS_BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * A deterministic, non-silent stereo signal. A saw and a square at unrelated
+ * frequencies with a touch of noise, so nothing in the effects can settle into
+ * a denormal or silent fast path and skew the numbers.
+ */
+struct SignalSource
+{
+    float phaseL{0.f}, phaseR{0.3f};
+    uint32_t seed{22};
+
+    void fill(float *L, float *R, double sampleRate)
+    {
+        auto dL = (float)(110.0 / sampleRate), dR = (float)(173.3 / sampleRate);
+        for (int s = 0; s < blockSize; ++s)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            auto noise = ((float)(seed >> 8) / (float)(1 << 24) - 0.5f) * 0.02f;
+            L[s] = 0.5f * (phaseL * 2 - 1) + noise;
+            R[s] = 0.45f * (phaseR > 0.5f ? 1 : -1) - noise;
+            phaseL += dL;
+            phaseR += dR;
+            if (phaseL > 1)
+                phaseL -= 1;
+            if (phaseR > 1)
+                phaseR -= 1;
+        }
+    }
+};
+
+/*
+ * Run a block processing callback over `seconds` of audio and time it. The
+ * input is regenerated every block into fresh buffers; that copy is in the
+ * timed region but is a trivial fraction of any effect.
+ */
+template <typename Proc>
+BenchResult timeBlocks(const std::string &name, const std::string &kind, double sampleRate,
+                       const BenchOptions &opt, Proc &&proc)
+{
+    float inL alignas(16)[blockSize], inR alignas(16)[blockSize];
+    float outL alignas(16)[blockSize], outR alignas(16)[blockSize];
+
+    SignalSource src;
+    auto warmupBlocks = (uint64_t)(0.25 * sampleRate / blockSize);
+    for (uint64_t b = 0; b < warmupBlocks; ++b)
+    {
+        src.fill(inL, inR, sampleRate);
+        proc(inL, inR, outL, outR);
+    }
+
+    auto blocks = std::max((uint64_t)1, (uint64_t)(opt.seconds * sampleRate / blockSize));
+
+    auto c0 = cycleCount();
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint64_t b = 0; b < blocks; ++b)
+    {
+        src.fill(inL, inR, sampleRate);
+        proc(inL, inR, outL, outR);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    auto c1 = cycleCount();
+
+    auto ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+    BenchResult res;
+    res.name = name;
+    res.kind = kind;
+    res.sampleRate = sampleRate;
+    res.blocks = blocks;
+    res.nsPerSample = ns / (double)(blocks * blockSize);
+    // a second of audio takes sampleRate * nsPerSample nanoseconds to compute
+    res.cpuPercent = res.nsPerSample * sampleRate * 1e-9 * 100.0;
+    res.cyclesPerBlock = (double)(c1 - c0) / (double)blocks;
+    return res;
+}
+
+template <typename FX> BenchResult benchBusEffect(double sampleRate, const BenchOptions &opt)
+{
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(sampleRate);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+    fx->initialize();
+
+    return timeBlocks(FX::streamingName, "bus", sampleRate, opt,
+                      [&fx](float *inL, float *inR, float *, float *) {
+                          fx->processBlock(inL, inR);
+                      });
+}
+
+template <typename FX, typename... Args>
+BenchResult benchVoiceEffect(double sampleRate, const BenchOptions &opt, Args &...args)
+{
+    auto fx = std::make_unique<FX>(args...);
+    fx->sampleRate = (float)sampleRate;
+    fx->initVoiceEffectParams();
+    if constexpr (requires { fx->initVoiceEffect(); })
+        fx->initVoiceEffect();
+
+    return timeBlocks(FX::streamingName, "voice", sampleRate, opt,
+                      [&fx](float *inL, float *inR, float *outL, float *outR) {
+                          fx->processStereo(inL, inR, outL, outR, 0.f);
+                      });
+}
+
+struct BenchEntry
+{
+    std::string key;
+    std::function<BenchResult(double, const BenchOptions &)> run;
+};
+
+std::vector<BenchEntry> allBenchmarks()
+{
+    static sst::basic_blocks::tables::SurgeSincTableProvider sinc;
+    static sst::basic_blocks::tables::SimpleSineProvider sine;
+
+    // EqNBandParametric has a second template argument which doesn't survive the macro below
+    using ParametricEQ1 = svfx::eq::EqNBandParametric<BenchVFXConfig, 1>;
+    using ParametricEQ2 = svfx::eq::EqNBandParametric<BenchVFXConfig, 2>;
+    using ParametricEQ3 = svfx::eq::EqNBandParametric<BenchVFXConfig, 3>;
+
+    std::vector<BenchEntry> res;
+
+#define BUS_FX(key, cls)                                                                           \
+    res.push_back({key, [](double sr, const BenchOptions &o) {                                     \
+                       return benchBusEffect<sfx::cls<sfx::core::ConcreteConfig>>(sr, o);          \
+                   }});
+#define VOICE_FX_T(key, T, ...)                                                                    \
+    res.push_back({key, [](double sr, const BenchOptions &o) {                                     \
+                       return benchVoiceEffect<T>(sr, o __VA_OPT__(, ) __VA_ARGS__);              \
+                   }});
+#define VOICE_FX(key, cls, ...) VOICE_FX_T(key, svfx::cls<BenchVFXConfig>, __VA_ARGS__)
+
+    BUS_FX("reverb1", reverb1::Reverb1);
+    BUS_FX("reverb2", reverb2::Reverb2);
+    BUS_FX("delay", delay::Delay);
+    BUS_FX("floatydelay", floatydelay::FloatyDelay);
+    BUS_FX("flanger", flanger::Flanger);
+    BUS_FX("phaser", phaser::Phaser);
+    BUS_FX("rotaryspeaker", rotaryspeaker::RotarySpeaker);
+    BUS_FX("treemonster", treemonster::TreeMonster);
+    BUS_FX("bonsai", bonsai::Bonsai);
+    BUS_FX("nimbus", nimbus::Nimbus);
+
+    VOICE_FX("v-microgate", delay::MicroGate, sinc);
+    VOICE_FX("v-bitcrusher", distortion::BitCrusher);
+    VOICE_FX("v-slewer", distortion::Slewer);
+    VOICE_FX("v-treemonster", distortion::TreeMonster);
+    VOICE_FX("v-ringmod", modulation::RingMod);
+    VOICE_FX("v-waveshaper", waveshaper::WaveShaper);
+    VOICE_FX("v-freqshiftmod", modulation::FreqShiftMod);
+    VOICE_FX("v-phasemod", modulation::PhaseMod);
+    VOICE_FX("v-gencorrelatednoise", generator::GenCorrelatedNoise);
+    VOICE_FX("v-fourvoiceresonator", generator::FourVoiceResonator, sine);
+    VOICE_FX_T("v-eqparametric1", ParametricEQ1);
+    VOICE_FX_T("v-eqparametric2", ParametricEQ2);
+    VOICE_FX_T("v-eqparametric3", ParametricEQ3);
+    VOICE_FX("v-morpheq", eq::MorphEQ);
+    VOICE_FX("v-tilteq", eq::TiltEQ);
+    VOICE_FX("v-grapheq", eq::EqGraphic6Band);
+    VOICE_FX("v-widener", delay::Widener, sinc);
+    VOICE_FX("v-shortdelay", delay::ShortDelay, sinc);
+    VOICE_FX("v-stringresonator", generator::StringResonator, sinc);
+    VOICE_FX("v-staticphaser", filter::StaticPhaser);
+    VOICE_FX("v-shepardphaser", modulation::ShepardPhaser);
+    VOICE_FX("v-tremolo", modulation::Tremolo);
+    VOICE_FX("v-phaser", modulation::Phaser);
+    VOICE_FX("v-fmfilter", modulation::FMFilter);
+    VOICE_FX("v-tiltnoise", generator::TiltNoise);
+    VOICE_FX("v-ellipticblep", generator::EllipticBlepWaveforms);
+    VOICE_FX("v-noiseam", modulation::NoiseAM);
+    VOICE_FX("v-volumeandpan", utilities::VolumeAndPan);
+    VOICE_FX("v-stereotool", utilities::StereoTool);
+    VOICE_FX("v-gainmatrix", utilities::GainMatrix);
+    VOICE_FX("v-liftedreverb1", liftbus::LiftedReverb1);
+    VOICE_FX("v-liftedreverb2", liftbus::LiftedReverb2);
+    VOICE_FX("v-lifteddelay", liftbus::LiftedDelay);
+    VOICE_FX("v-flanger", modulation::VoiceFlanger, sine);
+
+#undef BUS_FX
+#undef VOICE_FX
+#undef VOICE_FX_T
+
+    return res;
+}
+
+std::string toJSON(const std::vector<BenchResult> &results, const BenchOptions &opt)
+{
+    std::string res = "{\n";
+    res += fmt::format("  \"blockSize\": {},\n", blockSize);
+    res += fmt::format("  \"seconds\": {},\n", opt.seconds);
+    res += fmt::format("  \"hasCycleCounter\": {},\n",
+                       SST_EFFECTS_BENCH_HAS_TSC ? "true" : "false");
+    res += "  \"results\": [\n";
+    for (auto i = 0U; i < results.size(); ++i)
+    {
+        const auto &r = results[i];
+        res += fmt::format("    {{\"name\": \"{}\", \"kind\": \"{}\", \"sampleRate\": {}, "
+                           "\"blocks\": {}, \"nsPerSample\": {:.4f}, \"cpuPercent\": {:.4f}, "
+                           "\"cyclesPerBlock\": {:.1f}}}{}\n",
+                           r.name, r.kind, r.sampleRate, r.blocks, r.nsPerSample, r.cpuPercent,
+                           r.cyclesPerBlock, (i + 1 == results.size()) ? "" : ",");
+    }
+    res += "  ]\n}\n";
+    return res;
+}
+
+int main(int argc, char const *argv[])
+{
+    BenchOptions opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        auto a = std::string(argv[i]);
+        auto hasNext = i + 1 < argc;
+        if (a == "--seconds" && hasNext)
+            opt.seconds = std::atof(argv[++i]);
+        else if (a == "--filter" && hasNext)
+            opt.filter = argv[++i];
+        else if (a == "--json" && hasNext)
+            opt.jsonFile = argv[++i];
+        else
+        {
+            std::cout << "Usage: " << argv[0] << " [--seconds s] [--filter substr] [--json file|-]"
+                      << std::endl;
+            return a == "--help" ? 0 : 1;
+        }
+    }
+
+    auto toStdout = opt.jsonFile == "-";
+    auto &table = toStdout ? std::cerr : std::cout;
+
+    table << fmt::format("{:<24} {:>6} {:>10} {:>12} {:>10} {:>14}\n", "effect", "kind", "sr",
+                         "ns/sample", "cpu %", "cycles/block");
+
+    std::vector<BenchResult> results;
+    for (const auto &b : allBenchmarks())
+    {
+        if (!opt.filter.empty() && b.key.find(opt.filter) == std::string::npos)
+            continue;
+
+        for (auto sr : opt.sampleRates)
+        {
+            auto r = b.run(sr, opt);
+            table << fmt::format("{:<24} {:>6} {:>10.0f} {:>12.3f} {:>10.4f} {:>14.1f}\n", b.key,
+                                 r.kind, sr, r.nsPerSample, r.cpuPercent, r.cyclesPerBlock);
+            table.flush();
+            r.name = b.key;
+            results.push_back(r);
+        }
+    }
+
+    if (!opt.jsonFile.empty())
+    {
+        auto json = toJSON(results, opt);
+        if (toStdout)
+        {
+            std::cout << json;
+        }
+        else
+        {
+            FILE *f = fopen(opt.jsonFile.c_str(), "w");
+            if (!f)
+            {
+                std::cout << "Unable to open '" << opt.jsonFile << "' for writing" << std::endl;
+                return 2;
+            }
+            fputs(json.c_str(), f);
+            fclose(f);
+        }
+    }
+
+    return 0;
+}
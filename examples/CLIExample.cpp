@@ -24,6 +24,17 @@
 #include <cstring>
 #include <cstdint>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <stdio.h>
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
@@ -66,6 +77,14 @@ struct CLIArgBundle
     std::string datfileName{};
     bool launchGnuplot{false};
 
+    // Stream the file through in chunks rather than loading it, and render the tail
+    bool stream{false};
+    size_t chunkFrames{4096};
+    float maxTailSeconds{30.f};
+
+    // batch jobs run many at once, so they keep the per file chatter quiet
+    bool quiet{false};
+
     std::vector<float> fArgs;
     std::vector<int> iArgs;
 };
@@ -180,6 +199,27 @@ struct ConcreteConfig
     static inline float dbToLinear(GlobalStorage *s, float f) { return s->dbtlp.dbToLinear(f); }
 };
 
+/*
+ * Batch workers each own one of these. GlobalStorage is made once per sample rate and
+ * shared by every job the worker runs, and the stats add up what the worker rendered.
+ * Single file runs pass no context.
+ */
+struct WorkerContext
+{
+    std::map<unsigned int, std::unique_ptr<ConcreteConfig::GlobalStorage>> globalStorage;
+
+    ConcreteConfig::GlobalStorage *globalStorageFor(unsigned int sampleRate)
+    {
+        auto &gs = globalStorage[sampleRate];
+        if (!gs)
+            gs = std::make_unique<ConcreteConfig::GlobalStorage>(sampleRate);
+        return gs.get();
+    }
+
+    uint64_t framesRendered{0};
+    double secondsRendered{0};
+};
+
 int writeOutfile(std::string filename, int sampleRate, uint32_t sample_count, float *samples)
 {
     drwav wav;
@@ -230,31 +270,195 @@ void launchGnuplot(std::string filename)
     system(cmd.c_str());
 }
 
-template <typename FXT> int voiceEffectExampleHarness(const CLIArgBundle &arg)
+int openStreamingInput(const CLIArgBundle &arg, drwav &in)
 {
-    unsigned int channels;
-    unsigned int sampleRate;
-    drwav_uint64 totalPCMFrameCount;
-    float *pSampleData = drwav_open_file_and_read_pcm_frames_f32(
-        arg.infileName.c_str(), &channels, &sampleRate, &totalPCMFrameCount, NULL);
-
-    // TODO - how does this report errors?
-    if (totalPCMFrameCount <= 0 || pSampleData == nullptr)
+    if (!drwav_init_file(&in, arg.infileName.c_str(), nullptr))
     {
-        std::cout << "No samples in file. Exiting" << std::endl;
+        std::cout << "Cannot open '" << arg.infileName << "'. Exiting" << std::endl;
         return 2;
     }
-    printf("sampleRate: %d channels: %d, totalPCMFrameCount: %llu\n", sampleRate, channels,
-           totalPCMFrameCount);
+    if (!arg.quiet)
+        printf("sampleRate: %d channels: %d, totalPCMFrameCount: %llu\n", in.sampleRate,
+               in.channels, (unsigned long long)in.totalPCMFrameCount);
+    if (in.channels > 2)
+    {
+        printf("%s: only 1 or 2 channels wav files supported, exiting.\n",
+               arg.infileName.c_str());
+        drwav_uninit(&in);
+        return 3;
+    }
+    return 0;
+}
 
-    if (channels > 2)
+/*
+ * Streaming mode reads, processes and writes the file chunkFrames at a time, so memory
+ * use doesn't grow with the length of the recording. The final partial block is padded
+ * with silence, and after the input runs out we keep feeding silence until the effect
+ * has rung out (as a RingoutTracker judges it). An effect which reports no tail at all
+ * gets none, and maxTailSeconds caps the tail of effects which report it as unbounded.
+ *
+ * processBlock(inL, inR, outL, outR) runs one blockSize block.
+ */
+template <size_t blockSize, typename FX, typename ProcessBlock>
+int streamThroughEffect(const CLIArgBundle &arg, WorkerContext *worker, drwav &in, FX *fx,
+                        ProcessBlock &&processBlock)
+{
+    drwav out;
+    drwav_data_format format;
+    format.container = drwav_container_riff;
+    format.format = DR_WAVE_FORMAT_IEEE_FLOAT;
+    format.channels = 2;
+    format.sampleRate = in.sampleRate;
+    format.bitsPerSample = 32;
+    if (!drwav_init_file_write(&out, arg.outfileName.c_str(), &format, nullptr))
     {
-        printf("Only 1 or 2 channels wav files supported, exiting.\n");
+        std::cout << "Cannot init file write the outfile '" << arg.outfileName << "'"
+                  << std::endl;
         return 3;
     }
 
+    FILE *datFile{nullptr};
+    if (!arg.datfileName.empty())
+    {
+        datFile = fopen(arg.datfileName.c_str(), "w");
+        if (!datFile)
+        {
+            std::cout << "Datfile not open at '" << arg.datfileName << "'" << std::endl;
+            drwav_uninit(&out);
+            return 4;
+        }
+    }
+
+    // chunks are whole blocks so only the last one is ever partial
+    auto chunkBlocks = std::max<size_t>(1, arg.chunkFrames / blockSize);
+    auto chunkFrames = chunkBlocks * blockSize;
+    std::vector<float> inBuffer(chunkFrames * in.channels), outBuffer(chunkFrames * 2);
+
+    uint64_t framesWritten{0};
+    auto emit = [&](size_t frames) {
+        drwav_write_pcm_frames(&out, frames, outBuffer.data());
+        if (datFile)
+        {
+            for (size_t s = 0; s < frames; s++)
+                fprintf(datFile, "%llu %f %f\n", (unsigned long long)(framesWritten + s),
+                        outBuffer[s * 2], outBuffer[s * 2 + 1]);
+        }
+        framesWritten += frames;
+    };
+
+    float inL alignas(16)[blockSize], inR alignas(16)[blockSize];
+    float outL alignas(16)[blockSize], outR alignas(16)[blockSize];
+
+    while (true)
+    {
+        auto framesRead = drwav_read_pcm_frames_f32(&in, chunkFrames, inBuffer.data());
+        if (framesRead == 0)
+            break;
+
+        auto blocks = (framesRead + blockSize - 1) / blockSize;
+        for (size_t block = 0; block < blocks; block++)
+        {
+            for (size_t s = 0; s < blockSize; s++)
+            {
+                auto f = block * blockSize + s;
+                if (f >= framesRead)
+                {
+                    inL[s] = 0.f;
+                    inR[s] = 0.f;
+                }
+                else if (in.channels == 2)
+                {
+                    inL[s] = inBuffer[f * 2];
+                    inR[s] = inBuffer[f * 2 + 1];
+                }
+                else
+                {
+                    inL[s] = inBuffer[f];
+                    inR[s] = inL[s];
+                }
+            }
+
+            processBlock(inL, inR, outL, outR);
+
+            for (size_t s = 0; s < blockSize; s++)
+            {
+                outBuffer[(block * blockSize + s) * 2] = outL[s];
+                outBuffer[(block * blockSize + s) * 2 + 1] = outR[s];
+            }
+        }
+        emit(blocks * blockSize);
+    }
+    auto inputFrames = framesWritten;
+
+    using tracker_t = sst::effects_shared::RingoutTracker<blockSize>;
+    tracker_t tracker;
+
+    // an effect which reports nothing about its tail has none, and one with a bounded tail
+    // stops when the tracker sleeps, so the cap is only for a reported unbounded tail
+    constexpr bool reportsTail = requires(FX *f) { f->getRingoutDecay(); } ||
+                                 requires(FX *f) { f->tailLength(); } ||
+                                 requires(FX *f) { f->silentSamplesLength(); };
+    uint64_t maxTailFrames{0};
+    if constexpr (reportsTail)
+    {
+        maxTailFrames = std::numeric_limits<uint64_t>::max();
+        if (tracker_t::tailSamples(fx) == tracker_t::unbounded)
+            maxTailFrames = (uint64_t)std::max(0.f, arg.maxTailSeconds * in.sampleRate);
+    }
+    std::fill(inL, inL + blockSize, 0.f);
+    std::fill(inR, inR + blockSize, 0.f);
+
+    uint64_t tailFrames{0};
+    bool ringing{true};
+    while (ringing && tailFrames < maxTailFrames)
+    {
+        size_t block{0};
+        while (block < chunkBlocks && tailFrames < maxTailFrames)
+        {
+            if (!tracker.shouldProcess(fx, inL, inR))
+            {
+                ringing = false;
+                break;
+            }
+            processBlock(inL, inR, outL, outR);
+            tracker.trackOutput(outL, outR);
+
+            for (size_t s = 0; s < blockSize; s++)
+            {
+                outBuffer[(block * blockSize + s) * 2] = outL[s];
+                outBuffer[(block * blockSize + s) * 2 + 1] = outR[s];
+            }
+            block++;
+            tailFrames += blockSize;
+        }
+        if (block > 0)
+            emit(block * blockSize);
+    }
+
+    if (!arg.quiet)
+        std::cout << "Streamed " << inputFrames << " frames and a " << tailFrames
+                  << " frame tail r=" << in.sampleRate << " to " << arg.outfileName << std::endl;
+
+    if (worker)
+    {
+        worker->framesRendered += framesWritten;
+        worker->secondsRendered += (double)framesWritten / in.sampleRate;
+    }
+
+    drwav_uninit(&out);
+    if (datFile)
+        fclose(datFile);
+
+    if (arg.launchGnuplot)
+        launchGnuplot(arg.datfileName);
+
+    return 0;
+}
+
+template <typename FXT> std::unique_ptr<FXT> makeVoiceEffect(const CLIArgBundle &arg, float sr)
+{
     auto fx = std::make_unique<FXT>();
-    fx->sampleRate = sampleRate;
+    fx->sampleRate = sr;
     fx->initVoiceEffectParams();
 
     int ai{0};
@@ -269,6 +473,48 @@ template <typename FXT> int voiceEffectExampleHarness(const CLIArgBundle &arg)
         fx->setIntParam(ai, i);
         ai++;
     }
+    return fx;
+}
+
+template <typename FXT>
+int voiceEffectExampleHarness(const CLIArgBundle &arg, WorkerContext *worker = nullptr)
+{
+    if (arg.stream)
+    {
+        drwav in;
+        if (auto err = openStreamingInput(arg, in))
+            return err;
+        auto fx = makeVoiceEffect<FXT>(arg, in.sampleRate);
+        auto err = streamThroughEffect<SSTFX::FxConfig::blockSize>(
+            arg, worker, in, fx.get(), [&fx](float *inL, float *inR, float *outL, float *outR) {
+                fx->processStereo(inL, inR, outL, outR, 1);
+            });
+        drwav_uninit(&in);
+        return err;
+    }
+
+    unsigned int channels;
+    unsigned int sampleRate;
+    drwav_uint64 totalPCMFrameCount;
+    float *pSampleData = drwav_open_file_and_read_pcm_frames_f32(
+        arg.infileName.c_str(), &channels, &sampleRate, &totalPCMFrameCount, NULL);
+
+    // TODO - how does this report errors?
+    if (totalPCMFrameCount <= 0 || pSampleData == nullptr)
+    {
+        std::cout << "No samples in file. Exiting" << std::endl;
+        return 2;
+    }
+    printf("sampleRate: %d channels: %d, totalPCMFrameCount: %llu\n", sampleRate, channels,
+           totalPCMFrameCount);
+
+    if (channels > 2)
+    {
+        printf("Only 1 or 2 channels wav files supported, exiting.\n");
+        return 3;
+    }
+
+    auto fx = makeVoiceEffect<FXT>(arg, sampleRate);
 
     static constexpr auto blockSize = SSTFX::FxConfig::blockSize;
 
@@ -330,8 +576,48 @@ template <typename FXT> int voiceEffectExampleHarness(const CLIArgBundle &arg)
     return 0;
 }
 
-template <typename FXT> int effectExampleHarness(const CLIArgBundle &arg)
+template <typename FXT>
+std::unique_ptr<FXT> makeEffect(const CLIArgBundle &arg, ConcreteConfig::GlobalStorage *gs,
+                                ConcreteConfig::EffectStorage *es)
 {
+    auto fx = std::make_unique<FXT>(gs, es, nullptr);
+    for (int i = 0; i < FXT::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+
+    int ai{0};
+    for (const auto &f : arg.fArgs)
+    {
+        fx->paramStorage[ai] = f;
+        ai++;
+    }
+    fx->initialize();
+    return fx;
+}
+
+template <typename FXT>
+int effectExampleHarness(const CLIArgBundle &arg, WorkerContext *worker = nullptr)
+{
+    if (arg.stream)
+    {
+        drwav in;
+        if (auto err = openStreamingInput(arg, in))
+            return err;
+        std::unique_ptr<ConcreteConfig::GlobalStorage> ownGS;
+        auto gs = worker ? worker->globalStorageFor(in.sampleRate)
+                         : (ownGS = std::make_unique<ConcreteConfig::GlobalStorage>(in.sampleRate))
+                               .get();
+        auto es = ConcreteConfig::EffectStorage();
+        auto fx = makeEffect<FXT>(arg, gs, &es);
+        auto err = streamThroughEffect<ConcreteConfig::blockSize>(
+            arg, worker, in, fx.get(), [&fx](float *inL, float *inR, float *outL, float *outR) {
+                memcpy(outL, inL, ConcreteConfig::blockSize * sizeof(float));
+                memcpy(outR, inR, ConcreteConfig::blockSize * sizeof(float));
+                fx->processBlock(outL, outR);
+            });
+        drwav_uninit(&in);
+        return err;
+    }
+
     unsigned int channels;
     unsigned int sampleRate;
     drwav_uint64 totalPCMFrameCount;
@@ -356,17 +642,7 @@ template <typename FXT> int effectExampleHarness(const CLIArgBundle &arg)
     auto gs = ConcreteConfig::GlobalStorage(sampleRate);
     auto es = ConcreteConfig::EffectStorage();
 
-    auto fx = std::make_unique<FXT>(&gs, &es, nullptr);
-    for (int i = 0; i < FXT::numParams; ++i)
-        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
-
-    int ai{0};
-    for (const auto &f : arg.fArgs)
-    {
-        fx->paramStorage[ai] = f;
-        ai++;
-    }
-    fx->initialize();
+    auto fx = makeEffect<FXT>(arg, &gs, &es);
 
     static constexpr auto blockSize = ConcreteConfig::blockSize;
 
@@ -425,6 +701,180 @@ template <typename FXT> int effectExampleHarness(const CLIArgBundle &arg)
     return 0;
 }
 
+using Runner = std::function<int(const CLIArgBundle &, WorkerContext *)>;
+
+struct BatchJob
+{
+    std::string fxType;
+    CLIArgBundle arg;
+};
+
+/*
+ * A manifest has one job per line,
+ *
+ *     infile fxtype outfile [float args...] [: int args...]
+ *
+ * with blank lines and lines starting with # skipped.
+ */
+bool readManifest(const std::string &filename, const CLIArgBundle &defaults,
+                  std::vector<BatchJob> &jobs)
+{
+    std::ifstream manifest(filename);
+    if (!manifest)
+    {
+        std::cout << "Cannot open manifest '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNo{0};
+    while (std::getline(manifest, line))
+    {
+        lineNo++;
+        std::istringstream tokens(line);
+        BatchJob job;
+        job.arg = defaults;
+        if (!(tokens >> job.arg.infileName) || job.arg.infileName[0] == '#')
+            continue;
+        if (!(tokens >> job.fxType >> job.arg.outfileName))
+        {
+            std::cout << filename << ":" << lineNo << ": expected 'infile fxtype outfile'"
+                      << std::endl;
+            return false;
+        }
+
+        bool ints{false};
+        std::string t;
+        while (tokens >> t)
+        {
+            if (t == ":")
+                ints = true;
+            else if (ints)
+                job.arg.iArgs.push_back(std::stoi(t));
+            else
+                job.arg.fArgs.push_back(std::stof(t));
+        }
+        jobs.push_back(std::move(job));
+    }
+    return true;
+}
+
+/*
+ * Work stealing for a fixed set of jobs. The jobs are dealt round robin onto a deque
+ * per worker; a worker pops from the back of its own deque and when that is empty
+ * steals from the front of the others. Since nothing is added once we start, a worker
+ * which finds every deque empty is done.
+ */
+struct WorkStealingQueues
+{
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    WorkStealingQueues(size_t nWorkers, size_t nJobs)
+    {
+        for (size_t i = 0; i < nWorkers; ++i)
+            queues.push_back(std::make_unique<Queue>());
+        for (size_t j = 0; j < nJobs; ++j)
+            queues[j % nWorkers]->jobs.push_back(j);
+    }
+
+    bool next(size_t worker, size_t &job)
+    {
+        {
+            auto &q = *queues[worker];
+            std::lock_guard<std::mutex> g(q.mutex);
+            if (!q.jobs.empty())
+            {
+                job = q.jobs.back();
+                q.jobs.pop_back();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queues.size(); ++i)
+        {
+            auto &q = *queues[(worker + i) % queues.size()];
+            std::lock_guard<std::mutex> g(q.mutex);
+            if (!q.jobs.empty())
+            {
+                job = q.jobs.front();
+                q.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+int runBatch(const std::string &manifest, const CLIArgBundle &defaults, size_t nWorkers,
+             const std::map<std::string, Runner> &runners)
+{
+    std::vector<BatchJob> jobs;
+    if (!readManifest(manifest, defaults, jobs))
+        return 2;
+    for (auto &job : jobs)
+    {
+        if (runners.find(job.fxType) == runners.end())
+        {
+            std::cout << "Unknown fx '" << job.fxType << "' for " << job.arg.infileName
+                      << std::endl;
+            return 1;
+        }
+        // batch jobs always stream; a library of files would not fit in memory at once
+        job.arg.stream = true;
+        job.arg.quiet = true;
+        job.arg.datfileName.clear();
+        job.arg.launchGnuplot = false;
+    }
+
+    nWorkers = std::max<size_t>(1, std::min(nWorkers, jobs.size()));
+    std::cout << "Running " << jobs.size() << " jobs on " << nWorkers << " workers" << std::endl;
+
+    WorkStealingQueues queues(nWorkers, jobs.size());
+    std::vector<WorkerContext> workers(nWorkers);
+    std::atomic<size_t> failed{0};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < nWorkers; ++w)
+    {
+        threads.emplace_back([&, w]() {
+            size_t j;
+            while (queues.next(w, j))
+            {
+                auto &job = jobs[j];
+                if (runners.at(job.fxType)(job.arg, &workers[w]) != 0)
+                {
+                    failed++;
+                    std::cout << "Job " << j << " (" << job.arg.infileName << ") failed"
+                              << std::endl;
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t frames{0};
+    double audioSeconds{0};
+    for (const auto &w : workers)
+    {
+        frames += w.framesRendered;
+        audioSeconds += w.secondsRendered;
+    }
+
+    std::cout << fmt::format("{} of {} jobs ok in {:.2f}s: {:.1f} files/s, {:.3g} frames/s, "
+                             "{:.1f}x realtime",
+                             jobs.size() - failed, jobs.size(), wall, jobs.size() / wall,
+                             frames / wall, audioSeconds / wall)
+              << std::endl;
+    return failed ? 5 : 0;
+}
+
 int main(int argc, char const *argv[])
 {
     /*
@@ -433,12 +883,23 @@ int main(int argc, char const *argv[])
     CLI::App app("..:: Voice Effects Example - Command Line player for SST Voice Effects ::..");
     CLIArgBundle arg;
 
-    app.add_option("-i,--infile", arg.infileName, "Input wav file for session")->required();
-    app.add_option("-o,--outfile", arg.outfileName, "Output wav file for session")->required();
+    app.add_option("-i,--infile", arg.infileName, "Input wav file for session");
+    app.add_option("-o,--outfile", arg.outfileName, "Output wav file for session");
     app.add_option("-d,--datfile", arg.datfileName, "Optional plain text dat file");
     app.add_flag("--gnuplot", arg.launchGnuplot, "Attempt to launch gnuplot on datfile");
     app.add_option("--fargs", arg.fArgs, "Floating arguments in order");
     app.add_option("--iargs", arg.iArgs, "Integer arguments in order");
+    app.add_flag("--stream", arg.stream,
+                 "Stream the file through in chunks and render the effect tail");
+    app.add_option("--chunk", arg.chunkFrames, "Frames per chunk when streaming");
+    app.add_option("--max-tail", arg.maxTailSeconds,
+                   "Longest unbounded tail to render when streaming, in seconds");
+
+    std::string batchManifest;
+    size_t batchJobs{std::max(1U, std::thread::hardware_concurrency())};
+    app.add_option("--batch", batchManifest,
+                   "Run every 'infile fxtype outfile [fargs] [: iargs]' line of a manifest");
+    app.add_option("-j,--jobs", batchJobs, "Worker threads for --batch");
 
     std::string fxType;
     app.add_option("-t,--type", fxType, "FX Type to run");
@@ -447,10 +908,16 @@ int main(int argc, char const *argv[])
     // - Add a vec option (https://cliutils.github.io/CLI11/book/chapters/options.html)
     //   for float and int params
     // - RTAudio rather than file output
-    // - Add a ringout option
 
     CLI11_PARSE(app, argc, argv);
 
+    if (batchManifest.empty() && (arg.infileName.empty() || arg.outfileName.empty()))
+    {
+        std::cout << "Specify an infile and outfile with -i and -o, or a manifest with --batch"
+                  << std::endl;
+        return 2;
+    }
+
     if (arg.launchGnuplot && arg.datfileName.empty())
     {
         std::cout << "To launch gnuplot you need to specify a datfile with -d" << std::endl;
@@ -458,17 +925,16 @@ int main(int argc, char const *argv[])
     }
 
     std::vector<std::string> types;
+    std::map<std::string, Runner> runners;
 #define ADD_VFX_TYPE(key, cls)                                                                     \
     {                                                                                              \
         types.push_back(std::string(key) + " -> " + #cls);                                         \
-        if (fxType == std::string(key))                                                            \
-            return voiceEffectExampleHarness<sst::voice_effects::cls<SSTFX::FxConfig>>(arg);       \
+        runners[key] = voiceEffectExampleHarness<sst::voice_effects::cls<SSTFX::FxConfig>>;        \
     }
 #define ADD_FX_TYPE(key, cls)                                                                      \
     {                                                                                              \
         types.push_back(std::string(key) + " -> " + #cls);                                         \
-        if (fxType == std::string(key))                                                            \
-            return effectExampleHarness<sst::effects::cls<ConcreteConfig>>(arg);                   \
+        runners[key] = effectExampleHarness<sst::effects::cls<ConcreteConfig>>;                    \
     }
     ADD_VFX_TYPE("volpan", utilities::VolumeAndPan);
     ADD_VFX_TYPE("bitcrush", distortion::BitCrusher);
@@ -477,6 +943,13 @@ int main(int argc, char const *argv[])
     ADD_FX_TYPE("floaty", floatydelay::FloatyDelay);
     ADD_FX_TYPE("bonsai", bonsai::Bonsai);
 
+    if (!batchManifest.empty())
+        return runBatch(batchManifest, arg, batchJobs, runners);
+
+    auto runner = runners.find(fxType);
+    if (runner != runners.end())
+        return runner->second(arg, nullptr);
+
     // If we get kere no keys matched
     std::cout << "Unable to find fx '" << fxType << "'. Available options are :\n";
     for (const auto &opt : types)
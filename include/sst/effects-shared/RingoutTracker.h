@@ -0,0 +1,170 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_EFFECTS_SHARED_RINGOUTTRACKER_H
+#define INCLUDE_SST_EFFECTS_SHARED_RINGOUTTRACKER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace sst::effects_shared
+{
+/*
+ * RingoutTracker is a small state machine a host can put in front of an effect to
+ * decide whether a block needs to be processed at all. Once the input has been
+ * silent for longer than the effect's ring-out the tracker reports sleeping and the
+ * host can skip the DSP (leaving the output silent). The first non-silent input
+ * block wakes it again, before that block is processed.
+ *
+ * The ring-out comes from the effect itself
+ *
+ * - bus effects report `getRingoutDecay()` in blocks, with a negative value meaning
+ *   the tail is unbounded (delays with feedback, say)
+ * - voice effects report `tailLength()` in samples, with size_t(-1) meaning unbounded
+ *
+ * and for an unbounded tail we fall back to output silence: if the effect provides
+ * `silentSamplesLength()` we sleep once input and output have both been silent for
+ * that many samples. Effects with an unbounded tail and no silentSamplesLength (like
+ * generators which make sound with no input) never sleep.
+ *
+ * Usage, for a bus effect processing in place
+ *
+ *    if (tracker.shouldProcess(fx, L, R))
+ *    {
+ *        fx->processBlock(L, R);
+ *        tracker.trackOutput(L, R);
+ *    }
+ *
+ * and for a voice effect, clear the output when shouldProcess returns false.
+ */
+template <size_t blockSize> struct RingoutTracker
+{
+    static_assert(blockSize >= 4 && (blockSize & 3) == 0);
+
+    static constexpr size_t unbounded{std::numeric_limits<size_t>::max()};
+
+    // roughly -100dB. Anything under this on both channels is silence.
+    float silenceThreshold{1e-5f};
+
+    bool isSleeping() const { return sleeping; }
+
+    void wake()
+    {
+        sleeping = false;
+        silentInputSamples = 0;
+        silentOutputSamples = 0;
+    }
+
+    void reset() { wake(); }
+
+    template <typename FX> bool shouldProcess(FX *fx, const float *inL, const float *inR)
+    {
+        if (!isSilent(inL, inR, silenceThreshold))
+        {
+            if (sleeping)
+                wake();
+            silentInputSamples = 0;
+            return true;
+        }
+
+        if (sleeping)
+            return false;
+
+        silentInputSamples += blockSize;
+
+        auto tail = tailSamples(fx);
+        if (tail != unbounded)
+        {
+            sleeping = silentInputSamples > tail;
+        }
+        else
+        {
+            auto window = outputSilenceWindow(fx);
+            if (window != unbounded)
+            {
+                window = std::max(window, blockSize);
+                sleeping = silentInputSamples >= window && silentOutputSamples >= window;
+            }
+        }
+        return !sleeping;
+    }
+
+    // Only needed for effects with an unbounded tail, but harmless to call always
+    void trackOutput(const float *outL, const float *outR)
+    {
+        if (isSilent(outL, outR, silenceThreshold))
+            silentOutputSamples += blockSize;
+        else
+            silentOutputSamples = 0;
+    }
+
+    template <typename FX> static size_t tailSamples(FX *fx)
+    {
+        if constexpr (requires { fx->getRingoutDecay(); })
+        {
+            auto d = fx->getRingoutDecay();
+            if (d < 0)
+                return unbounded;
+            return (size_t)d * blockSize;
+        }
+        else if constexpr (requires { fx->tailLength(); })
+        {
+            return (size_t)fx->tailLength();
+        }
+        else
+        {
+            return unbounded;
+        }
+    }
+
+    template <typename FX> static size_t outputSilenceWindow(FX *fx)
+    {
+        if constexpr (requires { fx->silentSamplesLength(); })
+            return (size_t)fx->silentSamplesLength();
+        else
+            return unbounded;
+    }
+
+    /*
+     * SIMD peak check over a stereo block. The buffers need not be aligned, since
+     * voice effect callers don't guarantee it.
+     */
+    static bool isSilent(const float *L, const float *R, float threshold)
+    {
+        const auto absMask = SIMD_MM(castsi128_ps)(SIMD_MM(set1_epi32)(0x7FFFFFFF));
+        auto peak = SIMD_MM(setzero_ps)();
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            peak = SIMD_MM(max_ps)(peak, SIMD_MM(and_ps)(absMask, SIMD_MM(loadu_ps)(L + i)));
+            peak = SIMD_MM(max_ps)(peak, SIMD_MM(and_ps)(absMask, SIMD_MM(loadu_ps)(R + i)));
+        }
+        auto loud = SIMD_MM(cmpgt_ps)(peak, SIMD_MM(set1_ps)(threshold));
+        return SIMD_MM(movemask_ps)(loud) == 0;
+    }
+
+  protected:
+    bool sleeping{false};
+    size_t silentInputSamples{0}, silentOutputSamples{0};
+};
+} // namespace sst::effects_shared
+
+#endif // INCLUDE_SST_EFFECTS_SHARED_RINGOUTTRACKER_H
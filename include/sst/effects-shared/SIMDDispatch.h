@@ -0,0 +1,166 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_EFFECTS_SHARED_SIMDDISPATCH_H
+#define INCLUDE_SST_EFFECTS_SHARED_SIMDDISPATCH_H
+
+/*
+ * Runtime CPU dispatch for the hottest kernels. The effects are written against
+ * SSE2 through SIMD_MM, which is also what they compile to on other architectures
+ * through simde. A few kernels additionally come in AVX2 and AVX-512 variants which
+ * are compiled with per function target attributes, so one binary built for the SSE2
+ * baseline runs the wider code on the machines which have it.
+ *
+ * A kernel is a struct with a function pointer type `fn_t` and static functions
+ * `sse2` and (inside SST_EFFECTS_SIMD_DISPATCH_X86) optionally `avx2` and `avx512`.
+ * `DispatchedKernel<K>::get()` returns the best one for this CPU, chosen once.
+ *
+ * Define SST_EFFECTS_DISABLE_SIMD_DISPATCH to always use the sse2 variants, or
+ * SST_EFFECTS_MAX_SIMD_LEVEL to a SIMDLevel value (0, 1, 2) to cap the detected level.
+ */
+
+#include <algorithm>
+#include <cstdint>
+
+#if !defined(SST_EFFECTS_DISABLE_SIMD_DISPATCH) &&                                                 \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SST_EFFECTS_SIMD_DISPATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SST_EFFECTS_TARGET_AVX2
+#define SST_EFFECTS_TARGET_AVX512
+#elif defined(__clang__)
+#define SST_EFFECTS_TARGET_AVX2 __attribute__((target("avx2")))
+#define SST_EFFECTS_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+// avx512f brings fma with it, and gcc would otherwise fuse the mul/add pairs
+#define SST_EFFECTS_TARGET_AVX2 __attribute__((target("avx2")))
+#define SST_EFFECTS_TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#endif
+#endif
+
+namespace sst::effects_shared
+{
+enum struct SIMDLevel : int32_t
+{
+    SSE2 = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+inline const char *simdLevelName(SIMDLevel l)
+{
+    switch (l)
+    {
+    case SIMDLevel::SSE2:
+        return "sse2";
+    case SIMDLevel::AVX2:
+        return "avx2";
+    case SIMDLevel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+inline SIMDLevel detectSIMDLevel()
+{
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return SIMDLevel::SSE2;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave)
+        return SIMDLevel::SSE2;
+    auto xcr0 = _xgetbv(0);
+    bool ymm = (xcr0 & 0x6) == 0x6;
+    bool zmm = (xcr0 & 0xE6) == 0xE6;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    bool avx512f = (info[1] & (1 << 16)) != 0;
+    if (avx512f && avx2 && zmm)
+        return SIMDLevel::AVX512;
+    if (avx2 && ymm)
+        return SIMDLevel::AVX2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2"))
+        return SIMDLevel::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SIMDLevel::AVX2;
+#endif
+#endif
+    return SIMDLevel::SSE2;
+}
+
+// Detected once; every kernel uses the same level
+inline SIMDLevel simdLevel()
+{
+#if defined(SST_EFFECTS_MAX_SIMD_LEVEL)
+    static const SIMDLevel level =
+        std::min(detectSIMDLevel(), (SIMDLevel)(int32_t)(SST_EFFECTS_MAX_SIMD_LEVEL));
+#else
+    static const SIMDLevel level = detectSIMDLevel();
+#endif
+    return level;
+}
+
+namespace details
+{
+template <typename K>
+concept HasAVX2 = requires { K::avx2; };
+template <typename K>
+concept HasAVX512 = requires { K::avx512; };
+} // namespace details
+
+template <typename Kernel> struct DispatchedKernel
+{
+    using fn_t = typename Kernel::fn_t;
+
+    // The variant for a given level, falling back to the next narrower one
+    static fn_t forLevel(SIMDLevel l)
+    {
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+        if constexpr (details::HasAVX512<Kernel>)
+        {
+            if (l >= SIMDLevel::AVX512)
+                return &Kernel::avx512;
+        }
+        if constexpr (details::HasAVX2<Kernel>)
+        {
+            if (l >= SIMDLevel::AVX2)
+                return &Kernel::avx2;
+        }
+#endif
+        return &Kernel::sse2;
+    }
+
+    static fn_t get()
+    {
+        static const fn_t fn = forLevel(simdLevel());
+        return fn;
+    }
+};
+} // namespace sst::effects_shared
+
+#endif // INCLUDE_SST_EFFECTS_SHARED_SIMDDISPATCH_H
@@ -0,0 +1,433 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_EFFECTS_SHARED_SIMDKERNELS_H
+#define INCLUDE_SST_EFFECTS_SHARED_SIMDKERNELS_H
+
+#include <cstddef>
+#include <utility>
+
+#include "sst/effects-shared/SIMDDispatch.h"
+#include "sst/basic-blocks/mechanics/simd-ops.h"
+
+/*
+ * Block kernels shared across effects, with runtime dispatched wider variants. The
+ * wider variants keep the association order of the sse2 code so results are the same
+ * at every level. Buffers need not be aligned.
+ */
+namespace sst::effects_shared::kernels
+{
+// M = (L + R) / 2, S = (L - R) / 2
+template <size_t blockSize> struct MSEncode
+{
+    static_assert(blockSize % 4 == 0);
+    using fn_t = void (*)(const float *, const float *, float *, float *);
+
+    static void sse2(const float *L, const float *R, float *M, float *S)
+    {
+        const auto half = SIMD_MM(set1_ps)(0.5f);
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            auto l = SIMD_MM(loadu_ps)(L + i);
+            auto r = SIMD_MM(loadu_ps)(R + i);
+            SIMD_MM(storeu_ps)(M + i, SIMD_MM(mul_ps)(SIMD_MM(add_ps)(l, r), half));
+            SIMD_MM(storeu_ps)(S + i, SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(l, r), half));
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void avx2(const float *L, const float *R, float *M, float *S)
+    {
+        if constexpr (blockSize % 8 != 0)
+        {
+            sse2(L, R, M, S);
+        }
+        else
+        {
+            const auto half = _mm256_set1_ps(0.5f);
+            for (size_t i = 0; i < blockSize; i += 8)
+            {
+                auto l = _mm256_loadu_ps(L + i);
+                auto r = _mm256_loadu_ps(R + i);
+                _mm256_storeu_ps(M + i, _mm256_mul_ps(_mm256_add_ps(l, r), half));
+                _mm256_storeu_ps(S + i, _mm256_mul_ps(_mm256_sub_ps(l, r), half));
+            }
+        }
+    }
+#endif
+};
+
+// L = M + S, R = M - S
+template <size_t blockSize> struct MSDecode
+{
+    static_assert(blockSize % 4 == 0);
+    using fn_t = void (*)(const float *, const float *, float *, float *);
+
+    static void sse2(const float *M, const float *S, float *L, float *R)
+    {
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            auto m = SIMD_MM(loadu_ps)(M + i);
+            auto s = SIMD_MM(loadu_ps)(S + i);
+            SIMD_MM(storeu_ps)(L + i, SIMD_MM(add_ps)(m, s));
+            SIMD_MM(storeu_ps)(R + i, SIMD_MM(sub_ps)(m, s));
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void avx2(const float *M, const float *S, float *L, float *R)
+    {
+        if constexpr (blockSize % 8 != 0)
+        {
+            sse2(M, S, L, R);
+        }
+        else
+        {
+            for (size_t i = 0; i < blockSize; i += 8)
+            {
+                auto m = _mm256_loadu_ps(M + i);
+                auto s = _mm256_loadu_ps(S + i);
+                _mm256_storeu_ps(L + i, _mm256_add_ps(m, s));
+                _mm256_storeu_ps(R + i, _mm256_sub_ps(m, s));
+            }
+        }
+    }
+#endif
+};
+
+/*
+ * Crossfades a stereo pair in place with a per sample gain, a = a * (1 - g) + b * g,
+ * the same form as lipol_sse::fade_2_blocks_inplace. Pair it with
+ * lipol_sse::store_block to mix with a smoothed target.
+ */
+template <size_t blockSize> struct Fade2BlocksInplace
+{
+    static_assert(blockSize % 4 == 0);
+    using fn_t = void (*)(float *, const float *, float *, const float *, const float *);
+
+    static void sse2(float *aL, const float *bL, float *aR, const float *bR, const float *g)
+    {
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            auto g4 = SIMD_MM(loadu_ps)(g + i);
+            auto ig4 = SIMD_MM(sub_ps)(SIMD_MM(set1_ps)(1.f), g4);
+            auto l = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(aL + i), ig4);
+            auto r = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(aR + i), ig4);
+            l = SIMD_MM(add_ps)(l, SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(bL + i), g4));
+            r = SIMD_MM(add_ps)(r, SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(bR + i), g4));
+            SIMD_MM(storeu_ps)(aL + i, l);
+            SIMD_MM(storeu_ps)(aR + i, r);
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void avx2(float *aL, const float *bL, float *aR,
+                                             const float *bR, const float *g)
+    {
+        if constexpr (blockSize % 8 != 0)
+        {
+            sse2(aL, bL, aR, bR, g);
+        }
+        else
+        {
+            for (size_t i = 0; i < blockSize; i += 8)
+            {
+                auto g8 = _mm256_loadu_ps(g + i);
+                auto ig8 = _mm256_sub_ps(_mm256_set1_ps(1.f), g8);
+                auto l = _mm256_mul_ps(_mm256_loadu_ps(aL + i), ig8);
+                auto r = _mm256_mul_ps(_mm256_loadu_ps(aR + i), ig8);
+                l = _mm256_add_ps(l, _mm256_mul_ps(_mm256_loadu_ps(bL + i), g8));
+                r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(bR + i), g8));
+                _mm256_storeu_ps(aL + i, l);
+                _mm256_storeu_ps(aR + i, r);
+            }
+        }
+    }
+#endif
+};
+
+/*
+ * Stereo width in place in one pass: encode to mid/side, scale the side by wS (and the
+ * mid by wM if scaleMid), and decode. The same arithmetic as MSEncode, a multiply_block
+ * on each and MSDecode, so results match those bit for bit, without the M and S blocks.
+ * wM is not read unless scaleMid.
+ */
+template <size_t blockSize, bool scaleMid> struct MSWidth
+{
+    static_assert(blockSize % 4 == 0);
+    using fn_t = void (*)(float *, float *, const float *, const float *);
+
+    static void width4(SIMD_M128 &l, SIMD_M128 &r, const float *wS, const float *wM)
+    {
+        const auto half = SIMD_MM(set1_ps)(0.5f);
+        auto m = SIMD_MM(mul_ps)(SIMD_MM(add_ps)(l, r), half);
+        auto s = SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(l, r), half);
+        s = SIMD_MM(mul_ps)(s, SIMD_MM(loadu_ps)(wS));
+        if constexpr (scaleMid)
+            m = SIMD_MM(mul_ps)(m, SIMD_MM(loadu_ps)(wM));
+        l = SIMD_MM(add_ps)(m, s);
+        r = SIMD_MM(sub_ps)(m, s);
+    }
+
+    static void sse2(float *L, float *R, const float *wS, const float *wM)
+    {
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            auto l = SIMD_MM(loadu_ps)(L + i);
+            auto r = SIMD_MM(loadu_ps)(R + i);
+            width4(l, r, wS + i, wM + i);
+            SIMD_MM(storeu_ps)(L + i, l);
+            SIMD_MM(storeu_ps)(R + i, r);
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void width8(__m256 &l, __m256 &r, const float *wS,
+                                               const float *wM)
+    {
+        const auto half = _mm256_set1_ps(0.5f);
+        auto m = _mm256_mul_ps(_mm256_add_ps(l, r), half);
+        auto s = _mm256_mul_ps(_mm256_sub_ps(l, r), half);
+        s = _mm256_mul_ps(s, _mm256_loadu_ps(wS));
+        if constexpr (scaleMid)
+            m = _mm256_mul_ps(m, _mm256_loadu_ps(wM));
+        l = _mm256_add_ps(m, s);
+        r = _mm256_sub_ps(m, s);
+    }
+
+    SST_EFFECTS_TARGET_AVX2 static void avx2(float *L, float *R, const float *wS, const float *wM)
+    {
+        if constexpr (blockSize % 8 != 0)
+        {
+            sse2(L, R, wS, wM);
+        }
+        else
+        {
+            for (size_t i = 0; i < blockSize; i += 8)
+            {
+                auto l = _mm256_loadu_ps(L + i);
+                auto r = _mm256_loadu_ps(R + i);
+                width8(l, r, wS + i, wM + i);
+                _mm256_storeu_ps(L + i, l);
+                _mm256_storeu_ps(R + i, r);
+            }
+        }
+    }
+#endif
+};
+
+/*
+ * The epilogue most bus effects end with, in one pass: MSWidth on the wet pair b, then
+ * the Fade2BlocksInplace of it into a with gain g, then if outputGain a multiply of the
+ * result by o. b is left as it was, and o is not read unless outputGain.
+ */
+template <size_t blockSize, bool scaleMid, bool outputGain = false>
+struct MSWidthFade2BlocksInplace
+{
+    static_assert(blockSize % 4 == 0);
+    using fn_t = void (*)(float *, const float *, float *, const float *, const float *,
+                          const float *, const float *, const float *);
+    using width_t = MSWidth<blockSize, scaleMid>;
+
+    static void sse2(float *aL, const float *bL, float *aR, const float *bR, const float *wS,
+                     const float *wM, const float *g, const float *o)
+    {
+        for (size_t i = 0; i < blockSize; i += 4)
+        {
+            auto wl = SIMD_MM(loadu_ps)(bL + i);
+            auto wr = SIMD_MM(loadu_ps)(bR + i);
+            width_t::width4(wl, wr, wS + i, wM + i);
+
+            auto g4 = SIMD_MM(loadu_ps)(g + i);
+            auto ig4 = SIMD_MM(sub_ps)(SIMD_MM(set1_ps)(1.f), g4);
+            auto l = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(aL + i), ig4);
+            auto r = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(aR + i), ig4);
+            l = SIMD_MM(add_ps)(l, SIMD_MM(mul_ps)(wl, g4));
+            r = SIMD_MM(add_ps)(r, SIMD_MM(mul_ps)(wr, g4));
+            if constexpr (outputGain)
+            {
+                auto o4 = SIMD_MM(loadu_ps)(o + i);
+                l = SIMD_MM(mul_ps)(l, o4);
+                r = SIMD_MM(mul_ps)(r, o4);
+            }
+            SIMD_MM(storeu_ps)(aL + i, l);
+            SIMD_MM(storeu_ps)(aR + i, r);
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void avx2(float *aL, const float *bL, float *aR,
+                                             const float *bR, const float *wS, const float *wM,
+                                             const float *g, const float *o)
+    {
+        if constexpr (blockSize % 8 != 0)
+        {
+            sse2(aL, bL, aR, bR, wS, wM, g, o);
+        }
+        else
+        {
+            for (size_t i = 0; i < blockSize; i += 8)
+            {
+                auto wl = _mm256_loadu_ps(bL + i);
+                auto wr = _mm256_loadu_ps(bR + i);
+                width_t::width8(wl, wr, wS + i, wM + i);
+
+                auto g8 = _mm256_loadu_ps(g + i);
+                auto ig8 = _mm256_sub_ps(_mm256_set1_ps(1.f), g8);
+                auto l = _mm256_mul_ps(_mm256_loadu_ps(aL + i), ig8);
+                auto r = _mm256_mul_ps(_mm256_loadu_ps(aR + i), ig8);
+                l = _mm256_add_ps(l, _mm256_mul_ps(wl, g8));
+                r = _mm256_add_ps(r, _mm256_mul_ps(wr, g8));
+                if constexpr (outputGain)
+                {
+                    auto o8 = _mm256_loadu_ps(o + i);
+                    l = _mm256_mul_ps(l, o8);
+                    r = _mm256_mul_ps(r, o8);
+                }
+                _mm256_storeu_ps(aL + i, l);
+                _mm256_storeu_ps(aR + i, r);
+            }
+        }
+    }
+#endif
+};
+
+/*
+ * Windowed sinc reads for a block: out[k] is the dot product of the N coefficients at
+ * table + tableOffset[k] with the N samples at buffer + bufferOffset[k]. The caller
+ * keeps the N samples contiguous (delay lines mirror their start past their end).
+ */
+template <int N> struct SincReadBlock
+{
+    static_assert(N == 12, "The sinc read kernel is written for the 12 tap Surge sinc table");
+    using fn_t = void (*)(const float *, const int *, const float *, const int *, float *, int);
+
+    static void sse2(const float *table, const int *tableOffset, const float *buffer,
+                     const int *bufferOffset, float *out, int n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            auto t = table + tableOffset[k];
+            auto b = buffer + bufferOffset[k];
+            auto m0 = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(t), SIMD_MM(loadu_ps)(b));
+            auto m1 = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(t + 4), SIMD_MM(loadu_ps)(b + 4));
+            auto m2 = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(t + 8), SIMD_MM(loadu_ps)(b + 8));
+            auto a = SIMD_MM(add_ps)(SIMD_MM(add_ps)(m0, m1), m2);
+            SIMD_MM(store_ss)(out + k, sst::basic_blocks::mechanics::sum_ps_to_ss(a));
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    SST_EFFECTS_TARGET_AVX2 static void avx2(const float *table, const int *tableOffset,
+                                             const float *buffer, const int *bufferOffset,
+                                             float *out, int n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            auto t = table + tableOffset[k];
+            auto b = buffer + bufferOffset[k];
+            auto p = _mm256_mul_ps(_mm256_loadu_ps(t), _mm256_loadu_ps(b));
+            auto a = _mm_add_ps(_mm256_castps256_ps128(p), _mm256_extractf128_ps(p, 1));
+            a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(t + 8), _mm_loadu_ps(b + 8)));
+            _mm_store_ss(out + k, sst::basic_blocks::mechanics::sum_ps_to_ss(a));
+        }
+    }
+#endif
+};
+
+/*
+ * The same reads for a stereo pair in one pass, out{L,R}[k] as SincReadBlock would give
+ * for each channel. The sse2 variant interleaves the two channels and the avx2 one puts
+ * L and R in the two halves of each 8 wide product, so both sum in the mono order.
+ */
+template <int N> struct SincReadBlock2
+{
+    static_assert(N % 4 == 0);
+    using fn_t = void (*)(const float *, const int *, const int *, const float *, const float *,
+                          const int *, const int *, float *, float *, int);
+
+    static void sse2(const float *table, const int *tableOffsetL, const int *tableOffsetR,
+                     const float *bufferL, const float *bufferR, const int *bufferOffsetL,
+                     const int *bufferOffsetR, float *outL, float *outR, int n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            auto tL = table + tableOffsetL[k], tR = table + tableOffsetR[k];
+            auto bL = bufferL + bufferOffsetL[k], bR = bufferR + bufferOffsetR[k];
+            auto aL = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(tL), SIMD_MM(loadu_ps)(bL));
+            auto aR = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(tR), SIMD_MM(loadu_ps)(bR));
+            for (int i = 4; i < N; i += 4)
+            {
+                aL = SIMD_MM(add_ps)(
+                    aL, SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(tL + i), SIMD_MM(loadu_ps)(bL + i)));
+                aR = SIMD_MM(add_ps)(
+                    aR, SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(tR + i), SIMD_MM(loadu_ps)(bR + i)));
+            }
+            SIMD_MM(store_ss)(outL + k, sst::basic_blocks::mechanics::sum_ps_to_ss(aL));
+            SIMD_MM(store_ss)(outR + k, sst::basic_blocks::mechanics::sum_ps_to_ss(aR));
+        }
+    }
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+    // four from l in the low half, four from r in the high half
+    SST_EFFECTS_TARGET_AVX2 static __m256 pair(const float *l, const float *r)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(l)), _mm_loadu_ps(r), 1);
+    }
+
+    SST_EFFECTS_TARGET_AVX2 static void avx2(const float *table, const int *tableOffsetL,
+                                             const int *tableOffsetR, const float *bufferL,
+                                             const float *bufferR, const int *bufferOffsetL,
+                                             const int *bufferOffsetR, float *outL, float *outR,
+                                             int n)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            auto tL = table + tableOffsetL[k], tR = table + tableOffsetR[k];
+            auto bL = bufferL + bufferOffsetL[k], bR = bufferR + bufferOffsetR[k];
+            auto a = _mm256_mul_ps(pair(tL, tR), pair(bL, bR));
+            for (int i = 4; i < N; i += 4)
+                a = _mm256_add_ps(a, _mm256_mul_ps(pair(tL + i, tR + i), pair(bL + i, bR + i)));
+            _mm_store_ss(outL + k,
+                         sst::basic_blocks::mechanics::sum_ps_to_ss(_mm256_castps256_ps128(a)));
+            _mm_store_ss(outR + k,
+                         sst::basic_blocks::mechanics::sum_ps_to_ss(_mm256_extractf128_ps(a, 1)));
+        }
+    }
+#endif
+};
+
+template <typename Kernel, typename... Args> inline void dispatch(Args &&...args)
+{
+    DispatchedKernel<Kernel>::get()(std::forward<Args>(args)...);
+}
+
+// Mix b into a with a lipol_sse (or anything with store_block) as the gain. This is
+// mix.fade_2_blocks_inplace(aL, bL, aR, bR) with the fade itself dispatched.
+template <size_t blockSize, typename lipol>
+inline void fadeBlocksInplace(lipol &mix, float *aL, const float *bL, float *aR, const float *bR)
+{
+    float g alignas(16)[blockSize];
+    mix.store_block(g, blockSize >> 2);
+    dispatch<Fade2BlocksInplace<blockSize>>(aL, bL, aR, bR, g);
+}
+} // namespace sst::effects_shared::kernels
+
+#endif // INCLUDE_SST_EFFECTS_SHARED_SIMDKERNELS_H
@@ -0,0 +1,89 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_EFFECTS_SHARED_SPSCRING_H
+#define INCLUDE_SST_EFFECTS_SHARED_SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace sst::effects_shared
+{
+/*
+ * A wait free single producer, single consumer ring of fixed size slots, for handing
+ * blocks between the audio thread and a worker. The slots are used in place so a push
+ * or pop never copies or allocates: the producer fills `pushSlot()` and commits it
+ * with `commitPush()`, the consumer reads `popSlot()` and releases it with
+ * `commitPop()`. Both slot calls return nullptr when the ring is full or empty.
+ *
+ * reset() may only be called while neither side is using the ring.
+ */
+template <typename T, size_t capacity> struct SPSCRing
+{
+    static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+    // producer side
+    T *pushSlot()
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == capacity)
+            return nullptr;
+        return &slots[h & (capacity - 1)];
+    }
+    void commitPush()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // consumer side
+    T *popSlot()
+    {
+        auto t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t)
+            return nullptr;
+        return &slots[t & (capacity - 1)];
+    }
+    void commitPop()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // a snapshot: from the consumer it can only have grown since, from the producer shrunk
+    size_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+    void reset()
+    {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    // on their own cache lines so the two threads don't share one
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) T slots[capacity];
+};
+} // namespace sst::effects_shared
+
+#endif // INCLUDE_SST_EFFECTS_SHARED_SPSCRING_H
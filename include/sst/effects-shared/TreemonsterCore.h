@@ -21,8 +21,11 @@
 #ifndef INCLUDE_SST_EFFECTS_SHARED_TREEMONSTERCORE_H
 #define INCLUDE_SST_EFFECTS_SHARED_TREEMONSTERCORE_H
 
-#include <utility>
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <utility>
 
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/basic-blocks/dsp/Lag.h"
@@ -84,8 +87,7 @@ struct TreemonsterCore : public BaseClass
 
         processWithoutMixOrWith(dataL, dataR, wetL, wetR);
 
-        this->applyWidth(wetL, wetR, widthS, widthM);
-        mix.fade_2_blocks_inplace(dataL, wetL, dataR, wetR);
+        this->applyWidthAndMix(dataL, dataR, wetL, wetR, widthS, widthM, mix);
     }
 
     float L alignas(16)[FXConfig::blockSize], R alignas(16)[FXConfig::blockSize];
@@ -113,6 +115,10 @@ struct TreemonsterCore : public BaseClass
     void setvars(bool init);
 
   protected:
+    void trackCrossings(int c, const float *buf, float thres);
+
+    struct QuadrStepper;
+
     int bi; // block increment (to keep track of events not occurring every n blocks)
     float length[2], lastval[2], length_target[2], length_smooth[2];
     bool first_thresh[2];
@@ -172,6 +178,120 @@ inline void TreemonsterCore<BaseClass, BiquadType, addHPLP>::setvars(bool init)
         oscR.set_phase(M_PI / 2.0);
     }
 }
+/*
+ * The positive zero crossings of a channel, found a block at a time: compare the block
+ * against zero four samples at a time, movemask that into bit sets of negative and
+ * non-negative samples, and a crossing is a non-negative sample whose predecessor was
+ * negative. Only the (few) crossings then run the tracker. Between crossings the
+ * wavelength just counts samples, so it is worked out from the crossing positions,
+ * including the 2^24 where counting up by 1.f stalls.
+ */
+template <typename BaseClass, typename BiquadType, bool addHPLP>
+inline void TreemonsterCore<BaseClass, BiquadType, addHPLP>::trackCrossings(int c,
+                                                                           const float *buf,
+                                                                           float thres)
+{
+    static_assert(FXConfig::blockSize % 4 == 0);
+    static constexpr int nWords{(FXConfig::blockSize + 63) / 64};
+
+    // We assume wavelengths below this are just noisy detection errors. This is used to
+    // clamp when we have a pitch detect basically.
+    static constexpr float smallest_wavelength = 16.0;
+    static constexpr float countLimit = 16777216.f;
+
+    uint64_t neg[nWords]{}, nonneg[nWords]{};
+    const auto zero = SIMD_MM(setzero_ps)();
+    for (int k = 0; k < FXConfig::blockSize; k += 4)
+    {
+        auto v = SIMD_MM(load_ps)(buf + k);
+        neg[k >> 6] |= (uint64_t)SIMD_MM(movemask_ps)(SIMD_MM(cmplt_ps)(v, zero)) << (k & 63);
+        nonneg[k >> 6] |= (uint64_t)SIMD_MM(movemask_ps)(SIMD_MM(cmpge_ps)(v, zero))
+                          << (k & 63);
+    }
+
+    auto startLength = length[c];
+    int lastCrossing = -1;
+    uint64_t carry = lastval[c] < 0.f;
+    for (int w = 0; w < nWords; ++w)
+    {
+        auto crossings = ((neg[w] << 1) | carry) & nonneg[w];
+        carry = neg[w] >> 63;
+        while (crossings)
+        {
+            auto k = w * 64 + std::countr_zero(crossings);
+            crossings &= crossings - 1;
+
+            auto len = lastCrossing < 0 ? std::min(startLength + k, countLimit)
+                                        : (float)(k - lastCrossing);
+            if (buf[k] > thres && len > smallest_wavelength)
+            {
+                length_target[c] = (len > length_smooth[c] * 10 ? length_smooth[c] : len);
+                if (first_thresh[c])
+                    length_smooth[c] = len;
+                first_thresh[c] = false;
+            }
+            lastCrossing = k;
+        }
+    }
+
+    length[c] = lastCrossing < 0 ? std::min(startLength + FXConfig::blockSize, countLimit)
+                                 : (float)(FXConfig::blockSize - lastCrossing);
+    lastval[c] = buf[FXConfig::blockSize - 1];
+}
+
+/*
+ * Runs a quadr_osc four samples at a time. The rate is fixed over the block, so rather
+ * than rotate by it once per sample we rotate the starting phase by its first four
+ * powers, and then step those four by the fourth power. finish() leaves the oscillator
+ * where the same number of process() calls would, up to rounding.
+ */
+template <typename BaseClass, typename BiquadType, bool addHPLP>
+struct TreemonsterCore<BaseClass, BiquadType, addHPLP>::QuadrStepper
+{
+    SIMD_M128 r0, i0, wr, wi, r4, i4, zr, zi;
+
+    explicit QuadrStepper(const quadr_osc &osc)
+    {
+        float pr[4], pi[4];
+        pr[0] = osc.dr;
+        pi[0] = osc.di;
+        for (int m = 1; m < 4; ++m)
+        {
+            pr[m] = pr[m - 1] * osc.dr - pi[m - 1] * osc.di;
+            pi[m] = pr[m - 1] * osc.di + pi[m - 1] * osc.dr;
+        }
+        r0 = SIMD_MM(set1_ps)(osc.r);
+        i0 = SIMD_MM(set1_ps)(osc.i);
+        wr = SIMD_MM(loadu_ps)(pr);
+        wi = SIMD_MM(loadu_ps)(pi);
+        r4 = SIMD_MM(set1_ps)(pr[3]);
+        i4 = SIMD_MM(set1_ps)(pi[3]);
+        zr = r0;
+        zi = i0;
+    }
+
+    // writes the real part of the next four steps
+    void step(float *out)
+    {
+        zr = SIMD_MM(sub_ps)(SIMD_MM(mul_ps)(r0, wr), SIMD_MM(mul_ps)(i0, wi));
+        zi = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(r0, wi), SIMD_MM(mul_ps)(i0, wr));
+        SIMD_MM(store_ps)(out, zr);
+
+        auto nr = SIMD_MM(sub_ps)(SIMD_MM(mul_ps)(wr, r4), SIMD_MM(mul_ps)(wi, i4));
+        wi = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(wr, i4), SIMD_MM(mul_ps)(wi, r4));
+        wr = nr;
+    }
+
+    void finish(quadr_osc &osc) const
+    {
+        float lr alignas(16)[4], li alignas(16)[4];
+        SIMD_MM(store_ps)(lr, zr);
+        SIMD_MM(store_ps)(li, zi);
+        osc.r = lr[3];
+        osc.i = li[3];
+    }
+};
+
 template <typename BaseClass, typename BiquadType, bool addHPLP>
 void TreemonsterCore<BaseClass, BiquadType, addHPLP>::processWithoutMixOrWith(
     const float *const dataL, const float *const dataR, float *L, float *R)
@@ -208,12 +328,6 @@ void TreemonsterCore<BaseClass, BiquadType, addHPLP>::processWithoutMixOrWith(
         }
     }
 
-    /*
-     * We assume wavelengths below this are just noisy detection errors. This is used to
-     * clamp when we have a pitch detect basically.
-     */
-    constexpr float smallest_wavelength = 16.0;
-
     float qs = std::clamp(this->floatValue(tm_speed), 0.f, 1.f);
     qs *= qs * qs * qs;
     float speed = 0.9999 - qs * 0.0999 / 128;
@@ -245,74 +359,47 @@ void TreemonsterCore<BaseClass, BiquadType, addHPLP>::processWithoutMixOrWith(
     oscL.set_rate((2.0 * M_PI / std::max(2.f, length_smooth[0])) * twoToPitch);
     oscR.set_rate((2.0 * M_PI / std::max(2.f, length_smooth[1])) * twoToPitch);
 
-    for (int k = 0; k < FXConfig::blockSize; k++)
-    {
-        // envelope detection
-        for (int c = 0; c < 2; ++c)
-        {
-            auto v = (c == 0 ? dataL[k] : dataR[k]);
-            auto e = envV[c];
-
-            if (v > e)
-            {
-                e = envA * (e - v) + v;
-            }
-            else
-            {
-                e = envR * (e - v) + v;
-            }
-
-            envV[c] = e;
-            envelopeOut[c][k] = e;
-        }
-
-        // pitch detection
-        if ((lastval[0] < 0.f) && (tbuf[0][k] >= 0.f))
-        {
-            if (tbuf[0][k] > thres && length[0] > smallest_wavelength)
-            {
-                length_target[0] =
-                    (length[0] > length_smooth[0] * 10 ? length_smooth[0] : length[0]);
-                if (first_thresh[0])
-                    length_smooth[0] = length[0];
-                first_thresh[0] = false;
-            }
-
-            length[0] = 0.0; // (0.0-lastval[0]) / ( tbuf[0][k] - lastval[0]);
-        }
+    // pitch detection
+    trackCrossings(0, tbuf[0], thres);
+    trackCrossings(1, tbuf[1], thres);
 
-        if ((lastval[1] < 0.f) && (tbuf[1][k] >= 0.f))
+    // do not apply followed envelope to sine oscillator - we need full freight sine for RM.
+    // The envelope follower is a recursion through a comparison so stays scalar, but
+    // stepping the oscillators alongside it lets the two dependency chains overlap
+    QuadrStepper qL(oscL), qR(oscR);
+    for (int k0 = 0; k0 < FXConfig::blockSize; k0 += 4)
+    {
+        for (int k = k0; k < k0 + 4; k++)
         {
-            if (tbuf[1][k] > thres && length[1] > smallest_wavelength)
+            // envelope detection
+            for (int c = 0; c < 2; ++c)
             {
-                length_target[1] =
-                    (length[1] > length_smooth[1] * 10 ? length_smooth[1] : length[1]);
-                if (first_thresh[1])
-                    length_smooth[1] = length[1];
-                first_thresh[1] = false;
+                auto v = (c == 0 ? dataL[k] : dataR[k]);
+                auto e = envV[c];
+
+                if (v > e)
+                {
+                    e = envA * (e - v) + v;
+                }
+                else
+                {
+                    e = envR * (e - v) + v;
+                }
+
+                envV[c] = e;
+                envelopeOut[c][k] = e;
             }
-
-            length[1] = 0.0; // (0.0-lastval[1]) / ( tbuf[1][k] - lastval[1]);
         }
 
-        oscL.process();
-        oscR.process();
-
-        // do not apply followed envelope to sine oscillator - we need full freight sine for RM
-        L[k] = oscL.r;
-        R[k] = oscR.r;
-
-        // but we need to store the scaled for mix
-        envscaledSineWave[0][k] = oscL.r * envV[0];
-        envscaledSineWave[1][k] = oscR.r * envV[0];
-
-        // track positive zero crossings
-        length[0] += 1.0f;
-        length[1] += 1.0f;
-
-        lastval[0] = tbuf[0][k];
-        lastval[1] = tbuf[1][k];
+        qL.step(L + k0);
+        qR.step(R + k0);
     }
+    qL.finish(oscL);
+    qR.finish(oscR);
+
+    // but we need to store the scaled for mix
+    mech::mul_block<FXConfig::blockSize>(L, envelopeOut[0], envscaledSineWave[0]);
+    mech::mul_block<FXConfig::blockSize>(R, envelopeOut[0], envscaledSineWave[1]);
 
     // do dry signal * pitch tracked signal ringmod
     // store to pitch detection buffer
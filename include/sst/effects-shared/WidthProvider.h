@@ -22,6 +22,7 @@
 #define INCLUDE_SST_EFFECTS_SHARED_WIDTHPROVIDER_H
 
 #include "sst/basic-blocks/dsp/MidSide.h"
+#include "sst/effects-shared/SIMDKernels.h"
 
 namespace sst::effects_shared
 {
@@ -32,14 +33,46 @@ template <typename T, size_t blockSize, bool useGetFloatValue = false> struct Wi
     template <typename lipol>
     inline void applyWidth(float *__restrict L, float *__restrict R, lipol &widthS, lipol &widthM)
     {
-        namespace sdsp = sst::basic_blocks::dsp;
-        float M alignas(16)[blockSize], S alignas(16)[blockSize];
-        sdsp::encodeMS<blockSize>(L, R, M, S);
-        widthS.multiply_block(S, blockSize >> 2);
+        namespace kern = sst::effects_shared::kernels;
+        float wS alignas(16)[blockSize], wM alignas(16)[blockSize];
+        widthS.store_block(wS, blockSize >> 2);
         if constexpr (T::useLinearWidth())
-            widthM.multiply_block(M, blockSize >> 2);
+            widthM.store_block(wM, blockSize >> 2);
 
-        sdsp::decodeMS<blockSize>(M, S, L, R);
+        kern::dispatch<kern::MSWidth<blockSize, T::useLinearWidth()>>(L, R, wS, wM);
+    }
+
+    /*
+     * applyWidth on the wet pair followed by mix.fade_2_blocks_inplace(dryL, wetL, dryR,
+     * wetR), the usual end of an effect, in one pass over the block. Unlike applyWidth
+     * this leaves wetL and wetR as they were. If outputGain is given the mixed result is
+     * also multiplied by it, as a multiply_2_blocks on dryL and dryR would.
+     */
+    template <typename lipol, typename mixLipol, typename gainLipol = mixLipol>
+    inline void applyWidthAndMix(float *__restrict dryL, float *__restrict dryR,
+                                 const float *__restrict wetL, const float *__restrict wetR,
+                                 lipol &widthS, lipol &widthM, mixLipol &mix,
+                                 gainLipol *outputGain = nullptr)
+    {
+        namespace kern = sst::effects_shared::kernels;
+        float wS alignas(16)[blockSize], wM alignas(16)[blockSize], g alignas(16)[blockSize];
+        widthS.store_block(wS, blockSize >> 2);
+        if constexpr (T::useLinearWidth())
+            widthM.store_block(wM, blockSize >> 2);
+        mix.store_block(g, blockSize >> 2);
+
+        if (outputGain)
+        {
+            float o alignas(16)[blockSize];
+            outputGain->store_block(o, blockSize >> 2);
+            kern::dispatch<kern::MSWidthFade2BlocksInplace<blockSize, T::useLinearWidth(), true>>(
+                dryL, wetL, dryR, wetR, wS, wM, g, o);
+        }
+        else
+        {
+            kern::dispatch<kern::MSWidthFade2BlocksInplace<blockSize, T::useLinearWidth()>>(
+                dryL, wetL, dryR, wetR, wS, wM, g, nullptr);
+        }
     }
 
     basic_blocks::params::ParamMetaData getWidthParam() const
@@ -20,8 +20,11 @@
 #ifndef INCLUDE_SST_EFFECTS_BONSAI_H
 #define INCLUDE_SST_EFFECTS_BONSAI_H
 
+#include <cstdint>
 #include <cstring>
+#include <type_traits>
 #include "EffectCore.h"
+#include "sst/basic-blocks/simd/setup.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/basic-blocks/dsp/Lag.h"
 #include "sst/basic-blocks/dsp/BlockInterpolators.h"
@@ -772,6 +775,837 @@ template <size_t blockSize> inline void noise_ds4(float &last, float *__restrict
     }
 }
 
+/*
+ * SIMD versions of the block helpers above, with the same names and signatures. They
+ * work 4 lanes at a time through SIMD_MM, or 8 at a time when the build targets AVX2
+ * and the block is a multiple of 8. The transcendental clippers use polynomial log, exp
+ * and sin instead of the libm calls (accurate to a few ulp in the range Bonsai drives
+ * them, with sin reduced well up to |x| of a few thousand) and the rational clippers
+ * are the same arithmetic. The recursive filters have nothing to vectorize across a
+ * block and are the scalar versions.
+ *
+ * Bonsai uses these unless SST_EFFECTS_BONSAI_SCALAR_HELPERS is defined to 1, in which
+ * case it uses the scalar versions above, which remain the reference.
+ */
+namespace simd
+{
+namespace details
+{
+struct F4
+{
+    using v_t = SIMD_M128;
+    using vi_t = SIMD_M128I;
+    static constexpr size_t width{4};
+
+    static v_t load(const float *f) { return SIMD_MM(load_ps)(f); }
+    static void store(float *f, v_t a) { SIMD_MM(store_ps)(f, a); }
+    static v_t set1(float f) { return SIMD_MM(set1_ps)(f); }
+    static v_t zero() { return SIMD_MM(setzero_ps)(); }
+
+    static v_t add(v_t a, v_t b) { return SIMD_MM(add_ps)(a, b); }
+    static v_t sub(v_t a, v_t b) { return SIMD_MM(sub_ps)(a, b); }
+    static v_t mul(v_t a, v_t b) { return SIMD_MM(mul_ps)(a, b); }
+    static v_t div(v_t a, v_t b) { return SIMD_MM(div_ps)(a, b); }
+    static v_t min(v_t a, v_t b) { return SIMD_MM(min_ps)(a, b); }
+    static v_t max(v_t a, v_t b) { return SIMD_MM(max_ps)(a, b); }
+    static v_t sqrt(v_t a) { return SIMD_MM(sqrt_ps)(a); }
+
+    static v_t andv(v_t a, v_t b) { return SIMD_MM(and_ps)(a, b); }
+    static v_t andnotv(v_t a, v_t b) { return SIMD_MM(andnot_ps)(a, b); }
+    static v_t xorv(v_t a, v_t b) { return SIMD_MM(xor_ps)(a, b); }
+    static v_t cmplt(v_t a, v_t b) { return SIMD_MM(cmplt_ps)(a, b); }
+    static v_t cmpgt(v_t a, v_t b) { return SIMD_MM(cmpgt_ps)(a, b); }
+    static v_t select(v_t mask, v_t a, v_t b)
+    {
+        return SIMD_MM(or_ps)(SIMD_MM(and_ps)(mask, a), SIMD_MM(andnot_ps)(mask, b));
+    }
+
+    static vi_t loadi(const int32_t *i) { return SIMD_MM(load_si128)((const vi_t *)i); }
+    static void storei(int32_t *i, vi_t a) { SIMD_MM(store_si128)((vi_t *)i, a); }
+    static vi_t set1i(int32_t i) { return SIMD_MM(set1_epi32)(i); }
+    static vi_t truncate(v_t a) { return SIMD_MM(cvttps_epi32)(a); }
+    static v_t tofloat(vi_t a) { return SIMD_MM(cvtepi32_ps)(a); }
+    static vi_t asint(v_t a) { return SIMD_MM(castps_si128)(a); }
+    static v_t asfloat(vi_t a) { return SIMD_MM(castsi128_ps)(a); }
+    static vi_t addi(vi_t a, vi_t b) { return SIMD_MM(add_epi32)(a, b); }
+    static vi_t subi(vi_t a, vi_t b) { return SIMD_MM(sub_epi32)(a, b); }
+    static vi_t andi(vi_t a, vi_t b) { return SIMD_MM(and_si128)(a, b); }
+    static vi_t andnoti(vi_t a, vi_t b) { return SIMD_MM(andnot_si128)(a, b); }
+    static vi_t cmpeqi(vi_t a, vi_t b) { return SIMD_MM(cmpeq_epi32)(a, b); }
+    template <int n> static vi_t shli(vi_t a) { return SIMD_MM(slli_epi32)(a, n); }
+    template <int n> static vi_t shri(vi_t a) { return SIMD_MM(srli_epi32)(a, n); }
+    // sse2 has no 32 bit mullo, so multiply the even and odd lanes as 64 bit products
+    static vi_t muli(vi_t a, vi_t b)
+    {
+        auto ev = SIMD_MM(mul_epu32)(a, b);
+        auto od = SIMD_MM(mul_epu32)(SIMD_MM(srli_epi64)(a, 32), SIMD_MM(srli_epi64)(b, 32));
+        return SIMD_MM(unpacklo_epi32)(SIMD_MM(shuffle_epi32)(ev, SIMD_MM_SHUFFLE(0, 0, 2, 0)),
+                                       SIMD_MM(shuffle_epi32)(od, SIMD_MM_SHUFFLE(0, 0, 2, 0)));
+    }
+};
+
+#if defined(__AVX2__)
+struct F8
+{
+    using v_t = __m256;
+    using vi_t = __m256i;
+    static constexpr size_t width{8};
+
+    // our blocks are only promised 16 byte alignment
+    static v_t load(const float *f) { return _mm256_loadu_ps(f); }
+    static void store(float *f, v_t a) { _mm256_storeu_ps(f, a); }
+    static v_t set1(float f) { return _mm256_set1_ps(f); }
+    static v_t zero() { return _mm256_setzero_ps(); }
+
+    static v_t add(v_t a, v_t b) { return _mm256_add_ps(a, b); }
+    static v_t sub(v_t a, v_t b) { return _mm256_sub_ps(a, b); }
+    static v_t mul(v_t a, v_t b) { return _mm256_mul_ps(a, b); }
+    static v_t div(v_t a, v_t b) { return _mm256_div_ps(a, b); }
+    static v_t min(v_t a, v_t b) { return _mm256_min_ps(a, b); }
+    static v_t max(v_t a, v_t b) { return _mm256_max_ps(a, b); }
+    static v_t sqrt(v_t a) { return _mm256_sqrt_ps(a); }
+
+    static v_t andv(v_t a, v_t b) { return _mm256_and_ps(a, b); }
+    static v_t andnotv(v_t a, v_t b) { return _mm256_andnot_ps(a, b); }
+    static v_t xorv(v_t a, v_t b) { return _mm256_xor_ps(a, b); }
+    static v_t cmplt(v_t a, v_t b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static v_t cmpgt(v_t a, v_t b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static v_t select(v_t mask, v_t a, v_t b) { return _mm256_blendv_ps(b, a, mask); }
+
+    static vi_t loadi(const int32_t *i) { return _mm256_loadu_si256((const vi_t *)i); }
+    static void storei(int32_t *i, vi_t a) { _mm256_storeu_si256((vi_t *)i, a); }
+    static vi_t set1i(int32_t i) { return _mm256_set1_epi32(i); }
+    static vi_t truncate(v_t a) { return _mm256_cvttps_epi32(a); }
+    static v_t tofloat(vi_t a) { return _mm256_cvtepi32_ps(a); }
+    static vi_t asint(v_t a) { return _mm256_castps_si256(a); }
+    static v_t asfloat(vi_t a) { return _mm256_castsi256_ps(a); }
+    static vi_t addi(vi_t a, vi_t b) { return _mm256_add_epi32(a, b); }
+    static vi_t subi(vi_t a, vi_t b) { return _mm256_sub_epi32(a, b); }
+    static vi_t andi(vi_t a, vi_t b) { return _mm256_and_si256(a, b); }
+    static vi_t andnoti(vi_t a, vi_t b) { return _mm256_andnot_si256(a, b); }
+    static vi_t cmpeqi(vi_t a, vi_t b) { return _mm256_cmpeq_epi32(a, b); }
+    template <int n> static vi_t shli(vi_t a) { return _mm256_slli_epi32(a, n); }
+    template <int n> static vi_t shri(vi_t a) { return _mm256_srli_epi32(a, n); }
+    static vi_t muli(vi_t a, vi_t b) { return _mm256_mullo_epi32(a, b); }
+};
+
+template <size_t blockSize> using lanes_t = std::conditional_t<blockSize % 8 == 0, F8, F4>;
+#else
+template <size_t blockSize> using lanes_t = F4;
+#endif
+
+template <typename V> inline typename V::v_t absv(typename V::v_t x)
+{
+    return V::andnotv(V::set1(-0.f), x);
+}
+template <typename V> inline typename V::v_t signof(typename V::v_t x)
+{
+    return V::andv(V::set1(-0.f), x);
+}
+
+// natural log for positive normal x; the cephes logf polynomial
+template <typename V> inline typename V::v_t log(typename V::v_t x)
+{
+    auto ex = V::subi(V::template shri<23>(V::asint(x)), V::set1i(0x7e));
+    auto m = V::asfloat(V::andi(V::asint(x), V::set1i(0x807fffff)));
+    m = V::asfloat(V::addi(V::asint(m), V::set1i(0x3f000000))); // mantissa in [0.5, 1)
+    auto e = V::tofloat(ex);
+
+    auto small = V::cmplt(m, V::set1(0.707106781186547524f));
+    e = V::sub(e, V::andv(small, V::set1(1.f)));
+    m = V::add(V::sub(m, V::set1(1.f)), V::andv(small, m));
+
+    auto z = V::mul(m, m);
+    auto y = V::set1(7.0376836292e-2f);
+    y = V::add(V::mul(y, m), V::set1(-1.1514610310e-1f));
+    y = V::add(V::mul(y, m), V::set1(1.1676998740e-1f));
+    y = V::add(V::mul(y, m), V::set1(-1.2420140846e-1f));
+    y = V::add(V::mul(y, m), V::set1(1.4249322787e-1f));
+    y = V::add(V::mul(y, m), V::set1(-1.6668057665e-1f));
+    y = V::add(V::mul(y, m), V::set1(2.0000714765e-1f));
+    y = V::add(V::mul(y, m), V::set1(-2.4999993993e-1f));
+    y = V::add(V::mul(y, m), V::set1(3.3333331174e-1f));
+    y = V::mul(V::mul(y, m), z);
+
+    y = V::add(y, V::mul(e, V::set1(-2.12194440e-4f)));
+    y = V::sub(y, V::mul(z, V::set1(0.5f)));
+    return V::add(V::add(m, y), V::mul(e, V::set1(0.693359375f)));
+}
+
+// e^x, saturating rather than overflowing past |x| of 88; the cephes expf polynomial
+template <typename V> inline typename V::v_t exp(typename V::v_t x)
+{
+    x = V::max(V::min(x, V::set1(88.f)), V::set1(-88.f));
+
+    auto fx = V::add(V::mul(x, V::set1(1.44269504088896341f)), V::set1(0.5f));
+    auto fl = V::tofloat(V::truncate(fx));
+    fx = V::sub(fl, V::andv(V::cmpgt(fl, fx), V::set1(1.f)));
+
+    x = V::sub(x, V::mul(fx, V::set1(0.693359375f)));
+    x = V::sub(x, V::mul(fx, V::set1(-2.12194440e-4f)));
+    auto z = V::mul(x, x);
+
+    auto y = V::set1(1.9875691500e-4f);
+    y = V::add(V::mul(y, x), V::set1(1.3981999507e-3f));
+    y = V::add(V::mul(y, x), V::set1(8.3334519073e-3f));
+    y = V::add(V::mul(y, x), V::set1(4.1665795894e-2f));
+    y = V::add(V::mul(y, x), V::set1(1.6666665459e-1f));
+    y = V::add(V::mul(y, x), V::set1(5.0000001201e-1f));
+    y = V::add(V::add(V::mul(y, z), x), V::set1(1.f));
+
+    auto p2 = V::asfloat(V::template shli<23>(V::addi(V::truncate(fx), V::set1i(0x7f))));
+    return V::mul(y, p2);
+}
+
+// sin and cos share the octant reduction and the two cephes polynomials
+template <typename V, bool isCos> inline typename V::v_t sincos(typename V::v_t x)
+{
+    auto sign = isCos ? V::zero() : signof<V>(x);
+    x = absv<V>(x);
+
+    auto j = V::truncate(V::mul(x, V::set1(1.27323954473516f))); // 4 / pi
+    j = V::andi(V::addi(j, V::set1i(1)), V::set1i(~1));
+    auto y = V::tofloat(j);
+    if constexpr (isCos)
+    {
+        j = V::subi(j, V::set1i(2));
+        sign = V::asfloat(V::template shli<29>(V::andnoti(j, V::set1i(4))));
+    }
+    else
+    {
+        sign = V::xorv(sign, V::asfloat(V::template shli<29>(V::andi(j, V::set1i(4)))));
+    }
+    auto polySin = V::asfloat(V::cmpeqi(V::andi(j, V::set1i(2)), V::set1i(0)));
+
+    x = V::add(x, V::mul(y, V::set1(-0.78515625f)));
+    x = V::add(x, V::mul(y, V::set1(-2.4187564849853515625e-4f)));
+    x = V::add(x, V::mul(y, V::set1(-3.77489497744594108e-8f)));
+    auto z = V::mul(x, x);
+
+    auto c = V::set1(2.443315711809948e-5f);
+    c = V::add(V::mul(c, z), V::set1(-1.388731625493765e-3f));
+    c = V::add(V::mul(c, z), V::set1(4.166664568298827e-2f));
+    c = V::mul(V::mul(c, z), z);
+    c = V::add(V::sub(c, V::mul(z, V::set1(0.5f))), V::set1(1.f));
+
+    auto s = V::set1(-1.9515295891e-4f);
+    s = V::add(V::mul(s, z), V::set1(8.3321608736e-3f));
+    s = V::add(V::mul(s, z), V::set1(-1.6666654611e-1f));
+    s = V::add(V::mul(V::mul(s, z), x), x);
+
+    return V::xorv(V::select(polySin, s, c), sign);
+}
+template <typename V> inline typename V::v_t sin(typename V::v_t x) { return sincos<V, false>(x); }
+template <typename V> inline typename V::v_t cos(typename V::v_t x) { return sincos<V, true>(x); }
+
+template <typename V> inline typename V::v_t alpha(typename V::v_t w)
+{
+    const auto one = V::set1(1.f);
+    auto twomcos = V::sub(V::set1(2.f), cos<V>(w));
+    auto r = V::sqrt(V::sub(V::mul(twomcos, twomcos), one));
+    return V::sub(one, V::sub(twomcos, r));
+}
+
+template <typename V> inline typename V::v_t inv_sinh(typename V::v_t x)
+{
+    auto abs2x = V::mul(V::set1(2.f), absv<V>(x));
+    auto r = V::add(abs2x, V::sqrt(V::add(V::mul(abs2x, abs2x), V::set1(1.f))));
+    return V::xorv(V::mul(log<V>(r), V::set1(0.5f)), signof<V>(x));
+}
+
+// saturates to exactly +-1 past 3, as sdsp::fasttanh does
+template <typename V> inline typename V::v_t tanh76(typename V::v_t x)
+{
+    auto out = V::cmpgt(absv<V>(x), V::set1(3.f));
+    auto sat = V::xorv(V::set1(1.f), signof<V>(x));
+    x = V::max(V::min(x, V::set1(3.f)), V::set1(-3.f));
+    auto x2 = V::mul(x, x);
+    auto n = V::add(V::mul(x2, V::add(V::set1(378.f), x2)), V::set1(17325.f));
+    n = V::mul(x, V::add(V::mul(x2, n), V::set1(135135.f)));
+    auto d = V::add(V::set1(3150.f), V::mul(V::set1(28.f), x2));
+    d = V::add(V::set1(62370.f), V::mul(x2, d));
+    d = V::add(V::set1(135135.f), V::mul(x2, d));
+    return V::select(out, sat, V::div(n, d));
+}
+
+// the same operation order as fasttanh78, so these agree with it exactly
+template <typename V> inline typename V::v_t tanh78(typename V::v_t x)
+{
+    auto x2 = V::mul(x, x);
+    auto n = V::add(V::set1(6930.f), V::mul(x2, V::set1(36.f)));
+    n = V::add(V::set1(270270.f), V::mul(x2, n));
+    n = V::mul(x, V::add(V::set1(2027025.f), V::mul(x2, n)));
+    auto d = V::add(V::set1(630.f), x2);
+    d = V::add(V::set1(51975.f), V::mul(x2, d));
+    d = V::add(V::set1(945945.f), V::mul(x2, d));
+    d = V::add(V::set1(2027025.f), V::mul(x2, d));
+    return V::div(n, d);
+}
+
+template <typename V> inline typename V::v_t tanh_foldback(typename V::v_t x)
+{
+    auto x2 = V::mul(x, x);
+    auto n = V::mul(V::mul(x, V::set1(5.f)), V::add(V::set1(21.f), V::mul(x2, V::set1(2.f))));
+    auto d = V::mul(V::mul(V::set1(0.6825f), x2), V::add(V::set1(45.f), V::mul(x2, V::set1(6.f))));
+    return V::div(n, V::add(V::set1(105.f), d));
+}
+
+template <typename V> inline typename V::v_t sine_tanh(typename V::v_t x)
+{
+    auto x8 = V::mul(x, V::set1(0.125f));
+    auto e = exp<V>(absv<V>(x8));
+    auto sech = V::div(V::set1(2.f), V::add(e, V::div(V::set1(1.f), e)));
+    auto r = V::mul(V::add(sech, V::set1(0.125f)), sin<V>(x));
+    return V::add(r, V::mul(V::set1(0.5f), tanh78<V>(x8)));
+}
+
+// applies f(src[i] * invlevel) * level, for a constant or per sample level
+template <size_t blockSize, typename F>
+inline void clip(float invlevel, float level, const float *src, float *dst, F f)
+{
+    using V = lanes_t<blockSize>;
+    const auto il = V::set1(invlevel), l = V::set1(level);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::mul(f(V::mul(il, V::load(src + i))), l));
+}
+template <size_t blockSize, typename F>
+inline void clip(const float *level, const float *src, float *dst, F f)
+{
+    using V = lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto l = V::load(level + i);
+        V::store(dst + i, V::mul(f(V::div(V::load(src + i), l)), l));
+    }
+}
+
+// the ith group of lcg states is the first one advanced by i * width steps
+template <size_t blockSize> inline void lcg_block(int32_t seed, int32_t *__restrict temp)
+{
+    using V = lanes_t<blockSize>;
+    uint32_t mul = 1, add = 0;
+    for (auto i = 0U; i < V::width; ++i)
+    {
+        add = add * 1103515245U + 12345U;
+        mul = mul * 1103515245U;
+    }
+    temp[0] = super_simple_noise(seed);
+    for (auto i = 1U; i < V::width; ++i)
+        temp[i] = super_simple_noise(temp[i - 1]);
+    auto x = V::loadi(temp);
+    const auto m = V::set1i((int32_t)mul), a = V::set1i((int32_t)add);
+    for (auto i = V::width; i < blockSize; i += V::width)
+    {
+        x = V::addi(V::muli(x, m), a);
+        V::storei(temp + i, x);
+    }
+}
+template <size_t blockSize> inline void noise_scale(const int32_t *temp, float *__restrict dst)
+{
+    using V = lanes_t<blockSize>;
+    const auto scale = V::set1(4.656700025584826e-10f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::mul(scale, V::tofloat(V::loadi(temp + i))));
+}
+} // namespace details
+
+template <size_t blockSize>
+inline void freq_sr_to_alpha_reaktor(float *__restrict freq, float sr, float *__restrict coef)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto pidivsr = V::set1(M_PI / sr), lo = V::set1(0.001f), hi = V::set1(0.5 * M_PI);
+    const auto one = V::set1(1.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto in = V::min(hi, V::mul(V::max(lo, V::load(freq + i)), pidivsr));
+        auto n = V::sub(V::set1(0.0388452f), V::mul(V::set1(0.0896638f), in));
+        n = V::mul(V::add(V::mul(n, in), V::set1(1.00005f)), in);
+        auto d = V::sub(V::set1(0.0404318f), V::mul(V::set1(0.430871f), in));
+        d = V::add(V::mul(d, in), one);
+        auto tanapprox = V::div(n, d);
+        V::store(coef + i, V::div(tanapprox, V::add(tanapprox, one)));
+    }
+}
+// unlike the scalar version this fills coef[0] too
+template <size_t blockSize>
+inline void freq_sr_to_alpha(float *__restrict freq, float sr, float *__restrict coef)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto twopi_dt = V::set1((2.f * M_PI) / sr);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(coef + i, details::alpha<V>(V::mul(twopi_dt, V::load(freq + i))));
+}
+template <size_t blockSize>
+inline void freq_twopi_dt_to_alpha(float *__restrict freq, float twopi_dt, float *__restrict coef)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto tpdt = V::set1(twopi_dt);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(coef + i, details::alpha<V>(V::mul(tpdt, V::load(freq + i))));
+}
+template <size_t blockSize>
+inline void freq_sr_to_alpha_wrong_old(float *__restrict freq, float sr, float *__restrict coef)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto twopi = V::set1(2.f * M_PI), s = V::set1(sr);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto freq2pi = V::mul(twopi, V::load(freq + i));
+        V::store(coef + i, V::div(freq2pi, V::add(freq2pi, s)));
+    }
+}
+template <size_t blockSize>
+inline void freq_sr2pi_to_alpha_wrong_old(float *__restrict freq, float sr_div2pi,
+                                          float *__restrict coef)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto s = V::set1(sr_div2pi);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto f = V::load(freq + i);
+        V::store(coef + i, V::div(f, V::add(f, s)));
+    }
+}
+
+// each sample depends on the one before
+using ::sst::effects::bonsai::onepole_lp;
+using ::sst::effects::bonsai::onepole_lp_different;
+using ::sst::effects::bonsai::unit_delay;
+
+template <size_t blockSize>
+inline void sum2(float *__restrict one, float *__restrict two, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::add(V::load(one + i), V::load(two + i)));
+}
+template <size_t blockSize>
+inline void sum2(float one, float *__restrict two, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto o = V::set1(one);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::add(o, V::load(two + i)));
+}
+template <size_t blockSize>
+inline void sum2(float *__restrict one, float two, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto t = V::set1(two);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::add(V::load(one + i), t));
+}
+template <size_t blockSize> inline void sum2(float *__restrict srcDst, float *__restrict plus)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(srcDst + i, V::add(V::load(srcDst + i), V::load(plus + i)));
+}
+template <size_t blockSize> inline void sum2(float *__restrict srcDst, float plus)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto p = V::set1(plus);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(srcDst + i, V::add(V::load(srcDst + i), p));
+}
+
+template <size_t blockSize>
+inline void sum3(float *__restrict one, float *__restrict two, float *__restrict three,
+                 float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i,
+                 V::add(V::add(V::load(one + i), V::load(two + i)), V::load(three + i)));
+}
+template <size_t blockSize>
+inline void minus2(float *__restrict one, float two, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto t = V::set1(two);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::sub(V::load(one + i), t));
+}
+template <size_t blockSize>
+inline void minus2(float *__restrict one, float *__restrict two, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::sub(V::load(one + i), V::load(two + i)));
+}
+template <size_t blockSize> inline void minus2(float *__restrict sdst, float *__restrict two)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(sdst + i, V::sub(V::load(sdst + i), V::load(two + i)));
+}
+
+template <size_t blockSize>
+inline void mul(float *__restrict src1, float src2, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto s = V::set1(src2);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::mul(V::load(src1 + i), s));
+}
+template <size_t blockSize>
+inline void mul(float *__restrict src1, float *__restrict src2, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::mul(V::load(src1 + i), V::load(src2 + i)));
+}
+template <size_t blockSize> inline void mul(float *__restrict src1, float *__restrict src2)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(src1 + i, V::mul(V::load(src1 + i), V::load(src2 + i)));
+}
+template <size_t blockSize> inline void mul(float *__restrict src1, float by)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto b = V::set1(by);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(src1 + i, V::mul(V::load(src1 + i), b));
+}
+
+template <size_t blockSize>
+inline void div(float *__restrict src1, float src2, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto s = V::set1(src2);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::div(V::load(src1 + i), s));
+}
+template <size_t blockSize>
+inline void div(float src1, float *__restrict src2, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto s = V::set1(src1);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::div(s, V::load(src2 + i)));
+}
+template <size_t blockSize>
+inline void div(float *__restrict src1, float *__restrict src2, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::div(V::load(src1 + i), V::load(src2 + i)));
+}
+
+template <size_t blockSize> inline void mul_inplace(float *__restrict src, float factor)
+{
+    mul<blockSize>(src, factor);
+}
+template <size_t blockSize> inline void mul_inplace(float *__restrict src, float *__restrict factor)
+{
+    mul<blockSize>(src, factor);
+}
+
+template <size_t blockSize> inline void negate(float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto sign = V::set1(-0.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::xorv(V::load(src + i), sign));
+}
+
+template <size_t blockSize>
+inline void onepole_hp(float &last, const float *__restrict coef, float *__restrict src,
+                       float *__restrict dst)
+{
+    float lp alignas(16)[blockSize];
+    onepole_lp<blockSize>(last, coef, src, lp);
+    minus2<blockSize>(src, lp, dst);
+}
+template <size_t blockSize>
+inline void onepole_hp(float &last, const float coef, float *__restrict src, float *__restrict dst)
+{
+    float lp alignas(16)[blockSize];
+    onepole_lp<blockSize>(last, coef, src, lp);
+    minus2<blockSize>(src, lp, dst);
+}
+
+template <size_t blockSize>
+inline void clip_inv_sinh(float invlevel, float level, float *src, float *dst)
+{
+    details::clip<blockSize>(invlevel, level, src, dst,
+                             details::inv_sinh<details::lanes_t<blockSize>>);
+}
+template <size_t blockSize> inline void clip_inv_sinh(float level, float *src, float *dst)
+{
+    clip_inv_sinh<blockSize>(1 / level, level, src, dst);
+}
+template <size_t blockSize> inline void clip_inv_sinh(float *level, float *src, float *dst)
+{
+    details::clip<blockSize>(level, src, dst, details::inv_sinh<details::lanes_t<blockSize>>);
+}
+
+template <size_t blockSize>
+inline void clip_tanh76(float invlevel, float level, float *__restrict src, float *__restrict dst)
+{
+    details::clip<blockSize>(invlevel, level, src, dst,
+                             details::tanh76<details::lanes_t<blockSize>>);
+}
+template <size_t blockSize>
+inline void clip_tanh76(float *__restrict level, float *__restrict src, float *__restrict dst)
+{
+    details::clip<blockSize>(level, src, dst, details::tanh76<details::lanes_t<blockSize>>);
+}
+
+template <size_t blockSize>
+inline void clip_tanh78(float invlevel, float level, float *src, float *dst)
+{
+    details::clip<blockSize>(invlevel, level, src, dst,
+                             details::tanh78<details::lanes_t<blockSize>>);
+}
+template <size_t blockSize> inline void clip_tanh78(float level, float *src, float *dst)
+{
+    clip_tanh78<blockSize>(1 / level, level, src, dst);
+}
+template <size_t blockSize> inline void clip_tanh78(float *level, float *src, float *dst)
+{
+    details::clip<blockSize>(level, src, dst, details::tanh78<details::lanes_t<blockSize>>);
+}
+
+template <size_t blockSize>
+inline void clip_tanh_foldback(float invlevel, float level, float *__restrict src,
+                               float *__restrict dst)
+{
+    details::clip<blockSize>(invlevel, level, src, dst,
+                             details::tanh_foldback<details::lanes_t<blockSize>>);
+}
+template <size_t blockSize>
+inline void clip_tanh_foldback(float level, float *__restrict src, float *__restrict dst)
+{
+    clip_tanh_foldback<blockSize>(1 / level, level, src, dst);
+}
+template <size_t blockSize> inline void clip_tanh_foldback(float *level, float *src, float *dst)
+{
+    details::clip<blockSize>(level, src, dst,
+                             details::tanh_foldback<details::lanes_t<blockSize>>);
+}
+
+template <size_t blockSize>
+inline void clip_sine_tanh(float invlevel, float level, float *__restrict src,
+                           float *__restrict dst)
+{
+    details::clip<blockSize>(invlevel, level, src, dst,
+                             details::sine_tanh<details::lanes_t<blockSize>>);
+}
+template <size_t blockSize>
+inline void clip_sine_tanh(float level, float *__restrict src, float *__restrict dst)
+{
+    clip_sine_tanh<blockSize>(1 / level, level, src, dst);
+}
+template <size_t blockSize> inline void clip_sine_tanh(float *level, float *src, float *dst)
+{
+    details::clip<blockSize>(level, src, dst, details::sine_tanh<details::lanes_t<blockSize>>);
+}
+
+template <size_t blockSize>
+inline void rerange(float *__restrict in, float l1, float h1, float l2, float h2,
+                    float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto inv_h1_m_l1 = V::set1(1.f / (h1 - l1)), h2_m_l2 = V::set1(h2 - l2);
+    const auto vl1 = V::set1(l1), vl2 = V::set1(l2);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto r = V::mul(V::mul(V::sub(V::load(in + i), vl1), h2_m_l2), inv_h1_m_l1);
+        V::store(dst + i, V::add(r, vl2));
+    }
+}
+template <size_t blockSize>
+inline void rerange(float *__restrict in, float l1, float h1, float *__restrict l2,
+                    float *__restrict h2, float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto inv_h1_m_l1 = V::set1(1.f / (h1 - l1)), vl1 = V::set1(l1);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto vl2 = V::load(l2 + i);
+        auto r = V::mul(V::sub(V::load(in + i), vl1), V::sub(V::load(h2 + i), vl2));
+        V::store(dst + i, V::add(V::mul(r, inv_h1_m_l1), vl2));
+    }
+}
+template <size_t blockSize>
+inline void rerange(float *__restrict in, float *__restrict l1, float *__restrict h1,
+                    float *__restrict l2, float *__restrict h2, float *__restrict src,
+                    float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto one = V::set1(1.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto vl1 = V::load(l1 + i), vl2 = V::load(l2 + i);
+        auto r = V::mul(V::sub(V::load(in + i), vl1), V::sub(V::load(h2 + i), vl2));
+        r = V::mul(r, V::div(one, V::sub(V::load(h1 + i), vl1)));
+        V::store(dst + i, V::add(r, vl2));
+    }
+}
+template <size_t blockSize>
+inline void rerange01(float *__restrict in, float l2, float h2, float *__restrict src,
+                      float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto h2_m_l2 = V::set1(h2 - l2), vl2 = V::set1(l2);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::add(V::mul(V::load(in + i), h2_m_l2), vl2));
+}
+template <size_t blockSize>
+inline void rerange01(float *__restrict in, float *__restrict l2, float *__restrict h2,
+                      float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto vl2 = V::load(l2 + i);
+        V::store(dst + i, V::add(V::mul(V::load(in + i), V::sub(V::load(h2 + i), vl2)), vl2));
+    }
+}
+template <size_t blockSize>
+inline void rerange1b(float *__restrict in, float l2, float h2, float *__restrict src,
+                      float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto h2_m_l2 = V::set1(h2 - l2), vl2 = V::set1(l2), one = V::set1(1.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::add(V::mul(V::sub(V::load(in + i), one), h2_m_l2), vl2));
+}
+template <size_t blockSize>
+inline void rerange1b(float *__restrict in, float *__restrict l2, float *__restrict h2,
+                      float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto one = V::set1(1.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto vl2 = V::load(l2 + i);
+        auto r = V::mul(V::sub(V::load(in + i), one), V::sub(V::load(h2 + i), vl2));
+        V::store(dst + i, V::add(r, vl2));
+    }
+}
+
+template <size_t blockSize> inline void invsq(float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto one = V::set1(1.f);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto inv = V::sub(one, V::load(src + i));
+        V::store(dst + i, V::sub(one, V::mul(inv, inv)));
+    }
+}
+
+template <size_t blockSize>
+inline void clampbi(float minmax, float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto hi = V::set1(minmax), lo = V::set1(-minmax);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::max(V::min(V::load(src + i), hi), lo));
+}
+template <size_t blockSize>
+inline void max(float *__restrict src, float value, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto v = V::set1(value);
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, V::max(V::load(src + i), v));
+}
+template <size_t blockSize> inline void max(float *__restrict srcdst, float value)
+{
+    max<blockSize>(srcdst, value, srcdst);
+}
+
+template <size_t blockSize>
+inline void lerp(float *__restrict src1, float *__restrict src2, float mix, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    const auto m = V::set1(mix);
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto a = V::load(src1 + i);
+        V::store(dst + i, V::add(V::mul(V::sub(V::load(src2 + i), a), m), a));
+    }
+}
+template <size_t blockSize>
+inline void lerp(float *__restrict src1, float *__restrict src2, float *__restrict mix,
+                 float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto a = V::load(src1 + i);
+        V::store(dst + i, V::add(V::mul(V::sub(V::load(src2 + i), a), V::load(mix + i)), a));
+    }
+}
+// inplace version
+template <size_t blockSize>
+inline void lerp(float *__restrict srcDest, float *__restrict src2, float *__restrict mix)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+    {
+        auto a = V::load(srcDest + i);
+        V::store(srcDest + i,
+                 V::add(V::mul(V::sub(V::load(src2 + i), a), V::load(mix + i)), a));
+    }
+}
+
+template <size_t blockSize> inline void blockabs(float *__restrict src, float *__restrict dst)
+{
+    using V = details::lanes_t<blockSize>;
+    for (auto i = 0U; i < blockSize; i += V::width)
+        V::store(dst + i, details::absv<V>(V::load(src + i)));
+}
+template <size_t blockSize> inline void blockabs(float *src) { blockabs<blockSize>(src, src); }
+
+template <size_t blockSize> inline void noise(float &last, float *__restrict dst)
+{
+    int32_t temp alignas(32)[blockSize];
+    details::lcg_block<blockSize>((int32_t)last, temp);
+    last = temp[blockSize - 1];
+    details::noise_scale<blockSize>(temp, dst);
+}
+// these two chain through a float on every step, so only the scaling is vectorized
+template <size_t blockSize> inline void noise_ds2(float &last, float *__restrict dst)
+{
+    int32_t temp alignas(32)[blockSize] = {};
+    temp[0] = super_simple_noise(last);
+    for (auto i = 1U; i < (blockSize >> 1); ++i)
+    {
+        const float noise = super_simple_noise(temp[2 * i - 2]);
+        temp[2 * i - 1] = noise;
+        temp[2 * i] = noise;
+    }
+    last = dst[blockSize - 1];
+    details::noise_scale<blockSize>(temp, dst);
+}
+template <size_t blockSize> inline void noise_ds4(float &last, float *__restrict dst)
+{
+    int32_t temp alignas(32)[blockSize] = {};
+    temp[0] = super_simple_noise(last);
+    for (auto i = 1U; i < (blockSize >> 2); ++i)
+    {
+        const float noise = super_simple_noise(temp[4 * i - 4]);
+        temp[4 * i - 3] = noise;
+        temp[4 * i - 2] = noise;
+        temp[4 * i - 1] = noise;
+        temp[4 * i] = noise;
+    }
+    last = temp[blockSize - 1];
+    details::noise_scale<blockSize>(temp, dst);
+}
+} // namespace simd
+
+#if SST_EFFECTS_BONSAI_SCALAR_HELPERS
+namespace blockmath = ::sst::effects::bonsai;
+#else
+namespace blockmath = simd;
+#endif
+
 template <typename FXConfig> struct Bonsai : core::EffectTemplateBase<FXConfig>
 {
     // static constexpr double MIDI_0_FREQ = 8.17579891564371;
@@ -983,18 +1817,18 @@ inline void high_shelf(float &last, float coef, float gainfactor, float *__restr
                        float *__restrict dst)
 {
     float highpass alignas(16)[blockSize] = {};
-    onepole_hp<blockSize>(last, coef, src, highpass);
-    mul_inplace<blockSize>(highpass, gainfactor);
-    sum2<blockSize>(highpass, src, dst);
+    blockmath::onepole_hp<blockSize>(last, coef, src, highpass);
+    blockmath::mul_inplace<blockSize>(highpass, gainfactor);
+    blockmath::sum2<blockSize>(highpass, src, dst);
 }
 template <size_t blockSize>
 inline void high_shelf(float &last, float coef, float *__restrict gainfactor, float *__restrict src,
                        float *__restrict dst)
 {
     float highpass alignas(16)[blockSize] = {};
-    onepole_hp<blockSize>(last, coef, src, highpass);
-    mul_inplace<blockSize>(highpass, gainfactor);
-    sum2<blockSize>(highpass, src, dst);
+    blockmath::onepole_hp<blockSize>(last, coef, src, highpass);
+    blockmath::mul_inplace<blockSize>(highpass, gainfactor);
+    blockmath::sum2<blockSize>(highpass, src, dst);
 }
 template <size_t blockSize>
 inline void low_shelf(float &last, float coef, float gainfactor, float *__restrict src,
@@ -1002,8 +1836,8 @@ inline void low_shelf(float &last, float coef, float gainfactor, float *__restri
 {
     float lowpass alignas(16)[blockSize] = {};
     onepole_lp<blockSize>(last, coef, src, lowpass);
-    mul_inplace<blockSize>(lowpass, gainfactor);
-    sum2<blockSize>(lowpass, src, dst);
+    blockmath::mul_inplace<blockSize>(lowpass, gainfactor);
+    blockmath::sum2<blockSize>(lowpass, src, dst);
 }
 template <size_t blockSize>
 inline void low_shelf(float &last, float coef, float *__restrict gainfactor, float *__restrict src,
@@ -1011,8 +1845,8 @@ inline void low_shelf(float &last, float coef, float *__restrict gainfactor, flo
 {
     float lowpass alignas(16)[blockSize] = {};
     onepole_lp<blockSize>(last, coef, src, lowpass);
-    mul_inplace<blockSize>(lowpass, gainfactor);
-    sum2<blockSize>(lowpass, src, dst);
+    blockmath::mul_inplace<blockSize>(lowpass, gainfactor);
+    blockmath::sum2<blockSize>(lowpass, src, dst);
 }
 
 template <size_t blockSize>
@@ -1020,20 +1854,20 @@ inline void high_shelf_nl(float &last, float coef, float gainfactor, float invle
                           float *__restrict src, float *__restrict dst)
 {
     float highpass alignas(16)[blockSize] = {};
-    onepole_hp<blockSize>(last, coef, src, highpass);
-    mul_inplace<blockSize>(highpass, gainfactor);
-    clip_inv_sinh<blockSize>(invlevel, level, highpass, highpass);
-    sum2<blockSize>(highpass, src, dst);
+    blockmath::onepole_hp<blockSize>(last, coef, src, highpass);
+    blockmath::mul_inplace<blockSize>(highpass, gainfactor);
+    blockmath::clip_inv_sinh<blockSize>(invlevel, level, highpass, highpass);
+    blockmath::sum2<blockSize>(highpass, src, dst);
 }
 template <size_t blockSize>
 inline void high_shelf_nl(float &last, float coef, float *__restrict gainfactor, float invlevel,
                           float level, float *__restrict src, float *__restrict dst)
 {
     float highpass alignas(16)[blockSize] = {};
-    onepole_hp<blockSize>(last, coef, src, highpass);
-    mul_inplace<blockSize>(highpass, gainfactor);
-    clip_inv_sinh<blockSize>(invlevel, level, highpass, highpass);
-    sum2<blockSize>(highpass, src, dst);
+    blockmath::onepole_hp<blockSize>(last, coef, src, highpass);
+    blockmath::mul_inplace<blockSize>(highpass, gainfactor);
+    blockmath::clip_inv_sinh<blockSize>(invlevel, level, highpass, highpass);
+    blockmath::sum2<blockSize>(highpass, src, dst);
 }
 template <size_t blockSize>
 inline void low_shelf_nl(float &last, float coef, float gainfactor, float invlevel, float level,
@@ -1041,9 +1875,9 @@ inline void low_shelf_nl(float &last, float coef, float gainfactor, float invlev
 {
     float lowpass alignas(16)[blockSize] = {};
     onepole_lp<blockSize>(last, coef, src, lowpass);
-    mul_inplace<blockSize>(lowpass, gainfactor);
-    clip_inv_sinh<blockSize>(invlevel, level, lowpass, lowpass);
-    sum2<blockSize>(lowpass, src, dst);
+    blockmath::mul_inplace<blockSize>(lowpass, gainfactor);
+    blockmath::clip_inv_sinh<blockSize>(invlevel, level, lowpass, lowpass);
+    blockmath::sum2<blockSize>(lowpass, src, dst);
 }
 template <size_t blockSize>
 inline void low_shelf_nl(float &last, float coef, float *__restrict gainfactor, float invlevel,
@@ -1051,9 +1885,9 @@ inline void low_shelf_nl(float &last, float coef, float *__restrict gainfactor,
 {
     float lowpass alignas(16)[blockSize] = {};
     onepole_lp<blockSize>(last, coef, src, lowpass);
-    mul_inplace<blockSize>(lowpass, gainfactor);
-    clip_inv_sinh<blockSize>(invlevel, level, lowpass, lowpass);
-    sum2<blockSize>(lowpass, src, dst);
+    blockmath::mul_inplace<blockSize>(lowpass, gainfactor);
+    blockmath::clip_inv_sinh<blockSize>(invlevel, level, lowpass, lowpass);
+    blockmath::sum2<blockSize>(lowpass, src, dst);
 }
 
 template <typename FXConfig>
@@ -1064,11 +1898,11 @@ inline void Bonsai<FXConfig>::tilt1_pre(float &last1, float &last2, float *__res
     float tilt1_lp1280 alignas(16)[FXConfig::blockSize] = {};
     const float amp_db13_5 = 4.7315127124153629629634297;   // 1.122018456459045 ^ 13.5
     const float amp_mdbm1_7 = -0.8222426472597752553172857; // -(1.122018456459045 ^ -1.7)
-    onepole_hp<FXConfig::blockSize>(last1, this->coef4690, src, tilt1_hp4690);
+    blockmath::onepole_hp<FXConfig::blockSize>(last1, this->coef4690, src, tilt1_hp4690);
     onepole_lp<FXConfig::blockSize>(last2, this->coef1280, src, tilt1_lp1280);
-    mul_inplace<FXConfig::blockSize>(tilt1_hp4690, amp_db13_5);
-    mul_inplace<FXConfig::blockSize>(tilt1_lp1280, amp_mdbm1_7);
-    sum3<FXConfig::blockSize>(tilt1_hp4690, tilt1_lp1280, src, dst);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt1_hp4690, amp_db13_5);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt1_lp1280, amp_mdbm1_7);
+    blockmath::sum3<FXConfig::blockSize>(tilt1_hp4690, tilt1_lp1280, src, dst);
 }
 template <typename FXConfig>
 inline void Bonsai<FXConfig>::tilt1_post(float &last1, float &last2, float *__restrict src,
@@ -1078,11 +1912,11 @@ inline void Bonsai<FXConfig>::tilt1_post(float &last1, float &last2, float *__re
     float tilt1_lp99 alignas(16)[FXConfig::blockSize] = {};
     const float amp_db13_5 = 4.7315127124153629629634297;   // 1.122018456459045 ^ 13.5
     const float amp_mdbm1_4 = -0.8511380359115372899247841; // -(1.122018456459045 ^ -1.4)
-    onepole_hp<FXConfig::blockSize>(last1, this->coef160, src, tilt1_hp160);
+    blockmath::onepole_hp<FXConfig::blockSize>(last1, this->coef160, src, tilt1_hp160);
     onepole_lp<FXConfig::blockSize>(last2, this->coef99, src, tilt1_lp99);
-    mul_inplace<FXConfig::blockSize>(tilt1_hp160, amp_mdbm1_4);
-    mul_inplace<FXConfig::blockSize>(tilt1_lp99, amp_db13_5);
-    sum3<FXConfig::blockSize>(tilt1_hp160, tilt1_lp99, src, dst);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt1_hp160, amp_mdbm1_4);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt1_lp99, amp_db13_5);
+    blockmath::sum3<FXConfig::blockSize>(tilt1_hp160, tilt1_lp99, src, dst);
 }
 template <typename FXConfig>
 inline void Bonsai<FXConfig>::tilt4_pre(float &last1, float &last2, float &last3, float &last4,
@@ -1093,19 +1927,19 @@ inline void Bonsai<FXConfig>::tilt4_pre(float &last1, float &last2, float &last3
     float tilt4_lp10 alignas(16)[FXConfig::blockSize] = {};
     float tilt4_lp3000 alignas(16)[FXConfig::blockSize] = {};
     float middle alignas(16)[FXConfig::blockSize] = {};
-    onepole_hp<FXConfig::blockSize>(last1, this->coef11000, src, tilt4_hp11000);
+    blockmath::onepole_hp<FXConfig::blockSize>(last1, this->coef11000, src, tilt4_hp11000);
     onepole_lp<FXConfig::blockSize>(last2, this->coef6000, src, tilt4_lp6000);
-    mul_inplace<FXConfig::blockSize>(tilt4_hp11000, 7.94328262212024352979393793341);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_hp11000, 7.94328262212024352979393793341);
     // 1.122018456459045 ^ 18
-    mul_inplace<FXConfig::blockSize>(tilt4_lp6000, -0.17782793587577652847030553);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_lp6000, -0.17782793587577652847030553);
     // -(1.122018456459045 ^ -15)
-    sum3<FXConfig::blockSize>(tilt4_hp11000, tilt4_lp6000, src, middle);
+    blockmath::sum3<FXConfig::blockSize>(tilt4_hp11000, tilt4_lp6000, src, middle);
     onepole_lp<FXConfig::blockSize>(last3, this->coef10, middle, tilt4_lp10);
     onepole_lp<FXConfig::blockSize>(last4, this->coef3000, middle, tilt4_lp3000);
-    mul_inplace<FXConfig::blockSize>(tilt4_lp3000, -0.707945780301058559381685957);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_lp3000, -0.707945780301058559381685957);
     // -(1.122018456459045 ^ -3)
-    sum3<FXConfig::blockSize>(tilt4_lp10, tilt4_lp3000, middle, dst);
-    mul_inplace<FXConfig::blockSize>(dst, 1.41253755276956870805933956974);
+    blockmath::sum3<FXConfig::blockSize>(tilt4_lp10, tilt4_lp3000, middle, dst);
+    blockmath::mul_inplace<FXConfig::blockSize>(dst, 1.41253755276956870805933956974);
     // -(1.122018456459045 ^ 3)
 }
 template <typename FXConfig>
@@ -1117,21 +1951,21 @@ inline void Bonsai<FXConfig>::tilt4_post(float &last1, float &last2, float &last
     float tilt4_lp70 alignas(16)[FXConfig::blockSize] = {};
     float tilt4_lp900 alignas(16)[FXConfig::blockSize] = {};
     float middle alignas(16)[FXConfig::blockSize] = {};
-    onepole_hp<FXConfig::blockSize>(last1, this->coef1300, src, tilt4_hp1300);
+    blockmath::onepole_hp<FXConfig::blockSize>(last1, this->coef1300, src, tilt4_hp1300);
     onepole_lp<FXConfig::blockSize>(last2, this->coef700, src, tilt4_lp700);
-    mul_inplace<FXConfig::blockSize>(tilt4_hp1300, -0.91727593406718168170484262);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_hp1300, -0.91727593406718168170484262);
     // -(1.122018456459045 ^ -0.75)
-    mul_inplace<FXConfig::blockSize>(tilt4_lp700, 0.251188637356033168493284101146);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_lp700, 0.251188637356033168493284101146);
     // 1.122018456459045 ^ 18
-    sum3<FXConfig::blockSize>(tilt4_hp1300, tilt4_lp700, src, middle);
+    blockmath::sum3<FXConfig::blockSize>(tilt4_hp1300, tilt4_lp700, src, middle);
     onepole_lp<FXConfig::blockSize>(last3, this->coef70, middle, tilt4_lp70);
     onepole_lp<FXConfig::blockSize>(last4, this->coef900, middle, tilt4_lp900);
-    mul_inplace<FXConfig::blockSize>(tilt4_lp70, -3.1622777209631984827047496111);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_lp70, -3.1622777209631984827047496111);
     // -(1.122018456459045 ^ 10)
-    mul_inplace<FXConfig::blockSize>(tilt4_lp900, 2.818382980029549413790645436973);
+    blockmath::mul_inplace<FXConfig::blockSize>(tilt4_lp900, 2.818382980029549413790645436973);
     // -(1.122018456459045 ^ 9)
-    sum3<FXConfig::blockSize>(tilt4_lp70, tilt4_lp900, middle, dst);
-    mul_inplace<FXConfig::blockSize>(dst, 0.707945780301058559381685957);
+    blockmath::sum3<FXConfig::blockSize>(tilt4_lp70, tilt4_lp900, middle, dst);
+    blockmath::mul_inplace<FXConfig::blockSize>(dst, 0.707945780301058559381685957);
     // -(1.122018456459045 ^ -3)
 }
 
@@ -1142,18 +1976,18 @@ inline void shelf_gain(float &last, float coef, float *__restrict pre,
 {
     float bufA alignas(16)[blockSize] = {};
     float bufB alignas(16)[blockSize] = {};
-    mul<blockSize>(pre, postdistgain, bufA);
-    mul<blockSize>(bufA, 6.f);
-    blockabs<blockSize>(bufA);
-    mul<blockSize>(post, 6.f, bufB);
-    blockabs<blockSize>(bufB);
-    minus2<blockSize>(bufB, bufA);
+    blockmath::mul<blockSize>(pre, postdistgain, bufA);
+    blockmath::mul<blockSize>(bufA, 6.f);
+    blockmath::blockabs<blockSize>(bufA);
+    blockmath::mul<blockSize>(post, 6.f, bufB);
+    blockmath::blockabs<blockSize>(bufB);
+    blockmath::minus2<blockSize>(bufB, bufA);
     onepole_lp<blockSize>(last, coef, bufB, bufA);
-    blockabs<blockSize>(bufA);
-    sum2<blockSize>(bufA, 1.f);
-    // div<blockSize>(1.f, bufA, bufA);
-    // mul<blockSize>(bufA, bufA, dstsq);
-    // mul<blockSize>(dstsq, bufA, dstcb);
+    blockmath::blockabs<blockSize>(bufA);
+    blockmath::sum2<blockSize>(bufA, 1.f);
+    // blockmath::div<blockSize>(1.f, bufA, bufA);
+    // blockmath::mul<blockSize>(bufA, bufA, dstsq);
+    // blockmath::mul<blockSize>(dstsq, bufA, dstcb);
     for (int i = 0; i < blockSize; ++i)
     {
         bufA[i] = 1.0 / bufA[i];
@@ -1204,8 +2038,8 @@ inline void Bonsai<FXConfig>::tape_sat(float last[], int lastmin, float sat, int
     // tilt1_post(last[lastmin + 12], last[lastmin + 13], srcR, dstR);
     // return;
 
-    mul<FXConfig::blockSize>(srcL, pregain, srcScaledL);
-    mul<FXConfig::blockSize>(srcR, pregain, srcScaledR);
+    blockmath::mul<FXConfig::blockSize>(srcL, pregain, srcScaledL);
+    blockmath::mul<FXConfig::blockSize>(srcR, pregain, srcScaledR);
 
     if (bias_filter == 1)
     {
@@ -1223,24 +2057,24 @@ inline void Bonsai<FXConfig>::tape_sat(float last[], int lastmin, float sat, int
     switch ((b_dist_modes)mode)
     {
     case bdm_inv_sinh:
-        clip_inv_sinh<FXConfig::blockSize>(level, bufA, bufA);
-        clip_inv_sinh<FXConfig::blockSize>(level, bufB, bufB);
+        blockmath::clip_inv_sinh<FXConfig::blockSize>(level, bufA, bufA);
+        blockmath::clip_inv_sinh<FXConfig::blockSize>(level, bufB, bufB);
         break;
     case bdm_tanh:
-        clip_tanh78<FXConfig::blockSize>(level, bufA, bufA);
-        clip_tanh78<FXConfig::blockSize>(level, bufB, bufB);
+        blockmath::clip_tanh78<FXConfig::blockSize>(level, bufA, bufA);
+        blockmath::clip_tanh78<FXConfig::blockSize>(level, bufB, bufB);
         break;
     case bdm_tanh_approx_foldback:
-        clip_tanh_foldback<FXConfig::blockSize>(level, bufA, bufA);
-        clip_tanh_foldback<FXConfig::blockSize>(level, bufB, bufB);
+        blockmath::clip_tanh_foldback<FXConfig::blockSize>(level, bufA, bufA);
+        blockmath::clip_tanh_foldback<FXConfig::blockSize>(level, bufB, bufB);
         break;
     case bdm_sine:
-        clip_sine_tanh<FXConfig::blockSize>(level, bufA, bufA);
-        clip_sine_tanh<FXConfig::blockSize>(level, bufB, bufB);
+        blockmath::clip_sine_tanh<FXConfig::blockSize>(level, bufA, bufA);
+        blockmath::clip_sine_tanh<FXConfig::blockSize>(level, bufB, bufB);
         break;
     default:
-        clip_tanh78<FXConfig::blockSize>(level, bufA, bufA);
-        clip_tanh78<FXConfig::blockSize>(level, bufB, bufB);
+        blockmath::clip_tanh78<FXConfig::blockSize>(level, bufA, bufA);
+        blockmath::clip_tanh78<FXConfig::blockSize>(level, bufB, bufB);
         break;
     }
     if (bias_filter == 1)
@@ -1256,16 +2090,16 @@ inline void Bonsai<FXConfig>::tape_sat(float last[], int lastmin, float sat, int
         tilt1_post(last[lastmin + 16], last[lastmin + 17], bufA, bufB); // L
     }
     // tilt1_post(last[lastmin + 12], last[lastmin + 13], bufA, bufB);
-    mul<FXConfig::blockSize>(bufB, sat_halfsq_db);
-    clip_inv_sinh<FXConfig::blockSize>(10, 0.1, bufB, bufB); // 1/0.15
+    blockmath::mul<FXConfig::blockSize>(bufB, sat_halfsq_db);
+    blockmath::clip_inv_sinh<FXConfig::blockSize>(10, 0.1, bufB, bufB); // 1/0.15
     shelf_gain<FXConfig::blockSize>(last[lastmin + 20], this->coef20, srcScaledL, sat_halfsq_db,
                                     bufB, shelfGain2, shelfGain3);
     high_shelf<FXConfig::blockSize>(last[lastmin + 21], this->coef4000, shelfGain2, bufB, bufA);
     high_shelf<FXConfig::blockSize>(last[lastmin + 22], this->coef8000, shelfGain3, bufA, dstL);
 
     // tilt1_post(last[lastmin + 16], last[lastmin + 17], bufC, bufB);
-    mul<FXConfig::blockSize>(bufC, sat_halfsq_db);
-    clip_inv_sinh<FXConfig::blockSize>(10, 0.1, bufC, bufC); // 1/0.15
+    blockmath::mul<FXConfig::blockSize>(bufC, sat_halfsq_db);
+    blockmath::clip_inv_sinh<FXConfig::blockSize>(10, 0.1, bufC, bufC); // 1/0.15
     shelf_gain<FXConfig::blockSize>(last[lastmin + 23], this->coef20, srcScaledR, sat_halfsq_db,
                                     bufC, shelfGain2, shelfGain3);
     high_shelf<FXConfig::blockSize>(last[lastmin + 24], this->coef4000, shelfGain2, bufC, bufB);
@@ -1314,86 +2148,87 @@ inline void Bonsai<FXConfig>::bass_boost(float last[], int lastmin, float boost,
     switch (this->deformType(b_bass_boost))
     {
     case 1:
-        sum2<FXConfig::blockSize>(srcL, srcR, bufC);
-        mul<FXConfig::blockSize>(bufC, 0.5);
+        blockmath::sum2<FXConfig::blockSize>(srcL, srcR, bufC);
+        blockmath::mul<FXConfig::blockSize>(bufC, 0.5);
         break;
     case 0:
     default:
-        sum2<FXConfig::blockSize>(bufC, srcL);
+        blockmath::sum2<FXConfig::blockSize>(bufC, srcL);
         break;
     }
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 7], this->coef20, bufC, bufA);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 7], this->coef20, bufC, bufA);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 8], this->coef50, bufA, bufB);
-    clip_tanh78<FXConfig::blockSize>(lerp1_block, bufB, bufB);
+    blockmath::clip_tanh78<FXConfig::blockSize>(lerp1_block, bufB, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 9], this->coef50, bufB, bufA);
-    mul<FXConfig::blockSize>(bufA, 20.f, branch1);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 10], this->coef30, bufC, bufA);
+    blockmath::mul<FXConfig::blockSize>(bufA, 20.f, branch1);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 10], this->coef30, bufC, bufA);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 11], this->coef200, bufA, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 12], this->coef200, bufB, reused);
-    mul<FXConfig::blockSize>(reused, 5.f, branch2);
-    mul<FXConfig::blockSize>(reused, lerp2_block, bufA);
-    clampbi<FXConfig::blockSize>(0.01, reused, bufA);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 13], this->coef200, bufA, branch3);
-    mul<FXConfig::blockSize>(branch3, lerp3_block);
-    mul<FXConfig::blockSize>(reused, lerp4_block, bufB);
-    clip_tanh78<FXConfig::blockSize>(lerp5_block, bufB, bufB);
+    blockmath::mul<FXConfig::blockSize>(reused, 5.f, branch2);
+    blockmath::mul<FXConfig::blockSize>(reused, lerp2_block, bufA);
+    blockmath::clampbi<FXConfig::blockSize>(0.01, reused, bufA);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 13], this->coef200, bufA, branch3);
+    blockmath::mul<FXConfig::blockSize>(branch3, lerp3_block);
+    blockmath::mul<FXConfig::blockSize>(reused, lerp4_block, bufB);
+    blockmath::clip_tanh78<FXConfig::blockSize>(lerp5_block, bufB, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 14], this->coef200, bufB, bufA);
-    mul<FXConfig::blockSize>(bufA, 2.f);
-    sum2<FXConfig::blockSize>(branch3, bufA, bufB);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 15], this->coef30, bufB, bufA);
-    sum3<FXConfig::blockSize>(branch1, branch2, bufA, bufB);
-    mul<FXConfig::blockSize>(bufB, 0.16666666666666666666666);
+    blockmath::mul<FXConfig::blockSize>(bufA, 2.f);
+    blockmath::sum2<FXConfig::blockSize>(branch3, bufA, bufB);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 15], this->coef30, bufB, bufA);
+    blockmath::sum3<FXConfig::blockSize>(branch1, branch2, bufA, bufB);
+    blockmath::mul<FXConfig::blockSize>(bufB, 0.16666666666666666666666);
     // change the above constant to adjust the default gain, so the
     // slider is negative less often previous value:
     // 0.3333333333333333333333333
     onepole_lp<FXConfig::blockSize>(last[lastmin + 16], this->coef500, bufB, bufA);
-    mul<FXConfig::blockSize>(bufA, boost_block);
-    clip_inv_sinh<FXConfig::blockSize>(lerp6_block, bufA, bufA);
-    // mul<FXConfig::blockSize>(bufA, rerange01(dist01, 1.25,
+    blockmath::mul<FXConfig::blockSize>(bufA, boost_block);
+    blockmath::clip_inv_sinh<FXConfig::blockSize>(lerp6_block, bufA, bufA);
+    // blockmath::mul<FXConfig::blockSize>(bufA, rerange01(dist01, 1.25,
     // 0.75), bufA);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 17], this->coef500, bufA, dstL);
 
     switch (this->deformType(b_bass_boost))
     {
     case 1:
-        sum2<FXConfig::blockSize>(dstR, srcR);
-        sum2<FXConfig::blockSize>(dstL, srcL);
+        blockmath::sum2<FXConfig::blockSize>(dstR, srcR);
+        blockmath::sum2<FXConfig::blockSize>(dstL, srcL);
         break;
     case 0:
     default:
-        sum2<FXConfig::blockSize>(dstL, srcL);
+        blockmath::sum2<FXConfig::blockSize>(dstL, srcL);
 
-        onepole_hp<FXConfig::blockSize>(last[lastmin + 18], this->coef20, srcR, bufA);
+        blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 18], this->coef20, srcR, bufA);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 19], this->coef50, bufA, bufB);
-        clip_tanh78<FXConfig::blockSize>(lerp1_block, bufB, bufB);
+        blockmath::clip_tanh78<FXConfig::blockSize>(lerp1_block, bufB, bufB);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 20], this->coef50, bufB, bufA);
-        mul<FXConfig::blockSize>(bufA, 20.f, branch1);
-        onepole_hp<FXConfig::blockSize>(last[lastmin + 21], this->coef30, srcR, bufA);
+        blockmath::mul<FXConfig::blockSize>(bufA, 20.f, branch1);
+        blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 21], this->coef30, srcR, bufA);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 22], this->coef200, bufA, bufB);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 23], this->coef200, bufB, reused);
-        mul<FXConfig::blockSize>(reused, 5.f, branch2);
-        mul<FXConfig::blockSize>(reused, lerp2_block, bufA);
-        clampbi<FXConfig::blockSize>(0.01, reused, bufA);
-        onepole_hp<FXConfig::blockSize>(last[lastmin + 24], this->coef200, bufA, branch3);
-        mul<FXConfig::blockSize>(branch3, lerp3_block);
-        mul<FXConfig::blockSize>(reused, lerp4_block, bufB);
-        clip_tanh78<FXConfig::blockSize>(lerp5_block, bufB, bufB);
+        blockmath::mul<FXConfig::blockSize>(reused, 5.f, branch2);
+        blockmath::mul<FXConfig::blockSize>(reused, lerp2_block, bufA);
+        blockmath::clampbi<FXConfig::blockSize>(0.01, reused, bufA);
+        blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 24], this->coef200, bufA,
+                                                   branch3);
+        blockmath::mul<FXConfig::blockSize>(branch3, lerp3_block);
+        blockmath::mul<FXConfig::blockSize>(reused, lerp4_block, bufB);
+        blockmath::clip_tanh78<FXConfig::blockSize>(lerp5_block, bufB, bufB);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 25], this->coef200, bufB, bufA);
-        mul<FXConfig::blockSize>(bufA, 2.f);
-        sum2<FXConfig::blockSize>(branch3, bufA, bufB);
-        onepole_hp<FXConfig::blockSize>(last[lastmin + 26], this->coef30, bufB, bufA);
-        sum3<FXConfig::blockSize>(branch1, branch2, bufA, bufB);
-        mul<FXConfig::blockSize>(bufB, 0.16666666666666666666666);
+        blockmath::mul<FXConfig::blockSize>(bufA, 2.f);
+        blockmath::sum2<FXConfig::blockSize>(branch3, bufA, bufB);
+        blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 26], this->coef30, bufB, bufA);
+        blockmath::sum3<FXConfig::blockSize>(branch1, branch2, bufA, bufB);
+        blockmath::mul<FXConfig::blockSize>(bufB, 0.16666666666666666666666);
         // change the above constant to adjust the default gain, so the
         // slider is negative less often previous value:
         // 0.3333333333333333333333333
         onepole_lp<FXConfig::blockSize>(last[lastmin + 27], this->coef500, bufB, bufA);
-        mul<FXConfig::blockSize>(bufA, boost_block);
-        clip_inv_sinh<FXConfig::blockSize>(lerp6_block, bufA, bufA);
-        // mul<FXConfig::blockSize>(bufA, rerange01(dist01, 1.25,
+        blockmath::mul<FXConfig::blockSize>(bufA, boost_block);
+        blockmath::clip_inv_sinh<FXConfig::blockSize>(lerp6_block, bufA, bufA);
+        // blockmath::mul<FXConfig::blockSize>(bufA, rerange01(dist01, 1.25,
         // 0.75), bufA);
         onepole_lp<FXConfig::blockSize>(last[lastmin + 28], this->coef500, bufA, dstR);
-        sum2<FXConfig::blockSize>(dstR, srcR);
+        blockmath::sum2<FXConfig::blockSize>(dstR, srcR);
         break;
     }
 }
@@ -1411,28 +2246,28 @@ Bonsai<FXConfig>::noise_channel(float last[], int lastmin, float *__restrict sen
     float bufC alignas(16)[FXConfig::blockSize] = {};
     float noise_filt alignas(16)[FXConfig::blockSize] = {};
 
-    clampbi<FXConfig::blockSize>(1.f, noise, bufA);
+    blockmath::clampbi<FXConfig::blockSize>(1.f, noise, bufA);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 0], this->coef1000, bufA, noise_filt);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 1], this->coef50, bufA, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 2], this->coef50, bufB, bufC);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 3], this->coef50, src, bufA);
-    sum3<FXConfig::blockSize>(src, bufA, bufC, bufB);
+    blockmath::sum3<FXConfig::blockSize>(src, bufA, bufC, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 4], this->coef1000, bufB, bufA);
     unit_delay<FXConfig::blockSize>(last[lastmin + 5], bufA, bufC);
-    minus2<FXConfig::blockSize>(bufA, bufC, bufB);
-    mul<FXConfig::blockSize>(bufB, sr_scaled, bufC);
-    blockabs<FXConfig::blockSize>(bufC, bufB);
-    minus2<FXConfig::blockSize>(bufB, threshold);
-    max<FXConfig::blockSize>(bufB, 0.f);
-    // mul<FXConfig::blockSize>(bufB, bufB, bufB);
+    blockmath::minus2<FXConfig::blockSize>(bufA, bufC, bufB);
+    blockmath::mul<FXConfig::blockSize>(bufB, sr_scaled, bufC);
+    blockmath::blockabs<FXConfig::blockSize>(bufC, bufB);
+    blockmath::minus2<FXConfig::blockSize>(bufB, threshold);
+    blockmath::max<FXConfig::blockSize>(bufB, 0.f);
+    // blockmath::mul<FXConfig::blockSize>(bufB, bufB, bufB);
     for (int i = 0; i < FXConfig::blockSize; ++i)
     {
         bufB[i] = bufB[i] * bufB[i];
     }
-    mul<FXConfig::blockSize>(bufB, sens_lp_scale);
+    blockmath::mul<FXConfig::blockSize>(bufB, sens_lp_scale);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 6], sens_lp_coef, bufB, bufA);
-    mul<FXConfig::blockSize>(bufA, noise_filt, bufB);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 7], this->coef500, bufB, dst);
+    blockmath::mul<FXConfig::blockSize>(bufA, noise_filt, bufB);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 7], this->coef500, bufB, dst);
 }
 // 24 last slots, set first two to set noise seeds
 template <typename FXConfig>
@@ -1446,11 +2281,11 @@ inline void Bonsai<FXConfig>::tape_noise(float last[], int lastmin, const float
     float noiseL alignas(16)[FXConfig::blockSize] = {};
     float noiseR alignas(16)[FXConfig::blockSize] = {};
 
-    noise<FXConfig::blockSize>(last[lastmin + 0], bufA);
-    noise<FXConfig::blockSize>(last[lastmin + 1], bufB);
-    mul<FXConfig::blockSize>(bufB, 0.5);
-    sum2<FXConfig::blockSize>(bufA, bufB, noiseL);
-    minus2<FXConfig::blockSize>(bufA, bufB, noiseR);
+    blockmath::noise<FXConfig::blockSize>(last[lastmin + 0], bufA);
+    blockmath::noise<FXConfig::blockSize>(last[lastmin + 1], bufB);
+    blockmath::mul<FXConfig::blockSize>(bufB, 0.5);
+    blockmath::sum2<FXConfig::blockSize>(bufA, bufB, noiseL);
+    blockmath::minus2<FXConfig::blockSize>(bufA, bufB, noiseR);
 
     float gain_adj alignas(16)[FXConfig::blockSize] = {};
     onepole_lp<FXConfig::blockSize>(last[lastmin + 2], this->coef20, gain * 0.25, gain_adj);
@@ -1468,17 +2303,17 @@ inline void Bonsai<FXConfig>::tape_noise(float last[], int lastmin, const float
 
     noise_channel(last, lastmin + 6, sens_lp_scale, sens_lp_coef, threshold, sr_scaled, srcL,
                   noiseL, bufA);
-    mul<FXConfig::blockSize>(bufA, gain_adj);
-    clip_tanh78<FXConfig::blockSize>(10, 0.1, bufA, bufA);
+    blockmath::mul<FXConfig::blockSize>(bufA, gain_adj);
+    blockmath::clip_tanh78<FXConfig::blockSize>(10, 0.1, bufA, bufA);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 14], this->coef2000, bufA, bufB);
-    sum2<FXConfig::blockSize>(srcL, bufB, dstL);
+    blockmath::sum2<FXConfig::blockSize>(srcL, bufB, dstL);
 
     noise_channel(last, lastmin + 15, sens_lp_scale, sens_lp_coef, threshold, sr_scaled, srcR,
                   noiseR, bufB);
-    mul<FXConfig::blockSize>(bufB, gain_adj);
-    clip_tanh78<FXConfig::blockSize>(10, 0.1, bufB, bufB);
+    blockmath::mul<FXConfig::blockSize>(bufB, gain_adj);
+    blockmath::clip_tanh78<FXConfig::blockSize>(10, 0.1, bufB, bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 23], this->coef2000, bufB, bufA);
-    sum2<FXConfig::blockSize>(srcR, bufA, dstR);
+    blockmath::sum2<FXConfig::blockSize>(srcR, bufA, dstR);
 }
 
 // 16 last slots
@@ -1496,7 +2331,7 @@ inline void Bonsai<FXConfig>::age(float last[], int lastmin, const float dull,
     onepole_lp<FXConfig::blockSize>(last[lastmin + 0], this->coef20,
                                     this->dbToLinear(rerange01(dull_isq, -36.f, 3.f)), gain);
     float gain_inv alignas(16)[FXConfig::blockSize] = {};
-    negate<FXConfig::blockSize>(gain, gain_inv);
+    blockmath::negate<FXConfig::blockSize>(gain, gain_inv);
     float coef_highcut alignas(16)[FXConfig::blockSize] = {};
     onepole_lp<FXConfig::blockSize>(
         last[lastmin + 1], this->coef20,
@@ -1518,8 +2353,8 @@ inline void Bonsai<FXConfig>::age(float last[], int lastmin, const float dull,
     low_shelf_nl<FXConfig::blockSize>(last[lastmin + 7], this->coef1200, gain, 25.f, 0.04, bufA,
                                       bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 8], coef_highcut, bufB, bufA);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 9], coef_lowcut, bufA, bufB);
-    clip_tanh78<FXConfig::blockSize>(cliplevel, bufB, dstL);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 9], coef_lowcut, bufA, bufB);
+    blockmath::clip_tanh78<FXConfig::blockSize>(cliplevel, bufB, dstL);
 
     high_shelf_nl<FXConfig::blockSize>(last[lastmin + 10], this->coef3000, gain_inv, 50.f, 0.02,
                                        srcR, bufA);
@@ -1530,13 +2365,14 @@ inline void Bonsai<FXConfig>::age(float last[], int lastmin, const float dull,
     low_shelf_nl<FXConfig::blockSize>(last[lastmin + 13], this->coef1200, gain, 25.f, 0.04, bufA,
                                       bufB);
     onepole_lp<FXConfig::blockSize>(last[lastmin + 14], coef_highcut, bufB, bufA);
-    onepole_hp<FXConfig::blockSize>(last[lastmin + 15], coef_lowcut, bufA, bufB);
-    clip_tanh78<FXConfig::blockSize>(cliplevel, bufB, dstR);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[lastmin + 15], coef_lowcut, bufA, bufB);
+    blockmath::clip_tanh78<FXConfig::blockSize>(cliplevel, bufB, dstR);
 }
 
 template <typename FXConfig>
 inline void Bonsai<FXConfig>::processBlock(float *__restrict dataL, float *__restrict dataR)
 {
+    auto profile = this->processProfileScope(streamingName);
     float gainIn alignas(16)[FXConfig::blockSize] = {};
     float gainOut alignas(16)[FXConfig::blockSize] = {};
     float mixVal alignas(16)[FXConfig::blockSize] = {};
@@ -1563,10 +2399,10 @@ inline void Bonsai<FXConfig>::processBlock(float *__restrict dataL, float *__res
     float outL alignas(16)[FXConfig::blockSize] = {};
     float outR alignas(16)[FXConfig::blockSize] = {};
 
-    mul<FXConfig::blockSize>(dataL, gainIn, scaledL);
-    mul<FXConfig::blockSize>(dataR, gainIn, scaledR);
-    onepole_hp<FXConfig::blockSize>(last[3], coef10, scaledL, hpL);
-    onepole_hp<FXConfig::blockSize>(last[4], coef10, scaledR, hpR);
+    blockmath::mul<FXConfig::blockSize>(dataL, gainIn, scaledL);
+    blockmath::mul<FXConfig::blockSize>(dataR, gainIn, scaledR);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[3], coef10, scaledL, hpL);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[4], coef10, scaledR, hpR);
 
     bass_boost(last, 5, this->dbToLinear(this->floatValueExtended(b_bass_boost)),
                this->floatValue(b_bass_distort) * 3.f, hpL, hpR, bassL, bassR);
@@ -1576,13 +2412,13 @@ inline void Bonsai<FXConfig>::processBlock(float *__restrict dataL, float *__res
     tape_noise(last, 60, this->floatValue(b_noise_sensitivity),
                this->dbToLinear(this->floatValue(b_noise_gain)), satL, satR, noiseL, noiseR);
     age(last, 84, this->floatValue(b_dull), noiseL, noiseR, agedL, agedR);
-    onepole_hp<FXConfig::blockSize>(last[100], coef10, agedL, outL);
-    onepole_hp<FXConfig::blockSize>(last[101], coef10, agedR, outR);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[100], coef10, agedL, outL);
+    blockmath::onepole_hp<FXConfig::blockSize>(last[101], coef10, agedR, outR);
 
-    mul<FXConfig::blockSize>(outL, gainOut);
-    mul<FXConfig::blockSize>(outR, gainOut);
-    lerp<FXConfig::blockSize>(dataL, outL, mixVal);
-    lerp<FXConfig::blockSize>(dataR, outR, mixVal);
+    blockmath::mul<FXConfig::blockSize>(outL, gainOut);
+    blockmath::mul<FXConfig::blockSize>(outR, gainOut);
+    blockmath::lerp<FXConfig::blockSize>(dataL, outL, mixVal);
+    blockmath::lerp<FXConfig::blockSize>(dataR, outR, mixVal);
 }
 
 } // namespace sst::effects::bonsai
@@ -36,6 +36,7 @@
 #include "sst/basic-blocks/mechanics/block-ops.h"
 
 #include "sst/basic-blocks/tables/SincTableProvider.h"
+#include "sst/effects-shared/SIMDKernels.h"
 
 namespace sst::effects::delay
 {
@@ -112,6 +113,18 @@ template <typename FXConfig> struct Delay : core::EffectTemplateBase<FXConfig>
     void initialize();
     void processBlock(float *__restrict L, float *__restrict R);
 
+    /*
+     * By default the line holds 2^18 samples whatever the sample rate, as it always
+     * has. Calling setMaxDelayTime before initialize() (or onSampleRateChanged())
+     * sizes it for that many seconds at the current sample rate instead, so instances
+     * which only need short times stay small; pass maxDelayTimeFromParams for the
+     * longest unsynced time the time parameters reach. Longer times are clamped to
+     * the line as before.
+     */
+    static constexpr float defaultDelayTime{0.f};
+    static constexpr float maxDelayTimeFromParams{-1.f};
+    void setMaxDelayTime(float seconds) { maxDelayTime = seconds; }
+
     basic_blocks::params::ParamMetaData paramAt(int idx) const
     {
         using pmd = basic_blocks::params::ParamMetaData;
@@ -195,13 +208,16 @@ template <typename FXConfig> struct Delay : core::EffectTemplateBase<FXConfig>
      */
     sst::basic_blocks::tables::SurgeSincTableProvider sincTable;
 
-    // TODO - we've wanted a sample rate adjustable max for a while.
-    // Still don't have it here.
-    static constexpr int max_delay_length{1 << 18};
+    static constexpr int default_delay_length{1 << 18};
     typename core::EffectTemplateBase<FXConfig>::lipol_ps_blocksz feedback, crossfeed, aligpan, pan,
         mix, widthS, widthM;
-    float buffer alignas(
-        16)[2][max_delay_length + sst::basic_blocks::tables::SurgeSincTableProvider::FIRipol_N];
+
+    // max_delay_length is a power of two, and each line has FIRipol_N samples of wrap
+    void allocateBuffer();
+    float maxDelayTime{defaultDelayTime};
+    int max_delay_length{0};
+    float *buffer[2]{nullptr, nullptr};
+    core::EffectMemoryBlock<FXConfig> bufferMemory{this};
 
     sst::basic_blocks::dsp::SurgeLag<float, true> timeL{0.0001}, timeR{0.0001};
     bool inithadtempo;
@@ -222,10 +238,35 @@ template <typename FXConfig> struct Delay : core::EffectTemplateBase<FXConfig>
     }
 };
 
+template <typename FXConfig> inline void Delay<FXConfig>::allocateBuffer()
+{
+    int len{default_delay_length};
+    if (maxDelayTime != defaultDelayTime)
+    {
+        auto seconds = maxDelayTime;
+        if (seconds == maxDelayTimeFromParams)
+        {
+            seconds = std::max(std::pow(2.f, paramAt(dly_time_left).maxVal),
+                               std::pow(2.f, paramAt(dly_time_right).maxVal));
+        }
+        auto samples = (int)std::ceil(seconds * this->sampleRate()) + sincTable.FIRipol_N +
+                       FXConfig::blockSize + 1;
+        len = FXConfig::blockSize;
+        while (len < samples)
+            len <<= 1;
+    }
+
+    max_delay_length = len;
+    auto lineSize = (size_t)(max_delay_length + sincTable.FIRipol_N);
+    if (!bufferMemory.resize(2 * lineSize * sizeof(float)))
+        bufferMemory.clear();
+    buffer[0] = bufferMemory.template as<float>();
+    buffer[1] = buffer[0] + lineSize;
+}
+
 template <typename FXConfig> inline void Delay<FXConfig>::initialize()
 {
-    memset(buffer[0], 0, (max_delay_length + this->sincTable.FIRipol_N) * sizeof(float));
-    memset(buffer[1], 0, (max_delay_length + this->sincTable.FIRipol_N) * sizeof(float));
+    allocateBuffer();
     wpos = 0;
     lfophase = 0.0;
     // ringout_time = 100000;
@@ -332,6 +373,10 @@ template <typename FXConfig> inline void Delay<FXConfig>::setvars(bool init)
 template <typename FXConfig> inline void Delay<FXConfig>::processBlock(float *dataL, float *dataR)
 
 {
+    auto profile = this->processProfileScope(streamingName);
+    // initialize() sizes the line; this only catches hosts which process first
+    if (!buffer[0])
+        initialize();
     setvars(false);
 
     int k;
@@ -339,6 +384,9 @@ template <typename FXConfig> inline void Delay<FXConfig>::processBlock(float *da
         wbL alignas(16)[FXConfig::blockSize]; // wb = write-buffer
     float tbufferR alignas(16)[FXConfig::blockSize], wbR alignas(16)[FXConfig::blockSize];
 
+    // gather the read positions and sinc phases, then interpolate the block in one go
+    int rpLs[FXConfig::blockSize], rpRs[FXConfig::blockSize];
+    int sincLs[FXConfig::blockSize], sincRs[FXConfig::blockSize];
     for (k = 0; k < FXConfig::blockSize; k++)
     {
         timeL.process();
@@ -361,26 +409,18 @@ template <typename FXConfig> inline void Delay<FXConfig>::processBlock(float *da
                     std::clamp((int)(sincTable.FIRipol_M * (float(i_dtimeR + 1) - timeR.v)), 0,
                                sincTable.FIRipol_M - 1);
 
-        SIMD_M128 L, R;
-        L = SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincL]),
-                            SIMD_MM(loadu_ps)(&buffer[0][rpL]));
-        L = SIMD_MM(add_ps)(L, SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincL + 4]),
-                                               SIMD_MM(loadu_ps)(&buffer[0][rpL + 4])));
-        L = SIMD_MM(add_ps)(L, SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincL + 8]),
-                                               SIMD_MM(loadu_ps)(&buffer[0][rpL + 8])));
-        L = sst::basic_blocks::mechanics::sum_ps_to_ss(L);
-        R = SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincR]),
-                            SIMD_MM(loadu_ps)(&buffer[1][rpR]));
-        R = SIMD_MM(add_ps)(R, SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincR + 4]),
-                                               SIMD_MM(loadu_ps)(&buffer[1][rpR + 4])));
-        R = SIMD_MM(add_ps)(R, SIMD_MM(mul_ps)(SIMD_MM(load_ps)(&sincTable.sinctable1X[sincR + 8]),
-                                               SIMD_MM(loadu_ps)(&buffer[1][rpR + 8])));
-        R = sst::basic_blocks::mechanics::sum_ps_to_ss(R);
-
-        SIMD_MM(store_ss)(&tbufferL[k], L);
-        SIMD_MM(store_ss)(&tbufferR[k], R);
+        rpLs[k] = rpL;
+        rpRs[k] = rpR;
+        sincLs[k] = sincL;
+        sincRs[k] = sincR;
     }
 
+    namespace kern = sst::effects_shared::kernels;
+    using sincRead =
+        kern::SincReadBlock2<sst::basic_blocks::tables::SurgeSincTableProvider::FIRipol_N>;
+    kern::dispatch<sincRead>(sincTable.sinctable1X, sincLs, sincRs, buffer[0], buffer[1], rpLs,
+                             rpRs, tbufferL, tbufferR, (int)FXConfig::blockSize);
+
     // negative feedback
     if (FBsign)
     {
@@ -451,10 +491,8 @@ template <typename FXConfig> inline void Delay<FXConfig>::processBlock(float *da
         }
     }
 
-    // scale width
-    this->applyWidth(tbufferL, tbufferR, widthS, widthM);
-
-    mix.fade_2_blocks_inplace(dataL, tbufferL, dataR, tbufferR, this->blockSize_quad);
+    // scale width and mix
+    this->applyWidthAndMix(dataL, dataR, tbufferL, tbufferR, widthS, widthM, mix);
 
     wpos += FXConfig::blockSize;
     wpos = wpos & (max_delay_length - 1);
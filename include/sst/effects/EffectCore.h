@@ -78,11 +78,15 @@
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/filters/BiquadFilter.h"
 #include "sst/effects-shared/WidthProvider.h"
+#include "sst/effects-shared/RingoutTracker.h"
 
 #include "EffectCoreDetails.h"
 
 #include <type_traits>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <new>
 
 static_assert(__cplusplus >= 202002L, "Surge team libraries have moved to C++ 20");
 
@@ -163,6 +167,9 @@ struct EffectTemplateBase
     static constexpr float blockSize_inv{1.f / FXConfig::blockSize};
     static constexpr float blockSize_quad{FXConfig::blockSize >> 2};
 
+    // Hosts can use this to skip processBlock once an effect has rung out
+    using RingoutTracker = effects_shared::RingoutTracker<FXConfig::blockSize>;
+
     using BiquadFilterType =
         sst::filters::Biquad::BiquadFilter<typename FXConfig::GlobalStorage, FXConfig::blockSize,
                                            typename FXConfig::BiquadAdapter>;
@@ -255,6 +262,59 @@ struct EffectTemplateBase
 
     inline float dbToLinear(float f) { return FXConfig::dbToLinear(globalStorage, f); }
 
+    /*
+     * An FXConfig may optionally provide static
+     *   void onProcessBegin(BaseClass *, const char *streamingName);
+     *   void onProcessEnd(BaseClass *, const char *streamingName);
+     * which effects call around each processBlock by opening this scope at the
+     * top of the block. Configurations without the hooks get an empty scope.
+     */
+    inline auto processProfileScope(const char *streamingName)
+    {
+        return details::ProcessProfileScopeFor<FXConfig, typename FXConfig::BaseClass>(
+            asBase(), streamingName);
+    }
+
+    /*
+     * Effects which size memory at runtime (from sample rate, say) get it here rather
+     * than carrying worst case arrays inline. An FXConfig may optionally provide static
+     *   void preReservePool(GlobalStorage *, size_t bytes);
+     *   uint8_t *checkoutBlock(GlobalStorage *, size_t bytes);
+     *   void returnBlock(GlobalStorage *, uint8_t *, size_t bytes);
+     * to hand out blocks from a pool so they are reused across instances. It must
+     * provide both checkoutBlock and returnBlock or neither; without them we use
+     * aligned operator new and delete.
+     */
+    static constexpr bool hasMemoryPool()
+    {
+        static_assert(details::Has_checkoutBlock<FXConfig>::value ==
+                          details::Has_returnBlock<FXConfig>::value,
+                      "FXConfig must provide both checkoutBlock and returnBlock or neither");
+        return details::Has_checkoutBlock<FXConfig>::value;
+    }
+
+    inline void preReservePool(size_t bytes)
+    {
+        if constexpr (details::Has_preReservePool<FXConfig>::value)
+            FXConfig::preReservePool(globalStorage, bytes);
+    }
+
+    inline uint8_t *checkoutBlock(size_t bytes)
+    {
+        if constexpr (hasMemoryPool())
+            return FXConfig::checkoutBlock(globalStorage, bytes);
+        else
+            return static_cast<uint8_t *>(::operator new(bytes, std::align_val_t{16}));
+    }
+
+    inline void returnBlock(uint8_t *d, size_t bytes)
+    {
+        if constexpr (hasMemoryPool())
+            FXConfig::returnBlock(globalStorage, d, bytes);
+        else
+            ::operator delete(d, std::align_val_t{16});
+    }
+
     static constexpr int slowrate{8}, slowrate_m1{slowrate - 1};
 
     static constexpr bool useLinearWidth()
@@ -278,6 +338,78 @@ struct EffectTemplateBase
         assert(streamedFrom == 1);
     }
 };
+
+/*
+ * Offline renderers with fixed parameters can hand an effect nBlocks * blockSize
+ * samples at once. An effect may provide
+ *   void processBlocks(float *L, float *R, int nBlocks);
+ * which reads its parameters once per call and keeps its loop state across the
+ * blocks; parameters are taken as constant for the span. Without one this is
+ * processBlock on each block in turn.
+ */
+template <typename FX>
+inline void processBlocks(FX *fx, float *__restrict L, float *__restrict R, int nBlocks)
+{
+    if constexpr (requires { fx->processBlocks(L, R, nBlocks); })
+    {
+        fx->processBlocks(L, R, nBlocks);
+    }
+    else
+    {
+        constexpr int bs{FX::FXConfig_t::blockSize};
+        for (int i = 0; i < nBlocks; ++i)
+            fx->processBlock(L + i * bs, R + i * bs);
+    }
+}
+
+/*
+ * A zeroed block of runtime sized memory owned by an effect, checked out with the
+ * effect's checkoutBlock and returned when it is resized or destroyed.
+ */
+template <typename FXConfig> struct EffectMemoryBlock
+{
+    EffectTemplateBase<FXConfig> *fx{nullptr};
+    uint8_t *data{nullptr};
+    size_t size{0};
+
+    explicit EffectMemoryBlock(EffectTemplateBase<FXConfig> *f) : fx(f) {}
+    ~EffectMemoryBlock() { release(); }
+
+    EffectMemoryBlock(const EffectMemoryBlock &) = delete;
+    EffectMemoryBlock &operator=(const EffectMemoryBlock &) = delete;
+
+    // Returns true if the block was (re)allocated, in which case it is zeroed
+    bool resize(size_t bytes)
+    {
+        if (data && bytes == size)
+            return false;
+        release();
+        fx->preReservePool(bytes);
+        data = fx->checkoutBlock(bytes);
+        size = bytes;
+        memset(data, 0, size);
+        return true;
+    }
+
+    void release()
+    {
+        if (data)
+            fx->returnBlock(data, size);
+        data = nullptr;
+        size = 0;
+    }
+
+    void clear()
+    {
+        if (data)
+            memset(data, 0, size);
+    }
+
+    template <typename T> T *as(size_t byteOffset = 0)
+    {
+        return reinterpret_cast<T *>(data + byteOffset);
+    }
+};
 } // namespace sst::effects::core
 
 #endif
\ No newline at end of file
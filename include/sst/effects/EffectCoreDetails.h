@@ -54,8 +54,49 @@ HAS_MEMBER(deformType);
 
 HAS_MEMBER(widthIsLinear);
 
+HAS_MEMBER(onProcessBegin);
+HAS_MEMBER(onProcessEnd);
+
+HAS_MEMBER(preReservePool);
+HAS_MEMBER(checkoutBlock);
+HAS_MEMBER(returnBlock);
+
 #undef HAS_MEMBER
 
+/*
+ * A scope which calls the optional FXConfig::onProcessBegin / onProcessEnd hooks
+ * around a process call. When the configuration has neither hook the specialization
+ * is an empty object with empty construction and destruction and compiles away.
+ */
+template <typename FXConfig, typename Base, bool hasHooks> struct ProcessProfileScope
+{
+    ProcessProfileScope(Base *, const char *) {}
+    ~ProcessProfileScope() {} // user provided so an unused scope doesn't warn
+};
+
+template <typename FXConfig, typename Base> struct ProcessProfileScope<FXConfig, Base, true>
+{
+    Base *base;
+    const char *name;
+    ProcessProfileScope(Base *b, const char *n) : base(b), name(n)
+    {
+        if constexpr (Has_onProcessBegin<FXConfig>::value)
+            FXConfig::onProcessBegin(base, name);
+    }
+    ~ProcessProfileScope()
+    {
+        if constexpr (Has_onProcessEnd<FXConfig>::value)
+            FXConfig::onProcessEnd(base, name);
+    }
+    ProcessProfileScope(const ProcessProfileScope &) = delete;
+    ProcessProfileScope &operator=(const ProcessProfileScope &) = delete;
+};
+
+template <typename FXConfig, typename Base>
+using ProcessProfileScopeFor =
+    ProcessProfileScope<FXConfig, Base,
+                        Has_onProcessBegin<FXConfig>::value || Has_onProcessEnd<FXConfig>::value>;
+
 } // namespace sst::effects::core::details
 
 #endif // SURGE_EFFECTCOREDETAILS_H
@@ -20,11 +20,13 @@
 #ifndef INCLUDE_SST_EFFECTS_FLANGER_H
 #define INCLUDE_SST_EFFECTS_FLANGER_H
 
+#include <algorithm>
 #include <cstring>
 #include "EffectCore.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/basic-blocks/dsp/Lag.h"
 #include "sst/basic-blocks/dsp/BlockInterpolators.h"
+#include "sst/effects-shared/SIMDDispatch.h"
 
 namespace sst::effects::flanger
 {
@@ -174,7 +176,6 @@ template <typename FXConfig> struct Flanger : core::EffectTemplateBase<FXConfig>
             memset(line, 0, DELAY_SIZE * sizeof(float));
             k = 0;
         }
-        float value(float delayBy);
         void push(float nv)
         {
             k = (k + 1) & DELAY_SIZE_MASK;
@@ -195,7 +196,39 @@ template <typename FXConfig> struct Flanger : core::EffectTemplateBase<FXConfig>
     sdsp::lipol<float, FXConfig::blockSize, true> feedback, fb_hf_damping;
     sdsp::SurgeLag<float> vzeropitch;
     float lfosandhtarget[2][COMBS_PER_CHANNEL];
-    float vweights[2][COMBS_PER_CHANNEL];
+    float vweights alignas(16)[2][COMBS_PER_CHANNEL];
+
+    /*
+     * The comb reads, dispatched at runtime. Each of the eight combs is a lane: the lfo,
+     * delay base and depth ramps, the tap, the interpolated read and the voice weighting
+     * all run together, four combs per channel in sse2 and both channels in one pass in
+     * avx2. The ramps are copied out of their lipols at the start of the block and the
+     * end values put back afterwards. No tap which is heard is shorter than a chunk, so
+     * the combs for a whole chunk are read before its samples are pushed.
+     */
+    struct CombArgs
+    {
+        float *lfo, *base, *depth;
+        const float *dlfo, *dbase, *weight;
+        float ddepth;
+        const float *lineL, *lineR;
+        int k;
+        float *combL, *combR;
+        int n;
+    };
+    struct CombKernel
+    {
+        using fn_t = void (*)(const CombArgs &);
+        static void sse2(const CombArgs &args);
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+        SST_EFFECTS_TARGET_AVX2 static void avx2(const CombArgs &args);
+#endif
+    };
+    float combLfo alignas(32)[2][COMBS_PER_CHANNEL],
+        combLfoStep alignas(32)[2][COMBS_PER_CHANNEL];
+    float combBase alignas(32)[2][COMBS_PER_CHANNEL],
+        combBaseStep alignas(32)[2][COMBS_PER_CHANNEL];
+    int combChunk(float depthStep) const;
 
     sdsp::lipol_sse<FXConfig::blockSize, false> widthS, widthM;
     bool haveProcessed{false};
@@ -234,22 +267,165 @@ template <typename FXConfig> inline void Flanger<FXConfig>::initialize()
     haveProcessed = false;
 }
 
-template <typename FXConfig> inline float Flanger<FXConfig>::InterpDelay::value(float delayBy)
+template <typename FXConfig> inline int Flanger<FXConfig>::combChunk(float depthStep) const
 {
-    // so if delayBy is 19.2
-    int itap = (int)std::min(delayBy, (float)(DELAY_SIZE - 2)); // this is 19
-    float fractap = delayBy - itap;                             // this is .2
-    int k0 = (k + DELAY_SIZE - itap - 1) & DELAY_SIZE_MASK;     // this is 20 back
-    int k1 = (k + DELAY_SIZE - itap) & DELAY_SIZE_MASK;         // this is 19 back
-    float result =
-        line[k0] * fractap + line[k1] * (1.0 - fractap); // FIXME move to the one mul form
-
-    return result;
+    // the shortest tap any heard comb can reach over the block, from the ends of the ramps
+    const float bs = FXConfig::blockSize;
+    const float d0 = depth.v, d1 = d0 + bs * depthStep;
+    int n = FXConfig::blockSize;
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < COMBS_PER_CHANNEL; ++i)
+        {
+            if (vweights[c][i] <= 0)
+                continue;
+            float l0 = combLfo[c][i], l1 = l0 + bs * combLfoStep[c][i];
+            float b0 = combBase[c][i], b1 = b0 + bs * combBaseStep[c][i];
+            float g = 1.f + std::min({l0 * d0, l0 * d1, l1 * d0, l1 * d1});
+            float tapMin = (g >= 0 ? std::min(b0, b1) : std::max(b0, b1)) * g + 1;
+            // and a sample of slack for the rounding of the ramps
+            n = std::min(n, std::max((int)std::max(tapMin, 0.f) - 1, 1));
+        }
+    return n;
+}
+
+template <typename FXConfig>
+inline void Flanger<FXConfig>::CombKernel::sse2(const typename Flanger<FXConfig>::CombArgs &args)
+{
+    static constexpr int mask = InterpDelay::DELAY_SIZE_MASK;
+    const auto one = SIMD_MM(set1_ps)(1.f);
+    const auto maxTap = SIMD_MM(set1_ps)((float)(InterpDelay::DELAY_SIZE - 2));
+    const auto mask4 = SIMD_MM(set1_epi32)(mask);
+    const auto one4 = SIMD_MM(set1_epi32)(1);
+
+    auto lfoL = SIMD_MM(load_ps)(args.lfo), lfoR = SIMD_MM(load_ps)(args.lfo + 4);
+    auto baseL = SIMD_MM(load_ps)(args.base), baseR = SIMD_MM(load_ps)(args.base + 4);
+    const auto dlfoL = SIMD_MM(load_ps)(args.dlfo), dlfoR = SIMD_MM(load_ps)(args.dlfo + 4);
+    const auto dbaseL = SIMD_MM(load_ps)(args.dbase), dbaseR = SIMD_MM(load_ps)(args.dbase + 4);
+    const auto wL = SIMD_MM(load_ps)(args.weight), wR = SIMD_MM(load_ps)(args.weight + 4);
+    auto depth = *args.depth;
+
+    int i0 alignas(16)[8], i1 alignas(16)[8];
+    for (int s = 0; s < args.n; ++s)
+    {
+        auto d4 = SIMD_MM(set1_ps)(depth);
+        auto k4 = SIMD_MM(set1_epi32)(args.k + s);
+
+        // tap = delaybase * (1 + lfo * depth) + 1, read as line[k0] * frac + line[k1] * (1 - frac)
+        auto tapL = SIMD_MM(add_ps)(
+            SIMD_MM(mul_ps)(baseL, SIMD_MM(add_ps)(one, SIMD_MM(mul_ps)(lfoL, d4))), one);
+        auto tapR = SIMD_MM(add_ps)(
+            SIMD_MM(mul_ps)(baseR, SIMD_MM(add_ps)(one, SIMD_MM(mul_ps)(lfoR, d4))), one);
+        auto itL = SIMD_MM(cvttps_epi32)(SIMD_MM(min_ps)(tapL, maxTap));
+        auto itR = SIMD_MM(cvttps_epi32)(SIMD_MM(min_ps)(tapR, maxTap));
+        auto fL = SIMD_MM(sub_ps)(tapL, SIMD_MM(cvtepi32_ps)(itL));
+        auto fR = SIMD_MM(sub_ps)(tapR, SIMD_MM(cvtepi32_ps)(itR));
+
+        auto k1L = SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(k4, itL), mask4);
+        auto k1R = SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(k4, itR), mask4);
+        SIMD_MM(store_si128)((SIMD_M128I *)i1, k1L);
+        SIMD_MM(store_si128)((SIMD_M128I *)(i1 + 4), k1R);
+        SIMD_MM(store_si128)((SIMD_M128I *)i0,
+                             SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(k1L, one4), mask4));
+        SIMD_MM(store_si128)((SIMD_M128I *)(i0 + 4),
+                             SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(k1R, one4), mask4));
+
+        const auto *lL = args.lineL, *lR = args.lineR;
+        auto l0L = SIMD_MM(setr_ps)(lL[i0[0]], lL[i0[1]], lL[i0[2]], lL[i0[3]]);
+        auto l1L = SIMD_MM(setr_ps)(lL[i1[0]], lL[i1[1]], lL[i1[2]], lL[i1[3]]);
+        auto l0R = SIMD_MM(setr_ps)(lR[i0[4]], lR[i0[5]], lR[i0[6]], lR[i0[7]]);
+        auto l1R = SIMD_MM(setr_ps)(lR[i1[4]], lR[i1[5]], lR[i1[6]], lR[i1[7]]);
+        auto vL = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(l0L, fL),
+                                  SIMD_MM(mul_ps)(l1L, SIMD_MM(sub_ps)(one, fL)));
+        auto vR = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(l0R, fR),
+                                  SIMD_MM(mul_ps)(l1R, SIMD_MM(sub_ps)(one, fR)));
+        auto pL = SIMD_MM(mul_ps)(wL, vL), pR = SIMD_MM(mul_ps)(wR, vR);
+
+        // ((0 + p0) + p1) + p2) + p3 per channel, with L and R side by side
+        auto lo = SIMD_MM(unpacklo_ps)(pL, pR), hi = SIMD_MM(unpackhi_ps)(pL, pR);
+        auto sum = SIMD_MM(add_ps)(SIMD_MM(setzero_ps)(), lo);
+        sum = SIMD_MM(add_ps)(sum, SIMD_MM(movehl_ps)(lo, lo));
+        sum = SIMD_MM(add_ps)(sum, hi);
+        sum = SIMD_MM(add_ps)(sum, SIMD_MM(movehl_ps)(hi, hi));
+        SIMD_MM(store_ss)(&args.combL[s], sum);
+        SIMD_MM(store_ss)(&args.combR[s],
+                          SIMD_MM(shuffle_ps)(sum, sum, SIMD_MM_SHUFFLE(1, 1, 1, 1)));
+
+        lfoL = SIMD_MM(add_ps)(lfoL, dlfoL);
+        lfoR = SIMD_MM(add_ps)(lfoR, dlfoR);
+        baseL = SIMD_MM(add_ps)(baseL, dbaseL);
+        baseR = SIMD_MM(add_ps)(baseR, dbaseR);
+        depth += args.ddepth;
+    }
+
+    SIMD_MM(store_ps)(args.lfo, lfoL);
+    SIMD_MM(store_ps)(args.lfo + 4, lfoR);
+    SIMD_MM(store_ps)(args.base, baseL);
+    SIMD_MM(store_ps)(args.base + 4, baseR);
+    *args.depth = depth;
 }
 
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+template <typename FXConfig>
+SST_EFFECTS_TARGET_AVX2 inline void
+Flanger<FXConfig>::CombKernel::avx2(const typename Flanger<FXConfig>::CombArgs &args)
+{
+    static constexpr int mask = InterpDelay::DELAY_SIZE_MASK;
+    const auto one = _mm256_set1_ps(1.f);
+    const auto maxTap = _mm256_set1_ps((float)(InterpDelay::DELAY_SIZE - 2));
+    const auto mask8 = _mm256_set1_epi32(mask);
+    const auto one8 = _mm256_set1_epi32(1);
+
+    // lanes 0-3 are the left combs, 4-7 the right ones
+    auto lfo = _mm256_loadu_ps(args.lfo), base = _mm256_loadu_ps(args.base);
+    const auto dlfo = _mm256_loadu_ps(args.dlfo), dbase = _mm256_loadu_ps(args.dbase);
+    const auto w = _mm256_loadu_ps(args.weight);
+    auto depth = *args.depth;
+
+    for (int s = 0; s < args.n; ++s)
+    {
+        auto d8 = _mm256_set1_ps(depth);
+        auto k8 = _mm256_set1_epi32(args.k + s);
+
+        auto tap =
+            _mm256_add_ps(_mm256_mul_ps(base, _mm256_add_ps(one, _mm256_mul_ps(lfo, d8))), one);
+        auto it = _mm256_cvttps_epi32(_mm256_min_ps(tap, maxTap));
+        auto f = _mm256_sub_ps(tap, _mm256_cvtepi32_ps(it));
+
+        auto k1 = _mm256_and_si256(_mm256_sub_epi32(k8, it), mask8);
+        auto k0 = _mm256_and_si256(_mm256_sub_epi32(k1, one8), mask8);
+        auto l0 = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_i32gather_ps(args.lineL, _mm256_castsi256_si128(k0), 4)),
+            _mm_i32gather_ps(args.lineR, _mm256_extracti128_si256(k0, 1), 4), 1);
+        auto l1 = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_i32gather_ps(args.lineL, _mm256_castsi256_si128(k1), 4)),
+            _mm_i32gather_ps(args.lineR, _mm256_extracti128_si256(k1, 1), 4), 1);
+        auto p = _mm256_mul_ps(
+            w, _mm256_add_ps(_mm256_mul_ps(l0, f), _mm256_mul_ps(l1, _mm256_sub_ps(one, f))));
+
+        auto pL = _mm256_castps256_ps128(p), pR = _mm256_extractf128_ps(p, 1);
+        auto lo = _mm_unpacklo_ps(pL, pR), hi = _mm_unpackhi_ps(pL, pR);
+        auto sum = _mm_add_ps(_mm_setzero_ps(), lo);
+        sum = _mm_add_ps(sum, _mm_movehl_ps(lo, lo));
+        sum = _mm_add_ps(sum, hi);
+        sum = _mm_add_ps(sum, _mm_movehl_ps(hi, hi));
+        _mm_store_ss(&args.combL[s], sum);
+        _mm_store_ss(&args.combR[s], _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        lfo = _mm256_add_ps(lfo, dlfo);
+        base = _mm256_add_ps(base, dbase);
+        depth += args.ddepth;
+    }
+
+    _mm256_storeu_ps(args.lfo, lfo);
+    _mm256_storeu_ps(args.base, base);
+    *args.depth = depth;
+}
+#endif
+
 template <typename FXConfig>
 inline void Flanger<FXConfig>::processBlock(float *__restrict dataL, float *__restrict dataR)
 {
+    auto profile = this->processProfileScope(streamingName);
     if (!haveProcessed)
     {
         float v0 = this->floatValue(fl_voice_basepitch);
@@ -513,95 +689,106 @@ inline void Flanger<FXConfig>::processBlock(float *__restrict dataL, float *__re
         }
     }
 
-    for (int b = 0; b < FXConfig::blockSize; ++b)
-    {
-        for (int c = 0; c < 2; ++c)
+    const float rampScale = 1.f / FXConfig::blockSize;
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < COMBS_PER_CHANNEL; ++i)
         {
-            combs[c][b] = 0;
-            for (int i = 0; i < COMBS_PER_CHANNEL; ++i)
-            {
-                if (vweights[c][i] > 0)
-                {
-                    auto tap = delaybase[c][i].v * (1.0 + lfoval[c][i].v * depth.v) + 1;
-                    auto v = idels[c].value(tap);
-                    combs[c][b] += vweights[c][i] * v;
-                }
-
-                lfoval[c][i].process();
-                delaybase[c][i].process();
-            }
+            combLfo[c][i] = lfoval[c][i].v;
+            combLfoStep[c][i] = (lfoval[c][i].new_v - lfoval[c][i].v) * rampScale;
+            combBase[c][i] = delaybase[c][i].v;
+            combBaseStep[c][i] = (delaybase[c][i].new_v - delaybase[c][i].v) * rampScale;
         }
-        // softclip the feedback to avoid explosive runaways
-        float fbl = 0.f;
-        float fbr = 0.f;
-        if (feedback.v > 0)
+    const float depthStep = (depth.new_v - depth.v) * rampScale;
+
+    int chunk = combChunk(depthStep);
+    for (int b0 = 0; b0 < FXConfig::blockSize; b0 += chunk)
+    {
+        auto n = std::min(chunk, FXConfig::blockSize - b0);
+        CombArgs args{&combLfo[0][0], &combBase[0][0], &depth.v, &combLfoStep[0][0],
+                      &combBaseStep[0][0], &vweights[0][0], depthStep, idels[0].line,
+                      idels[1].line, idels[0].k, combs[0] + b0, combs[1] + b0, n};
+        effects_shared::DispatchedKernel<CombKernel>::get()(args);
+
+        for (int b = b0; b < b0 + n; ++b)
         {
-            fbl = std::clamp(feedback.v * combs[0][b], -1.f, 1.f);
-            fbr = std::clamp(feedback.v * combs[1][b], -1.f, 1.f);
+            // softclip the feedback to avoid explosive runaways
+            float fbl = 0.f;
+            float fbr = 0.f;
+            if (feedback.v > 0)
+            {
+                fbl = std::clamp(feedback.v * combs[0][b], -1.f, 1.f);
+                fbr = std::clamp(feedback.v * combs[1][b], -1.f, 1.f);
 
-            fbl = 1.5 * fbl - 0.5 * fbl * fbl * fbl;
-            fbr = 1.5 * fbr - 0.5 * fbr * fbr * fbr;
+                fbl = 1.5 * fbl - 0.5 * fbl * fbl * fbl;
+                fbr = 1.5 * fbr - 0.5 * fbr * fbr * fbr;
 
-            // and now we have clipped, apply the damping. FIXME - move to one mul form
-            float df = std::clamp(fb_hf_damping.v, 0.01f, 0.99f);
-            lpaL = lpaL * (1.0 - df) + fbl * df;
-            fbl = fbl - lpaL;
+                // and now we have clipped, apply the damping. FIXME - move to one mul form
+                float df = std::clamp(fb_hf_damping.v, 0.01f, 0.99f);
+                lpaL = lpaL * (1.0 - df) + fbl * df;
+                fbl = fbl - lpaL;
 
-            lpaR = lpaR * (1.0 - df) + fbr * df;
-            fbr = fbr - lpaR;
-        }
+                lpaR = lpaR * (1.0 - df) + fbr * df;
+                fbr = fbr - lpaR;
+            }
 
-        auto vl = dataL[b] - fbl;
-        auto vr = dataR[b] - fbr;
-        idels[0].push(vl);
-        idels[1].push(vr);
+            auto vl = dataL[b] - fbl;
+            auto vr = dataR[b] - fbr;
+            idels[0].push(vl);
+            idels[1].push(vr);
 
-        auto origw = 1.f;
-        if (mode == flm_doppler || mode == flm_arp_solo)
-        {
-            // doppler modes
-            origw = 0.f;
-        }
+            auto origw = 1.f;
+            if (mode == flm_doppler || mode == flm_arp_solo)
+            {
+                // doppler modes
+                origw = 0.f;
+            }
 
-        float outl = origw * dataL[b] + mix.v * combs[0][b];
-        float outr = origw * dataR[b] + mix.v * combs[1][b];
+            float outl = origw * dataL[b] + mix.v * combs[0][b];
+            float outr = origw * dataR[b] + mix.v * combs[1][b];
 
-        // Some gain heueirstics
-        float gainadj = 0.0;
-        switch (mode)
-        {
-        case flm_classic:
-            gainadj = -1 / sqrt(7 - voices.v);
-            break;
-        case flm_doppler:
-            gainadj = -1 / sqrt(8 - voices.v);
-            break;
-        case flm_arp_mix:
-            gainadj = -1 / sqrt(6);
-            break;
-        case flm_arp_solo:
-            gainadj = -1 / sqrt(7);
-            break;
-        }
+            // Some gain heueirstics
+            float gainadj = 0.0;
+            switch (mode)
+            {
+            case flm_classic:
+                gainadj = -1 / sqrt(7 - voices.v);
+                break;
+            case flm_doppler:
+                gainadj = -1 / sqrt(8 - voices.v);
+                break;
+            case flm_arp_mix:
+                gainadj = -1 / sqrt(6);
+                break;
+            case flm_arp_solo:
+                gainadj = -1 / sqrt(7);
+                break;
+            }
 
-        gainadj -= 0.07 * mix.v;
+            gainadj -= 0.07 * mix.v;
 
-        outl = std::clamp((1.0f + gainadj) * outl, -1.f, 1.f);
-        outr = std::clamp((1.0f + gainadj) * outr, -1.f, 1.f);
+            outl = std::clamp((1.0f + gainadj) * outl, -1.f, 1.f);
+            outr = std::clamp((1.0f + gainadj) * outr, -1.f, 1.f);
 
-        outl = 1.5 * outl - 0.5 * outl * outl * outl;
-        outr = 1.5 * outr - 0.5 * outr * outr * outr;
+            outl = 1.5 * outl - 0.5 * outl * outl * outl;
+            outr = 1.5 * outr - 0.5 * outr * outr * outr;
 
-        dataL[b] = outl;
-        dataR[b] = outr;
+            dataL[b] = outl;
+            dataR[b] = outr;
 
-        depth.process();
-        mix.process();
-        feedback.process();
-        fb_hf_damping.process();
-        voices.process();
+            mix.process();
+            feedback.process();
+            fb_hf_damping.process();
+            voices.process();
+        }
     }
 
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < COMBS_PER_CHANNEL; ++i)
+        {
+            lfoval[c][i].v = combLfo[c][i];
+            delaybase[c][i].v = combBase[c][i];
+        }
+
     this->setWidthTarget(widthS, widthM, fl_width, 1.0 / 3.0);
     this->applyWidth(dataL, dataR, widthS, widthM);
 }
@@ -36,7 +36,7 @@
 #include "sst/basic-blocks/mechanics/block-ops.h"
 
 #include "sst/basic-blocks/tables/SincTableProvider.h"
-#include "sst/basic-blocks/dsp/SSESincDelayLine.h"
+#include "sst/effects-shared/SIMDKernels.h"
 
 #include "sst/filters/CytomicSVF.h"
 #include "sst/basic-blocks/modulators/SimpleLFO.h"
@@ -164,11 +164,14 @@ template <typename FXConfig> struct FloatyDelay : core::EffectTemplateBase<FXCon
     static constexpr int max_delay_length{1 << 19};
 
     const sst::basic_blocks::tables::SurgeSincTableProvider sincTable;
-    using line_t = sst::basic_blocks::dsp::SSESincDelayLine<max_delay_length>;
-    line_t delayLineL{sincTable};
-    line_t delayLineR{sincTable};
+    static constexpr int sincN{sst::basic_blocks::tables::SurgeSincTableProvider::FIRipol_N};
+    static constexpr int sincM{sst::basic_blocks::tables::SurgeSincTableProvider::FIRipol_M};
 
-    float min_delay_length = static_cast<float>(sincTable.FIRipol_N);
+    // both lines, with sincN samples mirrored past the end so the sinc reads never wrap
+    float delayLine alignas(16)[2][max_delay_length + sincN];
+    int wpos{0};
+
+    float min_delay_length = static_cast<float>(sincN);
 
     using lfo_t = sst::basic_blocks::modulators::SimpleLFO<FloatyDelay, FXConfig::blockSize>;
     lfo_t sineLFO{this, rng};
@@ -217,8 +220,8 @@ template <typename FXConfig> inline void FloatyDelay<FXConfig>::initialize()
     rateLerp.instantize();
     feedbackLerp.instantize();
     mixLerp.instantize();
-    delayLineL.clear();
-    delayLineR.clear();
+    memset(delayLine, 0, sizeof(delayLine));
+    wpos = 0;
     sineLFO.attack(sine);
     noiseLFO1.attack(noise);
     noiseLFO2.attack(noise);
@@ -227,6 +230,7 @@ template <typename FXConfig> inline void FloatyDelay<FXConfig>::initialize()
 template <typename FXConfig>
 inline void FloatyDelay<FXConfig>::processBlock(float *dataL, float *dataR)
 {
+    auto profile = this->processProfileScope(streamingName);
     float wr = this->floatValue(fld_warp_rate);
     float ww = this->floatValue(fld_warp_width);
     float pd = this->floatValue(fld_pitch_warp_depth);
@@ -290,38 +294,49 @@ inline void FloatyDelay<FXConfig>::processBlock(float *dataL, float *dataR)
     float dBufferL alignas(16)[FXConfig::blockSize];
     float dBufferR alignas(16)[FXConfig::blockSize];
 
-    float smooth{1.f};
-    float smoothWindow = 256.f;
-
     float HPfreq = 440 * this->noteToPitchIgnoringTuning(this->floatValue(fld_HP_freq));
     HPfilter.template setCoeffForBlock<FXConfig::blockSize>(
         sst::filters::CytomicSVF::Mode::Highpass, HPfreq, .55f, sampleRateInv, 0.f);
 
+    /*
+     * Phase one: the read head. Where it is and how far it is turned down only depend on
+     * the time and rate, so the whole block of sinc read offsets and gains is worked out
+     * before any audio is touched.
+     */
+    int rpL[FXConfig::blockSize], rpR[FXConfig::blockSize];
+    int sincL[FXConfig::blockSize], sincR[FXConfig::blockSize];
+    int reach[FXConfig::blockSize];
+    float smooth alignas(16)[FXConfig::blockSize];
+    float smoothWindow = 256.f;
+
     for (int i = 0; i < FXConfig::blockSize; i++)
     {
         auto absrate = std::fabs(playrate[i]);
         auto absRHM = std::fabs(readHeadMove);
         auto adjustedTime = baseTime * absrate;
+        bool forward = playrate[i] >= 0;
+        bool atOne = playrate[i] == 1;
 
-        if (absRHM >= adjustedTime)
-        {
-            readHeadMove = 0;
-        }
+        readHeadMove = (absRHM >= adjustedTime) ? 0.f : readHeadMove;
 
-        auto readPos = adjustedTime;
-        readPos -= (playrate[i] >= 0) ? readHeadMove : readPos - readHeadMove;
+        auto readPos = adjustedTime - (forward ? readHeadMove : adjustedTime - readHeadMove);
         // The increment determines the playback speed.
         // Write head advances 1 each sample, and we're setting read positions relative to it,
         // hence the -1 in fwd and +1 in rev.
-        float increment = (playrate[i] >= 0) ? absrate - 1 : absrate + 1;
-        readHeadMove += increment;
-
-        auto readPosL = readPos + modL[i];
-        auto readPosR = readPos + modR[i];
+        readHeadMove += forward ? absrate - 1 : absrate + 1;
 
         // Clamp at min_delay lest bad things happen
-        readPosL = std::max(readPosL, min_delay_length);
-        readPosR = std::max(readPosR, min_delay_length);
+        auto readPosL = std::max(readPos + modL[i], min_delay_length);
+        auto readPosR = std::max(readPos + modR[i], min_delay_length);
+
+        // sample i is written at wpos + i, and the sinc is centered readPos behind that
+        int iL = (int)readPosL, iR = (int)readPosR;
+        rpL[i] = (wpos + i - iL - (sincN >> 1)) & (max_delay_length - 1);
+        rpR[i] = (wpos + i - iR - (sincN >> 1)) & (max_delay_length - 1);
+        sincL[i] = sincN * (int)((1.f - (readPosL - iL)) * sincM);
+        sincR[i] = sincN * (int)((1.f - (readPosR - iR)) * sincM);
+        // how far the newest sample read lies behind the write head at the start of the block
+        reach[i] = std::min(iL & (max_delay_length - 1), iR & (max_delay_length - 1)) - i;
 
         /*
          Smoothing stragegy
@@ -329,61 +344,64 @@ inline void FloatyDelay<FXConfig>::processBlock(float *dataL, float *dataR)
          // TODO: Improve...
          Either try a 2-head strategy or make the window size relative to the speed
          */
-        if (playrate[i] == 1)
-        {
-            smooth = 1.f; // no smoothing needed
+        // coming back to 1 the delay time will be wrong, so wind the head back towards zero
+        // (yeah yeah, not quite exactly zero maybe, but close enough)
+        auto wind = (readHeadMove > 1) ? -1.f : ((readHeadMove < 1) ? 1.f : 0.f);
+        readHeadMove = (atOne && !wasOne) ? readHeadMove + wind : readHeadMove;
+        wasOne = atOne;
+
+        smoothWindow = (playrate[i] < 0) ? 512.f : smoothWindow; // lengthen the window in reverse
+        // this slightly cursed nest of mins answers "how far are we from a jump"
+        auto s = std::min(std::min(smoothWindow, absRHM),
+                          std::min(smoothWindow, adjustedTime - absRHM));
+        // the answer has no business outside these bounds
+        s = std::clamp(s, 0.f, smoothWindow);
+        // divide it by the window total to get the smoothing amount; none is needed at 1
+        smooth[i] = atOne ? 1.f : s / smoothWindow;
+    }
 
-            if (!wasOne)
-            {
-                if (readHeadMove > 1) // but delay time will be wrong
-                {
-                    readHeadMove -= 1; // so wind the head back towards zero
-                }
-                else if (readHeadMove < 1)
-                {
-                    readHeadMove += 1;
-                }
-                // (yeah yeah, not quite exactly zero maybe, but close enough)
-                wasOne = true;
-            }
-        }
-        else
-        {
-            wasOne = false;
-            if (playrate[i] < 0)
-            {
-                smoothWindow = 512.f; // lengthen the window in reverse
-            }
-            // this slightly cursed nest of mins answers "how far are we from a jump"
-            auto s = std::min(std::min(smoothWindow, absRHM),
-                              std::min(smoothWindow, adjustedTime - absRHM));
-            // the answer has no business outside these bounds
-            s = std::clamp(s, 0.f, smoothWindow);
-            // divide it by the window total to get the smoothing amount
-            smooth = s / smoothWindow;
-        }
+    /*
+     * Phase two: the line. A chunk never reads anything it writes itself, so its reads
+     * are done for both channels in one go before the chunk is filtered and written back.
+     */
+    namespace kern = sst::effects_shared::kernels;
+    for (int b0 = 0, n = 1; b0 < FXConfig::blockSize; b0 += n)
+    {
+        n = 1;
+        while (b0 + n < FXConfig::blockSize && reach[b0 + n] + b0 >= (sincN >> 1))
+            n++;
 
-        auto fromLineL = delayLineL.read(readPosL) * smooth;
-        auto fromLineR = delayLineR.read(readPosR) * smooth;
+        kern::dispatch<kern::SincReadBlock2<sincN>>(sincTable.sinctable1X, sincL + b0, sincR + b0,
+                                                    delayLine[0], delayLine[1], rpL + b0,
+                                                    rpR + b0, dBufferL + b0, dBufferR + b0, n);
 
-        // lest very slow speeds get a little unwieldy
-        DCfilter.processBlockStep(fromLineL, fromLineR);
+        for (int i = b0; i < b0 + n; i++)
+        {
+            dBufferL[i] *= smooth[i];
+            dBufferR[i] *= smooth[i];
 
-        dBufferL[i] = fromLineL;
-        dBufferR[i] = fromLineR;
+            // lest very slow speeds get a little unwieldy
+            DCfilter.processBlockStep(dBufferL[i], dBufferR[i]);
 
-        auto inL = dataL[i];
-        auto inR = dataR[i];
-        inputFilter.processBlockStep(inL, inR);
+            auto inL = dataL[i];
+            auto inR = dataR[i];
+            inputFilter.processBlockStep(inL, inR);
 
-        auto toLineL = inL + feedback[i] * dBufferL[i];
-        auto toLineR = inR + feedback[i] * dBufferR[i];
+            auto toLineL = inL + feedback[i] * dBufferL[i];
+            auto toLineR = inR + feedback[i] * dBufferR[i];
 
-        feedbackFilter.processBlockStep(toLineL, toLineR);
-        softClip(toLineL, toLineR);
+            feedbackFilter.processBlockStep(toLineL, toLineR);
+            softClip(toLineL, toLineR);
 
-        delayLineL.write(toLineL);
-        delayLineR.write(toLineR);
+            delayLine[0][wpos] = toLineL;
+            delayLine[1][wpos] = toLineR;
+            if (wpos < sincN)
+            {
+                delayLine[0][wpos + max_delay_length] = toLineL;
+                delayLine[1][wpos + max_delay_length] = toLineR;
+            }
+            wpos = (wpos + 1) & (max_delay_length - 1);
+        }
     }
 
     HPfilter.template processBlock<FXConfig::blockSize>(dBufferL, dBufferR, dBufferL, dBufferR);
@@ -21,7 +21,12 @@
 #ifndef INCLUDE_SST_EFFECTS_NIMBUS_H
 #define INCLUDE_SST_EFFECTS_NIMBUS_H
 
+#include <algorithm>
 #include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "EffectCore.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/basic-blocks/dsp/Lag.h"
@@ -29,6 +34,7 @@
 #include "sst/basic-blocks/dsp/LanczosResampler.h"
 #include "sst/basic-blocks/mechanics/block-ops.h"
 #include "sst/basic-blocks/mechanics/simd-ops.h"
+#include "sst/effects-shared/SPSCRing.h"
 
 /*
  * Unlike other effects, Nimbus is split into Nimbus and NimbusImpl.h to allow
@@ -67,6 +73,9 @@ template <typename FXConfig> struct Nimbus : core::EffectTemplateBase<FXConfig>
     int getRingoutDecay() const { return -1; }
     sst::basic_blocks::params::ParamMetaData paramAt(int i) const { return {}; }
     void onSampleRateChanged() {}
+    void setAsyncProcessing(bool) {}
+    bool isAsyncProcessing() const { return false; }
+    size_t getLatencySamples() const { return 0; }
 
   public:
     static constexpr int16_t streamingVersion{1};
@@ -189,7 +198,43 @@ template <typename FXConfig> struct Nimbus : core::EffectTemplateBase<FXConfig>
     // Only used by rack
     void setNimbusTrigger(bool b) { nimbusTrigger = b; }
 
+    /*
+     * Asynchronous mode. The granular engine and its resamplers run on a worker thread
+     * fed through lock free rings, and the audio thread only queues its input (with a
+     * snapshot of the parameters) and collects the wet output. This takes the irregular
+     * cost of the engine off the audio thread in exchange for a fixed extra latency of
+     * asyncLatencyBlocks blocks, which getLatencySamples reports for the host to
+     * compensate; the dry signal is delayed by the same amount so the whole output is
+     * late together. If the worker falls behind the wet signal drops out for a block
+     * rather than the audio thread waiting, and if the input ring is full the block is
+     * not queued. Either way the output ring is later trimmed or held back so the wet
+     * returns to the reported latency.
+     *
+     * Off by default. Switch it outside processBlock, since it starts or joins the worker.
+     * initialize, and so suspendProcessing and onSampleRateChanged, leave the worker
+     * running and have it reset the engine before its next block, with the wet silent
+     * until it has.
+     */
+    static constexpr int asyncLatencyBlocks{std::max(4, 1024 / (int)FXConfig::blockSize)};
+    void setAsyncProcessing(bool b);
+    bool isAsyncProcessing() const { return asyncProcessing; }
+    size_t getLatencySamples() const
+    {
+        return asyncProcessing ? asyncLatencyBlocks * FXConfig::blockSize : 0;
+    }
+
   protected:
+    // what the engine needs from the audio thread for one block
+    struct WetParams
+    {
+        float value[nmb_num_params];
+        int mode, quality;
+        bool trigger;
+    };
+    WetParams snapshotParams();
+    void processWet(const float *inL, const float *inR, const WetParams &p, float *wetL,
+                    float *wetR);
+
     float L alignas(16)[FXConfig::blockSize], R alignas(16)[FXConfig::blockSize];
 
     sdsp::lipol_sse<FXConfig::blockSize, false> mix;
@@ -214,6 +259,42 @@ template <typename FXConfig> struct Nimbus : core::EffectTemplateBase<FXConfig>
     int consumed = 0, created = 0;
     bool builtBuffer{false};
 
+    static constexpr size_t asyncRingBlocks{[]() {
+        size_t r = 2;
+        while (r < 2 * asyncLatencyBlocks)
+            r <<= 1;
+        return r;
+    }()};
+    struct AsyncInput
+    {
+        float L[FXConfig::blockSize], R[FXConfig::blockSize];
+        WetParams params;
+    };
+    struct AsyncOutput
+    {
+        float L[FXConfig::blockSize], R[FXConfig::blockSize];
+    };
+    std::unique_ptr<effects_shared::SPSCRing<AsyncInput, asyncRingBlocks>> asyncIn;
+    std::unique_ptr<effects_shared::SPSCRing<AsyncOutput, asyncRingBlocks>> asyncOut;
+    bool asyncProcessing{false};
+    // dropped out blocks which the worker will still deliver, less inputs it never got
+    int asyncBlocksOwed{0};
+    float asyncDry alignas(16)[2][asyncLatencyBlocks * FXConfig::blockSize];
+    int asyncDryPos{0};
+    std::thread worker;
+    std::atomic<bool> workerRunning{false};
+    std::mutex workerMutex;
+    std::condition_variable workerWake;
+    // set by initialize while the worker runs; the worker clears it once it has reset
+    std::atomic<bool> asyncResetPending{false};
+    void resetEngine();
+    void resetAsyncRings();
+    void startWorker();
+    void stopWorker();
+    void runWorker();
+    // queue this block's input for the worker and take its oldest output into L and R
+    void collectAsyncWet(const float *dataL, const float *dataR);
+
   public:
     static constexpr int16_t streamingVersion{1};
     static void remapParametersForStreamingVersion(int16_t streamedFrom, float *const param)
@@ -64,6 +64,7 @@ Nimbus<FXConfig>::Nimbus(typename FXConfig::GlobalStorage *s, typename FXConfig:
 
 template <typename FXConfig> Nimbus<FXConfig>::~Nimbus()
 {
+    stopWorker();
     delete[] block_mem;
     delete[] block_ccm;
     delete processor;
@@ -74,6 +75,22 @@ template <typename FXConfig> void Nimbus<FXConfig>::initialize()
     mix.set_target(1.f);
     mix.instantize();
 
+    if (worker.joinable())
+    {
+        // The worker owns the engine and the rings while it runs, so rather than stop it
+        // here ask it to reset them before its next block. The wet is silent until it has.
+        memset(asyncDry, 0, sizeof(asyncDry));
+        asyncDryPos = 0;
+        asyncResetPending.store(true, std::memory_order_release);
+        workerWake.notify_one();
+        return;
+    }
+
+    resetEngine();
+}
+
+template <typename FXConfig> void Nimbus<FXConfig>::resetEngine()
+{
     surgeSR_to_euroSR = std::make_unique<resamp_t>(this->sampleRate(), processor_sr);
     euroSR_to_surgeSR = std::make_unique<resamp_t>(processor_sr, this->sampleRate());
 
@@ -86,19 +103,215 @@ template <typename FXConfig> void Nimbus<FXConfig>::initialize()
     resampWritePtr = 1; // why 1? well while we are stalling we want to output 0 so write 1 ahead
 }
 
+template <typename FXConfig> void Nimbus<FXConfig>::setAsyncProcessing(bool b)
+{
+    if (b == asyncProcessing)
+        return;
+
+    asyncProcessing = b;
+    if (b)
+    {
+        startWorker();
+    }
+    else
+    {
+        stopWorker();
+        // an initialize the worker didn't get to
+        if (asyncResetPending.exchange(false, std::memory_order_acquire))
+            resetEngine();
+    }
+}
+
+template <typename FXConfig> void Nimbus<FXConfig>::resetAsyncRings()
+{
+    asyncIn->reset();
+    asyncOut->reset();
+
+    // the latency is the silence the worker starts out ahead by
+    for (int i = 0; i < asyncLatencyBlocks; ++i)
+    {
+        auto *o = asyncOut->pushSlot();
+        memset(o, 0, sizeof(AsyncOutput));
+        asyncOut->commitPush();
+    }
+    asyncBlocksOwed = 0;
+}
+
+template <typename FXConfig> void Nimbus<FXConfig>::startWorker()
+{
+    if (!asyncIn)
+        asyncIn = std::make_unique<effects_shared::SPSCRing<AsyncInput, asyncRingBlocks>>();
+    if (!asyncOut)
+        asyncOut = std::make_unique<effects_shared::SPSCRing<AsyncOutput, asyncRingBlocks>>();
+    resetAsyncRings();
+    memset(asyncDry, 0, sizeof(asyncDry));
+    asyncDryPos = 0;
+
+    workerRunning = true;
+    worker = std::thread([this]() { runWorker(); });
+}
+
+template <typename FXConfig> void Nimbus<FXConfig>::stopWorker()
+{
+    if (!worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> g(workerMutex);
+        workerRunning = false;
+    }
+    workerWake.notify_one();
+    worker.join();
+}
+
+template <typename FXConfig> void Nimbus<FXConfig>::runWorker()
+{
+    while (workerRunning)
+    {
+        // the audio thread leaves the engine, the rings and asyncBlocksOwed alone until
+        // this is cleared
+        if (asyncResetPending.load(std::memory_order_acquire))
+        {
+            resetEngine();
+            resetAsyncRings();
+            asyncResetPending.store(false, std::memory_order_release);
+        }
+
+        auto *in = asyncIn->popSlot();
+        auto *out = asyncOut->pushSlot();
+        if (!in || !out)
+        {
+            // nothing queued, or the audio thread has stopped collecting. The timeout
+            // covers a wake which lands between the check above and the wait.
+            std::unique_lock<std::mutex> lk(workerMutex);
+            workerWake.wait_for(lk, std::chrono::milliseconds(1), [this]() {
+                return !workerRunning || asyncResetPending.load(std::memory_order_relaxed) ||
+                       (!asyncIn->empty() && asyncOut->pushSlot());
+            });
+            continue;
+        }
+
+        if (surgeSR_to_euroSR && euroSR_to_surgeSR)
+        {
+            processWet(in->L, in->R, in->params, out->L, out->R);
+        }
+        else
+        {
+            // switched to async before the first initialize
+            memset(out, 0, sizeof(AsyncOutput));
+        }
+        // publish the output before freeing the input, so an empty input ring means done
+        asyncOut->commitPush();
+        asyncIn->commitPop();
+    }
+}
+
+template <typename FXConfig>
+typename Nimbus<FXConfig>::WetParams Nimbus<FXConfig>::snapshotParams()
+{
+    WetParams p;
+    for (int i = 0; i < nmb_num_params; ++i)
+        p.value[i] = this->floatValue(i);
+    p.mode = this->intValue(nmb_mode);
+    p.quality = this->intValue(nmb_quality);
+    p.trigger = nimbusTrigger;
+    return p;
+}
+
 template <typename FXConfig>
 void Nimbus<FXConfig>::processBlock(float *__restrict dataL, float *__restrict dataR)
 {
-    if (!surgeSR_to_euroSR || !euroSR_to_surgeSR)
-        return;
+    auto profile = this->processProfileScope(streamingName);
+    if (asyncProcessing)
+    {
+        if (asyncResetPending.load(std::memory_order_acquire))
+        {
+            // the worker is yet to reset after initialize, so nothing it has is current
+            memset(L, 0, sizeof(L));
+            memset(R, 0, sizeof(R));
+        }
+        else
+        {
+            collectAsyncWet(dataL, dataR);
+        }
 
+        // the dry side runs through a delay of the same length, so the mix stays aligned
+        auto *dL = asyncDry[0] + asyncDryPos * FXConfig::blockSize;
+        auto *dR = asyncDry[1] + asyncDryPos * FXConfig::blockSize;
+        for (int i = 0; i < FXConfig::blockSize; ++i)
+        {
+            std::swap(dataL[i], dL[i]);
+            std::swap(dataR[i], dR[i]);
+        }
+        asyncDryPos = (asyncDryPos + 1) % asyncLatencyBlocks;
+    }
+    else
+    {
+        if (!surgeSR_to_euroSR || !euroSR_to_surgeSR)
+            return;
+        processWet(dataL, dataR, snapshotParams(), L, R);
+    }
+
+    mix.set_target_smoothed(std::clamp(this->floatValue(nmb_mix), 0.f, 1.f));
+    mix.fade_2_blocks_inplace(dataL, L, dataR, R);
+}
+
+template <typename FXConfig>
+void Nimbus<FXConfig>::collectAsyncWet(const float *dataL, const float *dataR)
+{
+    if (auto *in = asyncIn->pushSlot())
+    {
+        memcpy(in->L, dataL, sizeof(in->L));
+        memcpy(in->R, dataR, sizeof(in->R));
+        in->params = snapshotParams();
+        asyncIn->commitPush();
+        workerWake.notify_one();
+    }
+    else
+    {
+        // the worker will never deliver this block, so one fewer is owed
+        asyncBlocksOwed--;
+    }
+
+    // catch up on blocks we dropped out for, so the latency stays where it was
+    while (asyncBlocksOwed > 0 && asyncOut->size() > 1)
+    {
+        asyncOut->commitPop();
+        asyncBlocksOwed--;
+    }
+
+    if (asyncBlocksOwed < 0)
+    {
+        // short of a block after dropping input, so hold back and let the wet fall back
+        memset(L, 0, sizeof(L));
+        memset(R, 0, sizeof(R));
+        asyncBlocksOwed++;
+    }
+    else if (auto *out = asyncOut->popSlot())
+    {
+        memcpy(L, out->L, sizeof(L));
+        memcpy(R, out->R, sizeof(R));
+        asyncOut->commitPop();
+    }
+    else
+    {
+        memset(L, 0, sizeof(L));
+        memset(R, 0, sizeof(R));
+        asyncBlocksOwed++;
+    }
+}
+
+template <typename FXConfig>
+void Nimbus<FXConfig>::processWet(const float *inL, const float *inR, const WetParams &p,
+                                  float *wetL, float *wetR)
+{
     /* Resample Temp Buffers */
     float resample_this[2][FXConfig::blockSize << 3];
     float resample_into[2][FXConfig::blockSize << 3];
 
     for (int i = 0; i < FXConfig::blockSize; ++i)
     {
-        surgeSR_to_euroSR->push(dataL[i], dataR[i]);
+        surgeSR_to_euroSR->push(inL[i], inR[i]);
     }
 
     float srgToEur[2][FXConfig::blockSize << 3];
@@ -113,7 +326,7 @@ void Nimbus<FXConfig>::processBlock(float *__restrict dataL, float *__restrict d
         int frames_to_go = outputFramesGen;
         int outpos = 0;
 
-        auto modeInt = this->intValue(nmb_mode);
+        auto modeInt = p.mode;
         // Just make sure we are safe if we swap between superparasites and not
 #if EURORACK_CLOUDS_IS_SUPERPARASITES
         modeInt = std::clamp(modeInt, 0, 7);
@@ -122,7 +335,7 @@ void Nimbus<FXConfig>::processBlock(float *__restrict dataL, float *__restrict d
 #endif
         processor->set_playback_mode(
             (clouds::PlaybackMode)((int)clouds::PLAYBACK_MODE_GRANULAR + modeInt));
-        processor->set_quality(this->intValue(nmb_quality));
+        processor->set_quality(p.quality);
 
         int consume_ptr = 0;
 
@@ -152,26 +365,26 @@ void Nimbus<FXConfig>::processBlock(float *__restrict dataL, float *__restrict d
 
             float den_val, tex_val;
 
-            den_val = (this->floatValue(nmb_density) + 1.f) * 0.5;
-            tex_val = (this->floatValue(nmb_texture) + 1.f) * 0.5;
+            den_val = (p.value[nmb_density] + 1.f) * 0.5;
+            tex_val = (p.value[nmb_texture] + 1.f) * 0.5;
 
-            parm->position = std::clamp(this->floatValue(nmb_position), 0.f, 1.f);
-            parm->size = std::clamp(this->floatValue(nmb_size), 0.f, 1.f);
+            parm->position = std::clamp(p.value[nmb_position], 0.f, 1.f);
+            parm->size = std::clamp(p.value[nmb_size], 0.f, 1.f);
             parm->density = std::clamp(den_val, 0.f, 1.f);
             parm->texture = std::clamp(tex_val, 0.f, 1.f);
-            parm->pitch = std::clamp(this->floatValue(nmb_pitch), -48.f, 48.f);
-            parm->stereo_spread = std::clamp(this->floatValue(nmb_spread), 0.f, 1.f);
-            parm->feedback = std::clamp(this->floatValue(nmb_feedback), 0.f, 1.f);
-            parm->freeze = this->floatValue(nmb_freeze) > 0.5;
-            parm->reverb = std::clamp(this->floatValue(nmb_reverb), 0.f, 1.f);
+            parm->pitch = std::clamp(p.value[nmb_pitch], -48.f, 48.f);
+            parm->stereo_spread = std::clamp(p.value[nmb_spread], 0.f, 1.f);
+            parm->feedback = std::clamp(p.value[nmb_feedback], 0.f, 1.f);
+            parm->freeze = p.value[nmb_freeze] > 0.5;
+            parm->reverb = std::clamp(p.value[nmb_reverb], 0.f, 1.f);
             // Supercell (and maybe original) has a bug with an interpolation
             // read off end of mix line at exactly 1.0
             parm->dry_wet = 0.99999f; // 1.f;
 
 #if EURORACK_CLOUDS_IS_SUPERPARASITES
-            parm->capture = nimbusTrigger;
+            parm->capture = p.trigger;
 #else
-            parm->trigger = nimbusTrigger; // this is an external granulating source. Skip it
+            parm->trigger = p.trigger; // this is an external granulating source. Skip it
 #endif
             parm->gate = parm->freeze; // This is the CV for the freeze button
 
@@ -234,14 +447,11 @@ void Nimbus<FXConfig>::processBlock(float *__restrict dataL, float *__restrict d
     size_t rp = resampReadPtr;
     for (int i = 0; i < FXConfig::blockSize; ++i)
     {
-        L[i] = resampled_output[0][rp];
-        R[i] = resampled_output[1][rp];
+        wetL[i] = resampled_output[0][rp];
+        wetR[i] = resampled_output[1][rp];
         rp = (rp + rpi) & (raw_out_sz - 1);
     }
     resampReadPtr = rp;
-
-    mix.set_target_smoothed(std::clamp(this->floatValue(nmb_mix), 0.f, 1.f));
-    mix.fade_2_blocks_inplace(dataL, L, dataR, R);
 }
 
 } // namespace sst::effects::nimbus
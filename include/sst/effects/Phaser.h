@@ -66,12 +66,6 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
         : core::EffectTemplateBase<FXConfig>(s, e, p), lp(s), hp(s)
     {
         static_assert(core::ValidEffect<Phaser>);
-        for (int i = 0; i < n_bq_units; i++)
-        {
-            biquad[i] = new BiquadFilter(this->globalStorage);
-        }
-
-        n_bq_units_initialised = n_bq_units;
         feedback.setBlockSize(FXConfig::blockSize * this->slowrate);
         tone.setBlockSize(FXConfig::blockSize);
         widthS.set_blocksize(FXConfig::blockSize);
@@ -88,10 +82,7 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
         dL = 0;
         dR = 0;
 
-        for (int i = 0; i < n_bq_units_initialised; i++)
-        {
-            biquad[i]->suspend();
-        }
+        cascade.suspend();
 
         mech::clear_block<FXConfig::blockSize>(L);
         mech::clear_block<FXConfig::blockSize>(R);
@@ -112,12 +103,6 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
         modLFO.setSampleRate(this->sampleRate());
     }
 
-    ~Phaser()
-    {
-        for (int i = 0; i < n_bq_units_initialised; ++i)
-            delete biquad[i];
-    }
-
     void onSampleRateChanged()
     {
         modLFO.setSampleRate(this->sampleRate());
@@ -153,22 +138,7 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
     }
     size_t silentSamplesLength() const { return 10; }
 
-    void init_stages()
-    {
-        n_stages = this->intValue(ph_stages);
-        n_bq_units = n_stages * 2;
-
-        if (n_bq_units_initialised < n_bq_units)
-        {
-            // we need to increase the number of stages
-            for (int k = n_bq_units_initialised; k < n_bq_units; k++)
-            {
-                biquad[k] = new BiquadFilter(this->globalStorage);
-            }
-
-            n_bq_units_initialised = n_bq_units;
-        }
-    }
+    void init_stages() { n_stages = std::clamp(this->intValue(ph_stages), 1, max_stages); }
     void setvars()
     {
         init_stages();
@@ -201,33 +171,30 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
         auto lfoVals = modLFO.valueStereo();
 
         // if stages is set to 1 to indicate we are in legacy mode, use legacy freqs and spans
+        auto q = 1.0 + 0.8 * this->floatValue(ph_sharpness);
         if (n_stages < 2)
         {
             // 4 stages in original phaser mode
             for (int i = 0; i < 2; i++)
             {
-                double omega = biquad[2 * i]->calc_omega(
-                    2 * this->floatValue(ph_center) + legacy_freq[i] + legacy_span[i] * lfoVals[0]);
-                biquad[2 * i]->coeff_APF(omega, 1.0 + 0.8 * this->floatValue(ph_sharpness));
-                omega = biquad[2 * i + 1]->calc_omega(2 * this->floatValue(ph_center) +
-                                                      legacy_freq[i] + legacy_span[i] * lfoVals[1]);
-                biquad[2 * i + 1]->coeff_APF(omega, 1.0 + 0.8 * this->floatValue(ph_sharpness));
+                for (int c = 0; c < 2; ++c)
+                    cascade.omega[i][c] = lp.calc_omega(2 * this->floatValue(ph_center) +
+                                                        legacy_freq[i] +
+                                                        legacy_span[i] * lfoVals[c]);
             }
+            cascade.setAllpassTargets(2, q);
         }
         else
         {
             for (int i = 0; i < n_stages; i++)
             {
                 double center = powf(2, (i + 1.0) * 2 / n_stages);
-                double omega = biquad[2 * i]->calc_omega(2 * this->floatValue(ph_center) +
-                                                         this->floatValue(ph_spread) * center +
-                                                         2.0 / (i + 1) * lfoVals[0]);
-                biquad[2 * i]->coeff_APF(omega, 1.0 + 0.8 * this->floatValue(ph_sharpness));
-                omega = biquad[2 * i + 1]->calc_omega(2 * this->floatValue(ph_center) +
-                                                      this->floatValue(ph_spread) * center +
-                                                      2.0 / (i + 1) * lfoVals[1]);
-                biquad[2 * i + 1]->coeff_APF(omega, 1.0 + 0.8 * this->floatValue(ph_sharpness));
+                for (int c = 0; c < 2; ++c)
+                    cascade.omega[i][c] = lp.calc_omega(2 * this->floatValue(ph_center) +
+                                                        this->floatValue(ph_spread) * center +
+                                                        2.0 / (i + 1) * lfoVals[c]);
             }
+            cascade.setAllpassTargets(n_stages, q);
         }
 
         feedback.newValue(0.95f * this->floatValue(ph_feedback));
@@ -259,10 +226,12 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
 
     void processBlock(float *__restrict dataL, float *__restrict dataR)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (bi == 0)
         {
             setvars();
         }
+        cascade.beginBlock(n_stages);
 
         bi = (bi + 1) & this->slowrate_m1;
 
@@ -276,15 +245,12 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
             dL = std::clamp(dL, -32.f, 32.f);
             dR = std::clamp(dR, -32.f, 32.f);
 
-            for (int curr_stage = 0; curr_stage < n_stages; curr_stage++)
-            {
-                dL = biquad[2 * curr_stage]->process_sample(dL);
-                dR = biquad[2 * curr_stage + 1]->process_sample(dR);
-            }
+            cascade.process(n_stages, i, dL, dR);
 
             L[i] = dL;
             R[i] = dR;
         }
+        cascade.endBlock(n_stages);
 
         if (!this->isDeactivated(ph_tone))
         {
@@ -292,10 +258,8 @@ template <typename FXConfig> struct Phaser : core::EffectTemplateBase<FXConfig>
             hp.process_block(L, R);
         }
 
-        this->applyWidth(L, R, widthS, widthM);
-
         mix.set_target_smoothed(std::clamp(this->floatValue(ph_mix), 0.f, 1.f));
-        mix.fade_2_blocks_inplace(dataL, L, dataR, R, this->blockSize_quad);
+        this->applyWidthAndMix(dataL, dataR, L, R, widthS, widthM, mix);
     }
 
     basic_blocks::params::ParamMetaData paramAt(int idx) const
@@ -373,10 +337,164 @@ fxdata->p[ph_mod_rate].deactivated = false;
     static constexpr int max_stages = 16;
     static constexpr int default_stages = 4;
     int n_stages = default_stages;
-    int n_bq_units = default_stages << 1;
-    int n_bq_units_initialised = 0;
     float dL, dR;
-    BiquadFilter *biquad[max_stages * 2], lp, hp;
+    BiquadFilter lp, hp;
+
+    /*
+     * The allpass stages as a preallocated structure of arrays, one biquad per stage
+     * with L and R as the two double lanes of a SIMD register. Coefficients are those of
+     * BiquadFilter::coeff_APF, recomputed over all stages at once when the modulation
+     * updates, and follow their targets with BiquadFilter's one pole lag, so the cascade
+     * sounds as a chain of those filters would.
+     */
+    struct AllpassCascade
+    {
+        static constexpr double lagRate{0.004}; // BiquadFilter's coefficient lag
+
+        double omega alignas(16)[max_stages][2]{};
+        // a coefficient is target + offset, and the lag only ever shrinks the offset
+        double target alignas(16)[5][max_stages][2]{}; // b0, b1, b2, a1, a2
+        double offset alignas(16)[5][max_stages][2]{};
+        double z1 alignas(16)[max_stages][2]{};
+        double z2 alignas(16)[max_stages][2]{};
+        double decay alignas(16)[FXConfig::blockSize][2];
+        bool firstRun[max_stages];
+        bool gliding{false};
+
+        AllpassCascade()
+        {
+            double d{1.0};
+            for (int s = 0; s < FXConfig::blockSize; ++s)
+            {
+                d *= 1.0 - lagRate;
+                decay[s][0] = decay[s][1] = d;
+            }
+            suspend();
+        }
+
+        // as BiquadFilter::suspend on every stage: clear the state, and the next
+        // coefficients a stage gets apply at once
+        void suspend()
+        {
+            memset(z1, 0, sizeof(z1));
+            memset(z2, 0, sizeof(z2));
+            memset(offset, 0, sizeof(offset));
+            std::fill(firstRun, firstRun + max_stages, true);
+            gliding = false;
+        }
+
+        void setAllpassTargets(int n, double q)
+        {
+            // std::sin and std::cos have no SIMD form which rounds as they do, and
+            // matching coeff_APF exactly needs them, so only they stay scalar
+            double sinw alignas(16)[max_stages][2], cosw alignas(16)[max_stages][2];
+            for (int i = 0; i < n; ++i)
+            {
+                for (int c = 0; c < 2; ++c)
+                {
+                    sinw[i][c] = std::sin(omega[i][c]);
+                    cosw[i][c] = std::cos(omega[i][c]);
+                }
+            }
+
+            const auto zero = SIMD_MM(setzero_pd)(), one = SIMD_MM(set1_pd)(1.0);
+            const auto pi = SIMD_MM(set1_pd)(M_PI), twoQ = SIMD_MM(set1_pd)(2 * q);
+            const auto mtwo = SIMD_MM(set1_pd)(-2.0);
+            for (int i = 0; i < n; ++i)
+            {
+                auto w = SIMD_MM(load_pd)(omega[i]);
+                // outside 0..pi coeff_APF makes the stage a wire
+                auto wire = SIMD_MM(or_pd)(SIMD_MM(cmplt_pd)(w, zero), SIMD_MM(cmpgt_pd)(w, pi));
+
+                auto alpha = SIMD_MM(div_pd)(SIMD_MM(load_pd)(sinw[i]), twoQ);
+                auto a0inv = SIMD_MM(div_pd)(one, SIMD_MM(add_pd)(one, alpha));
+                auto c1 = SIMD_MM(mul_pd)(SIMD_MM(mul_pd)(mtwo, SIMD_MM(load_pd)(cosw[i])), a0inv);
+                auto cN = SIMD_MM(mul_pd)(SIMD_MM(sub_pd)(one, alpha), a0inv);
+                auto cP = SIMD_MM(mul_pd)(SIMD_MM(add_pd)(one, alpha), a0inv);
+
+                auto b1 = SIMD_MM(andnot_pd)(wire, c1);
+                const decltype(w) t[5]{
+                    SIMD_MM(or_pd)(SIMD_MM(and_pd)(wire, one), SIMD_MM(andnot_pd)(wire, cN)), b1,
+                    SIMD_MM(andnot_pd)(wire, cP), b1, SIMD_MM(andnot_pd)(wire, cN)};
+
+                // as SurgeLag::newValue, the value carries on from where it was
+                for (int k = 0; k < 5; ++k)
+                {
+                    auto o = zero;
+                    if (!firstRun[i])
+                        o = SIMD_MM(sub_pd)(SIMD_MM(add_pd)(SIMD_MM(load_pd)(target[k][i]),
+                                                            SIMD_MM(load_pd)(offset[k][i])),
+                                            t[k]);
+                    SIMD_MM(store_pd)(target[k][i], t[k]);
+                    SIMD_MM(store_pd)(offset[k][i], o);
+                }
+                firstRun[i] = false;
+            }
+        }
+
+        // land stages whose coefficients have come within rounding of their targets, and
+        // note if any which run this block are still on their way
+        void beginBlock(int n)
+        {
+            gliding = false;
+            for (int i = 0; i < n; ++i)
+            {
+                bool settled{true};
+                for (int k = 0; k < 5; ++k)
+                    for (int c = 0; c < 2; ++c)
+                        settled = settled && std::fabs(offset[k][i][c]) <=
+                                                 1e-12 * (1.0 + std::fabs(target[k][i][c]));
+                if (settled)
+                    for (int k = 0; k < 5; ++k)
+                        offset[k][i][0] = offset[k][i][1] = 0.0;
+                gliding = gliding || !settled;
+            }
+        }
+
+        // only the stages which ran lag, as only the filters which processed did
+        void endBlock(int n)
+        {
+            if (!gliding)
+                return;
+
+            auto d = SIMD_MM(load_pd)(decay[FXConfig::blockSize - 1]);
+            for (int k = 0; k < 5; ++k)
+                for (int i = 0; i < n; ++i)
+                    SIMD_MM(store_pd)(offset[k][i],
+                                      SIMD_MM(mul_pd)(SIMD_MM(load_pd)(offset[k][i]), d));
+        }
+
+        // sample s of the block through the first n stages
+        void process(int n, int s, float &inL, float &inR)
+        {
+            auto x = SIMD_MM(cvtps_pd)(SIMD_MM(setr_ps)(inL, inR, 0.f, 0.f));
+            auto d = SIMD_MM(load_pd)(decay[s]);
+            auto coef = [&](int k, int i) {
+                auto c = SIMD_MM(load_pd)(target[k][i]);
+                if (gliding)
+                    c = SIMD_MM(add_pd)(c, SIMD_MM(mul_pd)(SIMD_MM(load_pd)(offset[k][i]), d));
+                return c;
+            };
+            for (int i = 0; i < n; ++i)
+            {
+                auto b0 = coef(0, i), b1 = coef(1, i), b2 = coef(2, i);
+                auto a1 = coef(3, i), a2 = coef(4, i);
+                auto s1 = SIMD_MM(load_pd)(z1[i]), s2 = SIMD_MM(load_pd)(z2[i]);
+
+                // transposed direct form 2, as BiquadFilter::process_sample
+                auto y = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(x, b0), s1);
+                s1 = SIMD_MM(add_pd)(
+                    SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, b1), SIMD_MM(mul_pd)(a1, y)), s2);
+                s2 = SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, b2), SIMD_MM(mul_pd)(a2, y));
+                SIMD_MM(store_pd)(z1[i], s1);
+                SIMD_MM(store_pd)(z2[i], s2);
+                x = y;
+            }
+            auto out = SIMD_MM(cvtpd_ps)(x);
+            inL = SIMD_MM(cvtss_f32)(out);
+            inR = SIMD_MM(cvtss_f32)(SIMD_MM(shuffle_ps)(out, out, SIMD_MM_SHUFFLE(1, 1, 1, 1)));
+        }
+    } cascade;
     int bi; // block increment (to keep track of events not occurring every n blocks)
 
     // before stages/spread added parameters we had 4 stages at fixed frequencies and modulation
@@ -20,6 +20,7 @@
 #ifndef INCLUDE_SST_EFFECTS_REVERB1_H
 #define INCLUDE_SST_EFFECTS_REVERB1_H
 
+#include <algorithm>
 #include <cstring>
 #include "EffectCore.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
@@ -28,6 +29,7 @@
 #include "sst/filters/BiquadFilter.h"
 #include "sst/basic-blocks/mechanics/block-ops.h"
 #include "sst/basic-blocks/mechanics/simd-ops.h"
+#include "sst/effects-shared/SIMDKernels.h"
 
 namespace sst::effects::reverb1
 {
@@ -61,6 +63,8 @@ template <typename FXConfig> struct Reverb1 : core::EffectTemplateBase<FXConfig>
 
     void initialize();
     void processBlock(float *__restrict L, float *__restrict R);
+    // nBlocks * blockSize samples with the parameters read once; see core::processBlocks
+    void processBlocks(float *__restrict L, float *__restrict R, int nBlocks);
 
     void suspendProcessing() { initialize(); }
     int getRingoutDecay() const { return ringout_time; }
@@ -123,21 +127,66 @@ template <typename FXConfig> struct Reverb1 : core::EffectTemplateBase<FXConfig>
     static constexpr int max_rev_dly = 1 << revbits;
     static constexpr int rev_tap_bits = 4;
     static constexpr int rev_taps = 1 << rev_tap_bits;
+    static constexpr int maxSpanBlocks = 8;
+    // a cache line of padding per tap line, so the lines don't all map to the same sets
+    static constexpr int line_stride = max_rev_dly + 16;
 
     float delay_pan_L alignas(16)[rev_taps], delay_pan_R alignas(16)[rev_taps];
     float delay_fb alignas(16)[rev_taps];
-    float delay alignas(16)[rev_taps * max_rev_dly];
+    /*
+     * One contiguous line per tap, line t at delay + t * line_stride. The sample written
+     * as delay_pos moves to p is stored at p - 1, so a block's writes start aligned.
+     */
+    float delay alignas(16)[rev_taps * line_stride];
     float out_tap alignas(16)[rev_taps];
     float predelay alignas(16)[max_rev_dly];
     int delay_time alignas(16)[rev_taps];
     typename core::EffectTemplateBase<FXConfig>::lipol_ps_blocksz mix, widthS, widthM;
 
+    /*
+     * The per sample tap loop, which is most of the cost of this effect, dispatched at
+     * runtime. No tap is shorter than a chunk, so the reads for a whole chunk are
+     * known up front: readTaps copies them out of the lines four taps by four samples
+     * at a time into tapIn (sample major, 16 taps per sample), the kernel runs the
+     * feedback network out of tapIn and into tapOut, and writeTaps puts tapOut back
+     * into the lines. The kernel never touches the lines, so it needs no gathers at any
+     * level, and the wider variants keep the sse2 order of summation so every level
+     * produces the same output.
+     */
+    static constexpr int maxChunk = maxSpanBlocks * FXConfig::blockSize;
+    float tapIn alignas(16)[maxChunk * rev_taps];
+    float tapOut alignas(16)[maxChunk * rev_taps];
+    void readTaps(int n);
+    void writeTaps(int startPos, int n);
+
+    struct TapArgs
+    {
+        const float *tapIn;
+        float *tapOut, *predelay, *out_tap;
+        const float *delay_fb, *delay_pan_L, *delay_pan_R;
+        int *delay_pos;
+        int pdtime;
+        float damping;
+        const float *dataL, *dataR;
+        float *wetL, *wetR;
+        int n;
+    };
+    struct TapKernel
+    {
+        using fn_t = void (*)(const TapArgs &);
+        static void sse2(const TapArgs &args);
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+        SST_EFFECTS_TARGET_AVX2 static void avx2(const TapArgs &args);
+        SST_EFFECTS_TARGET_AVX512 static void avx512(const TapArgs &args);
+#endif
+    };
+
     void update_rtime();
     void update_rsize() { loadpreset(shape); }
     void clear_buffers()
     {
         mech::clear_block<max_rev_dly>(predelay);
-        mech::clear_block<rev_taps * max_rev_dly>(delay);
+        mech::clear_block<rev_taps * line_stride>(delay);
     }
 
     void loadpreset(int id);
@@ -216,60 +265,121 @@ template <typename FXConfig> inline void Reverb1<FXConfig>::initialize()
 template <typename FXConfig>
 inline void Reverb1<FXConfig>::processBlock(float *__restrict dataL, float *__restrict dataR)
 {
-    float wetL alignas(16)[FXConfig::blockSize], wetR alignas(16)[FXConfig::blockSize];
+    processBlocks(dataL, dataR, 1);
+}
+
+template <typename FXConfig>
+inline void Reverb1<FXConfig>::processBlocks(float *__restrict dataL, float *__restrict dataR,
+                                             int nBlocks)
+{
+    auto profile = this->processProfileScope(streamingName);
+    constexpr int bs{FXConfig::blockSize};
+    float wetL alignas(16)[maxSpanBlocks * bs], wetR alignas(16)[maxSpanBlocks * bs];
 
     if (this->intValue(rev1_shape) != shape)
         loadpreset(this->intValue(rev1_shape));
-    if ((b == 0) && (fabs(this->floatValue(rev1_roomsize) - lastf[rev1_roomsize]) > 0.001f))
-        loadpreset(shape);
     //	if(fabs(this->floatValue(rev1_variation) - lastf[rev1_variation]) > 0.001f) update_rsize();
     if (fabs(this->floatValue(rev1_decaytime) - lastf[rev1_decaytime]) > 0.001f)
         update_rtime();
 
-    // do more seldom
-    if (b == 0)
-    {
-        band1.coeff_peakEQ(band1.calc_omega(this->floatValue(rev1_freq1) * (1.f / 12.f)), 2,
-                           this->floatValue(rev1_gain1));
-        locut.coeff_HP(locut.calc_omega(this->floatValue(rev1_lowcut) * (1.f / 12.f)), 0.5);
-        hicut.coeff_LP2B(hicut.calc_omega(this->floatValue(rev1_highcut) * (1.f / 12.f)), 0.5);
-    }
-    b = (b + 1) & 31;
-
-    mix.set_target_smoothed(this->floatValue(rev1_mix));
-    this->setWidthTarget(widthS, widthM, rev1_width);
-
     int pdtime = (int)(float)this->sampleRate() *
                  this->noteToPitchIgnoringTuning(12 * this->floatValue(rev1_predelay)) *
                  this->temposyncRatio(rev1_predelay);
 
-    const auto one4 = SIMD_MM(set1_ps)(1.f);
     float dv = this->floatValue(rev1_damping);
 
     dv = std::clamp(dv, 0.01f, 0.99f); // this is a simple one-pole damper, w * y[n] + ( 1-w )
                                        // y[n-1] so to be stable has to stay in range
-    auto damp4 = SIMD_MM(load1_ps)(&dv);
+
+    auto mixTarget = this->floatValue(rev1_mix);
+    auto lowcutOn = !this->isDeactivated(rev1_lowcut);
+    auto highcutOn = !this->isDeactivated(rev1_highcut);
+
+    while (nBlocks > 0)
+    {
+        // the b == 0 updates can change the taps, so they only land at the start of a span
+        int span = std::min({nBlocks, maxSpanBlocks, 32 - b});
+
+        if ((b == 0) && (fabs(this->floatValue(rev1_roomsize) - lastf[rev1_roomsize]) > 0.001f))
+            loadpreset(shape);
+
+        // do more seldom
+        if (b == 0)
+        {
+            band1.coeff_peakEQ(band1.calc_omega(this->floatValue(rev1_freq1) * (1.f / 12.f)), 2,
+                               this->floatValue(rev1_gain1));
+            locut.coeff_HP(locut.calc_omega(this->floatValue(rev1_lowcut) * (1.f / 12.f)), 0.5);
+            hicut.coeff_LP2B(hicut.calc_omega(this->floatValue(rev1_highcut) * (1.f / 12.f)),
+                             0.5);
+        }
+        b = (b + span) & 31;
+
+        // a chunk may not read anything it writes itself, and stays a multiple of 4 if it can
+        int chunk = maxChunk;
+        for (int t = 0; t < rev_taps; ++t)
+            chunk = std::min(chunk, (delay_time[t] >> 8) + 1);
+        if (chunk >= 4)
+            chunk &= ~3;
+        for (int k = 0; k < span * bs; k += chunk)
+        {
+            auto n = std::min(chunk, span * bs - k);
+            auto startPos = delay_pos;
+            readTaps(n);
+            TapArgs args{tapIn, tapOut, predelay, out_tap, delay_fb, delay_pan_L, delay_pan_R,
+                         &delay_pos, pdtime, dv, dataL + k, dataR + k, wetL + k, wetR + k, n};
+            effects_shared::DispatchedKernel<TapKernel>::get()(args);
+            writeTaps(startPos, n);
+        }
+
+        for (int i = 0; i < span; ++i)
+        {
+            auto wL = wetL + i * bs, wR = wetR + i * bs;
+
+            mix.set_target_smoothed(mixTarget);
+            this->setWidthTarget(widthS, widthM, rev1_width);
+
+            if (lowcutOn)
+            {
+                locut.process_block(wL, wR);
+            }
+
+            band1.process_block(wL, wR);
+
+            if (highcutOn)
+            {
+                hicut.process_block(wL, wR);
+            }
+
+            // scale width and mix
+            this->applyWidthAndMix(dataL, dataR, wL, wR, widthS, widthM, mix);
+            dataL += bs;
+            dataR += bs;
+        }
+        nBlocks -= span;
+    }
+}
+
+template <typename FXConfig>
+inline void Reverb1<FXConfig>::TapKernel::sse2(const typename Reverb1<FXConfig>::TapArgs &args)
+{
+    auto *tapIn = args.tapIn, *predelay = args.predelay, *out_tap = args.out_tap;
+    auto *tapOut = args.tapOut;
+    auto *delay_fb = args.delay_fb, *delay_pan_L = args.delay_pan_L,
+         *delay_pan_R = args.delay_pan_R;
+    auto *dataL = args.dataL, *dataR = args.dataR;
+    auto *wetL = args.wetL, *wetR = args.wetR;
+    auto pdtime = args.pdtime;
+    auto delay_pos = *args.delay_pos;
+
+    const auto one4 = SIMD_MM(set1_ps)(1.f);
+    auto damp4 = SIMD_MM(set1_ps)(args.damping);
     auto damp4m1 = SIMD_MM(sub_ps)(one4, damp4);
 
-    for (int k = 0; k < FXConfig::blockSize; k++)
+    for (int k = 0; k < args.n; k++)
     {
         for (int t = 0; t < rev_taps; t += 4)
         {
-            int dp = (delay_pos - (delay_time[t] >> 8));
-            // float newa = delay[t + ((dp & (max_rev_dly-1))<<rev_tap_bits)];
-            auto newa = SIMD_MM(load_ss)(&delay[t + ((dp & (max_rev_dly - 1)) << rev_tap_bits)]);
-            dp = (delay_pos - (delay_time[t + 1] >> 8));
-            auto newb =
-                SIMD_MM(load_ss)(&delay[t + 1 + ((dp & (max_rev_dly - 1)) << rev_tap_bits)]);
-            dp = (delay_pos - (delay_time[t + 2] >> 8));
-            newa = SIMD_MM(unpacklo_ps)(newa, newb); // a,b,0,0
-            auto newc =
-                SIMD_MM(load_ss)(&delay[t + 2 + ((dp & (max_rev_dly - 1)) << rev_tap_bits)]);
-            dp = (delay_pos - (delay_time[t + 3] >> 8));
-            auto newd =
-                SIMD_MM(load_ss)(&delay[t + 3 + ((dp & (max_rev_dly - 1)) << rev_tap_bits)]);
-            newc = SIMD_MM(unpacklo_ps)(newc, newd);    // c,d,0,0
-            auto new4 = SIMD_MM(movelh_ps)(newa, newc); // a,b,c,d
+            auto new4 = SIMD_MM(load_ps)(&tapIn[k * rev_taps + t]);
 
             auto out_tap4 = SIMD_MM(load_ps)(&out_tap[t]);
             out_tap4 =
@@ -305,7 +415,7 @@ inline void Reverb1<FXConfig>::processBlock(float *__restrict dataL, float *__re
             auto ot = SIMD_MM(load_ps)(&out_tap[t]);
             auto dfb = SIMD_MM(load_ps)(&delay_fb[t]);
             auto a = SIMD_MM(mul_ps)(dfb, SIMD_MM(add_ps)(fb4, ot));
-            SIMD_MM(store_ps)(&delay[(delay_pos << rev_tap_bits) + t], a);
+            SIMD_MM(store_ps)(&tapOut[k * rev_taps + t], a);
             L = SIMD_MM(add_ps)(L, SIMD_MM(mul_ps)(ot, SIMD_MM(load_ps)(&delay_pan_L[t])));
             R = SIMD_MM(add_ps)(R, SIMD_MM(mul_ps)(ot, SIMD_MM(load_ps)(&delay_pan_R[t])));
         }
@@ -314,23 +424,212 @@ inline void Reverb1<FXConfig>::processBlock(float *__restrict dataL, float *__re
         SIMD_MM(store_ss)(&wetL[k], L);
         SIMD_MM(store_ss)(&wetR[k], R);
     }
+    *args.delay_pos = delay_pos;
+}
+
+#if SST_EFFECTS_SIMD_DISPATCH_X86
+template <typename FXConfig>
+SST_EFFECTS_TARGET_AVX2 inline void
+Reverb1<FXConfig>::TapKernel::avx2(const typename Reverb1<FXConfig>::TapArgs &args)
+{
+    static_assert(rev_taps == 16);
+    auto delay_pos = *args.delay_pos;
+
+    const auto damp = _mm256_set1_ps(args.damping);
+    const auto dampm1 = _mm256_sub_ps(_mm256_set1_ps(1.f), damp);
+    const auto fb0 = _mm256_loadu_ps(args.delay_fb), fb1 = _mm256_loadu_ps(args.delay_fb + 8);
+    const auto pL0 = _mm256_loadu_ps(args.delay_pan_L), pL1 = _mm256_loadu_ps(args.delay_pan_L + 8);
+    const auto pR0 = _mm256_loadu_ps(args.delay_pan_R), pR1 = _mm256_loadu_ps(args.delay_pan_R + 8);
+    const auto ca = _mm_set_ss(((float)(-(2.f) / rev_taps)));
+
+    auto ot0 = _mm256_loadu_ps(args.out_tap), ot1 = _mm256_loadu_ps(args.out_tap + 8);
 
-    if (!this->isDeactivated(rev1_lowcut))
+    for (int k = 0; k < args.n; k++)
     {
-        locut.process_block(wetL, wetR);
+        auto n0 = _mm256_loadu_ps(&args.tapIn[k * rev_taps]);
+        auto n1 = _mm256_loadu_ps(&args.tapIn[k * rev_taps + 8]);
+
+        ot0 = _mm256_add_ps(_mm256_mul_ps(ot0, damp), _mm256_mul_ps(n0, dampm1));
+        ot1 = _mm256_add_ps(_mm256_mul_ps(ot1, damp), _mm256_mul_ps(n1, dampm1));
+
+        auto fbA = _mm_add_ps(_mm256_castps256_ps128(ot0), _mm256_extractf128_ps(ot0, 1));
+        auto fbB = _mm_add_ps(_mm256_castps256_ps128(ot1), _mm256_extractf128_ps(ot1, 1));
+        auto fb = _mm_add_ps(fbA, fbB);
+        fb = mech::sum_ps_to_ss(fb);
+        fb = _mm_add_ss(_mm_mul_ss(ca, fb),
+                        _mm_load_ss(&args.predelay[(delay_pos - args.pdtime) & (max_rev_dly - 1)]));
+
+        delay_pos = (delay_pos + 1) & (max_rev_dly - 1);
+
+        args.predelay[delay_pos] = 0.5f * (args.dataL[k] + args.dataR[k]);
+        auto fb8 = _mm256_broadcastss_ps(fb);
+
+        auto *dst = &args.tapOut[k * rev_taps];
+        _mm256_storeu_ps(dst, _mm256_mul_ps(fb0, _mm256_add_ps(fb8, ot0)));
+        _mm256_storeu_ps(dst + 8, _mm256_mul_ps(fb1, _mm256_add_ps(fb8, ot1)));
+
+        // ((0 + p0) + p1) + p2) + p3 in 4 wide pieces, as the sse2 loop sums them
+        auto l0 = _mm256_mul_ps(ot0, pL0), l1 = _mm256_mul_ps(ot1, pL1);
+        auto r0 = _mm256_mul_ps(ot0, pR0), r1 = _mm256_mul_ps(ot1, pR1);
+        auto L = _mm_add_ps(_mm_setzero_ps(), _mm256_castps256_ps128(l0));
+        auto R = _mm_add_ps(_mm_setzero_ps(), _mm256_castps256_ps128(r0));
+        L = _mm_add_ps(L, _mm256_extractf128_ps(l0, 1));
+        R = _mm_add_ps(R, _mm256_extractf128_ps(r0, 1));
+        L = _mm_add_ps(L, _mm256_castps256_ps128(l1));
+        R = _mm_add_ps(R, _mm256_castps256_ps128(r1));
+        L = _mm_add_ps(L, _mm256_extractf128_ps(l1, 1));
+        R = _mm_add_ps(R, _mm256_extractf128_ps(r1, 1));
+        _mm_store_ss(&args.wetL[k], mech::sum_ps_to_ss(L));
+        _mm_store_ss(&args.wetR[k], mech::sum_ps_to_ss(R));
+    }
+
+    _mm256_storeu_ps(args.out_tap, ot0);
+    _mm256_storeu_ps(args.out_tap + 8, ot1);
+    *args.delay_pos = delay_pos;
+}
+
+template <typename FXConfig>
+SST_EFFECTS_TARGET_AVX512 inline void
+Reverb1<FXConfig>::TapKernel::avx512(const typename Reverb1<FXConfig>::TapArgs &args)
+{
+    static_assert(rev_taps == 16);
+    auto delay_pos = *args.delay_pos;
+
+    const auto damp = _mm512_set1_ps(args.damping);
+    const auto dampm1 = _mm512_sub_ps(_mm512_set1_ps(1.f), damp);
+    const auto dfb = _mm512_loadu_ps(args.delay_fb);
+    const auto pL = _mm512_loadu_ps(args.delay_pan_L), pR = _mm512_loadu_ps(args.delay_pan_R);
+    const auto ca = _mm_set_ss(((float)(-(2.f) / rev_taps)));
+
+    auto ot = _mm512_loadu_ps(args.out_tap);
+
+    for (int k = 0; k < args.n; k++)
+    {
+        auto nw = _mm512_loadu_ps(&args.tapIn[k * rev_taps]);
+
+        ot = _mm512_add_ps(_mm512_mul_ps(ot, damp), _mm512_mul_ps(nw, dampm1));
+
+        auto fbA = _mm_add_ps(_mm512_extractf32x4_ps(ot, 0), _mm512_extractf32x4_ps(ot, 1));
+        auto fbB = _mm_add_ps(_mm512_extractf32x4_ps(ot, 2), _mm512_extractf32x4_ps(ot, 3));
+        auto fb = _mm_add_ps(fbA, fbB);
+        fb = mech::sum_ps_to_ss(fb);
+        fb = _mm_add_ss(_mm_mul_ss(ca, fb),
+                        _mm_load_ss(&args.predelay[(delay_pos - args.pdtime) & (max_rev_dly - 1)]));
+
+        delay_pos = (delay_pos + 1) & (max_rev_dly - 1);
+
+        args.predelay[delay_pos] = 0.5f * (args.dataL[k] + args.dataR[k]);
+        auto fb16 = _mm512_set1_ps(_mm_cvtss_f32(fb));
+
+        _mm512_storeu_ps(&args.tapOut[k * rev_taps], _mm512_mul_ps(dfb, _mm512_add_ps(fb16, ot)));
+
+        auto l = _mm512_mul_ps(ot, pL), r = _mm512_mul_ps(ot, pR);
+        auto L = _mm_add_ps(_mm_setzero_ps(), _mm512_extractf32x4_ps(l, 0));
+        auto R = _mm_add_ps(_mm_setzero_ps(), _mm512_extractf32x4_ps(r, 0));
+        L = _mm_add_ps(L, _mm512_extractf32x4_ps(l, 1));
+        R = _mm_add_ps(R, _mm512_extractf32x4_ps(r, 1));
+        L = _mm_add_ps(L, _mm512_extractf32x4_ps(l, 2));
+        R = _mm_add_ps(R, _mm512_extractf32x4_ps(r, 2));
+        L = _mm_add_ps(L, _mm512_extractf32x4_ps(l, 3));
+        R = _mm_add_ps(R, _mm512_extractf32x4_ps(r, 3));
+        _mm_store_ss(&args.wetL[k], mech::sum_ps_to_ss(L));
+        _mm_store_ss(&args.wetR[k], mech::sum_ps_to_ss(R));
     }
 
-    band1.process_block(wetL, wetR);
+    _mm512_storeu_ps(args.out_tap, ot);
+    *args.delay_pos = delay_pos;
+}
+#endif
+
+namespace details
+{
+// rows r0..r3 become columns
+inline void transpose4(SIMD_M128 &r0, SIMD_M128 &r1, SIMD_M128 &r2, SIMD_M128 &r3)
+{
+    auto t0 = SIMD_MM(unpacklo_ps)(r0, r1);
+    auto t1 = SIMD_MM(unpacklo_ps)(r2, r3);
+    auto t2 = SIMD_MM(unpackhi_ps)(r0, r1);
+    auto t3 = SIMD_MM(unpackhi_ps)(r2, r3);
+    r0 = SIMD_MM(movelh_ps)(t0, t1);
+    r1 = SIMD_MM(movehl_ps)(t1, t0);
+    r2 = SIMD_MM(movelh_ps)(t2, t3);
+    r3 = SIMD_MM(movehl_ps)(t3, t2);
+}
+} // namespace details
 
-    if (!this->isDeactivated(rev1_highcut))
+// tapIn[k * rev_taps + t] is tap t at delay_pos + k - (delay_time[t] >> 8)
+template <typename FXConfig> inline void Reverb1<FXConfig>::readTaps(int n)
+{
+    constexpr int mask = max_rev_dly - 1;
+    for (int t = 0; t < rev_taps; t += 4)
     {
-        hicut.process_block(wetL, wetR);
+        const float *line[4];
+        int pos[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            line[i] = delay + (t + i) * line_stride;
+            pos[i] = delay_pos - (delay_time[t + i] >> 8) - 1;
+        }
+
+        int k = 0;
+        for (; k + 4 <= n; k += 4)
+        {
+            int p[4];
+            bool wraps = false;
+            for (int i = 0; i < 4; ++i)
+            {
+                p[i] = (pos[i] + k) & mask;
+                wraps = wraps || (p[i] + 4 > max_rev_dly);
+            }
+            if (wraps)
+                break;
+
+            auto r0 = SIMD_MM(loadu_ps)(line[0] + p[0]);
+            auto r1 = SIMD_MM(loadu_ps)(line[1] + p[1]);
+            auto r2 = SIMD_MM(loadu_ps)(line[2] + p[2]);
+            auto r3 = SIMD_MM(loadu_ps)(line[3] + p[3]);
+            details::transpose4(r0, r1, r2, r3);
+            SIMD_MM(store_ps)(&tapIn[k * rev_taps + t], r0);
+            SIMD_MM(store_ps)(&tapIn[(k + 1) * rev_taps + t], r1);
+            SIMD_MM(store_ps)(&tapIn[(k + 2) * rev_taps + t], r2);
+            SIMD_MM(store_ps)(&tapIn[(k + 3) * rev_taps + t], r3);
+        }
+        for (; k < n; ++k)
+            for (int i = 0; i < 4; ++i)
+                tapIn[k * rev_taps + t + i] = line[i][(pos[i] + k) & mask];
     }
+}
 
-    // scale width
-    this->applyWidth(wetL, wetR, widthS, widthM);
+// tap t at startPos + 1 + k is tapOut[k * rev_taps + t]
+template <typename FXConfig> inline void Reverb1<FXConfig>::writeTaps(int startPos, int n)
+{
+    constexpr int mask = max_rev_dly - 1;
+    int k = 0;
+    for (; k + 4 <= n; k += 4)
+    {
+        auto p = (startPos + k) & mask;
+        if (p + 4 > max_rev_dly)
+            break;
 
-    mix.fade_2_blocks_inplace(dataL, wetL, dataR, wetR, this->blockSize_quad);
+        for (int t = 0; t < rev_taps; t += 4)
+        {
+            auto r0 = SIMD_MM(load_ps)(&tapOut[k * rev_taps + t]);
+            auto r1 = SIMD_MM(load_ps)(&tapOut[(k + 1) * rev_taps + t]);
+            auto r2 = SIMD_MM(load_ps)(&tapOut[(k + 2) * rev_taps + t]);
+            auto r3 = SIMD_MM(load_ps)(&tapOut[(k + 3) * rev_taps + t]);
+            details::transpose4(r0, r1, r2, r3);
+            SIMD_MM(storeu_ps)(delay + t * line_stride + p, r0);
+            SIMD_MM(storeu_ps)(delay + (t + 1) * line_stride + p, r1);
+            SIMD_MM(storeu_ps)(delay + (t + 2) * line_stride + p, r2);
+            SIMD_MM(storeu_ps)(delay + (t + 3) * line_stride + p, r3);
+        }
+    }
+    for (; k < n; ++k)
+    {
+        auto p = (startPos + k) & mask;
+        for (int t = 0; t < rev_taps; ++t)
+            delay[t * line_stride + p] = tapOut[k * rev_taps + t];
+    }
 }
 
 template <typename FXConfig> inline void Reverb1<FXConfig>::loadpreset(int id)
@@ -20,6 +20,8 @@
 #ifndef INCLUDE_SST_EFFECTS_REVERB2_H
 #define INCLUDE_SST_EFFECTS_REVERB2_H
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include "EffectCore.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
@@ -63,80 +65,83 @@ template <typename FXConfig> struct Reverb2 : core::EffectTemplateBase<FXConfig>
     static constexpr int NUM_BLOCKS = 4;
     static constexpr int NUM_INPUT_ALLPASSES = 4;
     static constexpr int NUM_ALLPASSES_PER_BLOCK = 2;
-    static constexpr int MAX_ALLPASS_LEN = 16384 * 8;
-    static constexpr int MAX_DELAY_LEN = 16384 * 8;
-    static constexpr int DELAY_LEN_MASK = MAX_DELAY_LEN - 1;
     static constexpr int DELAY_SUBSAMPLE_BITS = 8;
     static constexpr int DELAY_SUBSAMPLE_RANGE = (1 << DELAY_SUBSAMPLE_BITS);
-    static constexpr int PREDELAY_BUFFER_SIZE =
-        48000 * 8 * 4; // max sample rate is 48000 * 8 probably
     static constexpr int PREDELAY_BUFFER_SIZE_LIMIT =
         48000 * 8 * 3; // allow for one second of diffusion
 
+    /*
+     * The line lengths in ms at room size 0. Room size scales them by 2^room with
+     * room in [-1,1], so the buffers are sized for twice these at the current sample
+     * rate rather than for the worst case at any rate.
+     */
+    static constexpr float inputAllpassMs[NUM_INPUT_ALLPASSES]{4.76f, 6.81f, 10.13f, 16.72f};
+    static constexpr float allpassMs[NUM_BLOCKS][NUM_ALLPASSES_PER_BLOCK]{
+        {38.2f, 53.4f}, {44.0f, 41.f}, {48.3f, 60.5f}, {38.9f, 42.2f}};
+    static constexpr float delayMs[NUM_BLOCKS]{178.8f, 126.5f, 106.1f, 139.4f};
+    static constexpr float tapMsL[NUM_BLOCKS]{80.3f, 59.3f, 97.7f, 122.6f};
+    static constexpr float tapMsR[NUM_BLOCKS]{35.5f, 101.6f, 73.9f, 80.3f};
+    static constexpr float maxRoomScale{2.f};
+    static constexpr float maxModulationMs{5.f};
+    // pre-delay tops out at 2^1 = 2s; tempo sync stretches that by 120 / bpm, so
+    // leave room down to 30bpm. Longer taps clamp to the line as they always have.
+    static constexpr float maxPredelayParamSeconds{2.f};
+    static constexpr float predelayTemposyncHeadroom{4.f};
+    static constexpr float maxReachablePredelaySeconds{maxPredelayParamSeconds *
+                                                       predelayTemposyncHeadroom};
+
     class allpass
     {
       public:
         allpass();
         float process(float x, float coeff);
         void setLen(int len);
+        void setBuffer(float *data, int size);
 
       private:
         int _len;
         int _k;
-        float _data[MAX_ALLPASS_LEN];
-    };
-
-    class delay
-    {
-      public:
-        delay();
-        float process(float x, int tap1, float &tap_out1, int tap2, float &tap_out2,
-                      int modulation);
-        void setLen(int len);
-
-      private:
-        int _len;
-        int _k;
-        float _data[MAX_DELAY_LEN];
+        int _size;
+        float *_data;
     };
 
     class predelay
     {
       public:
-        predelay() { memset(_data, 0, PREDELAY_BUFFER_SIZE * sizeof(float)); }
         float process(float in, int tap)
         {
             k = (k + 1);
-            if (k == PREDELAY_BUFFER_SIZE)
+            if (k == _size)
                 k = 0;
             auto p = k - tap;
             while (p < 0)
-                p += PREDELAY_BUFFER_SIZE;
+                p += _size;
             auto res = _data[p];
             _data[k] = in;
             return res;
         }
+        void setBuffer(float *data, int size)
+        {
+            _data = data;
+            _size = size;
+            k = 0;
+        }
+        int size() const { return _size; }
 
       private:
         int k = 0;
-        float _data[PREDELAY_BUFFER_SIZE];
-    };
-
-    class onepole_filter
-    {
-      public:
-        onepole_filter();
-        float process_lowpass(float x, float c0);
-        float process_highpass(float x, float c0);
-
-      private:
-        float a0;
+        int _size = 1;
+        float *_data = nullptr;
     };
 
     Reverb2(typename FXConfig::GlobalStorage *s, typename FXConfig::EffectStorage *e,
             typename FXConfig::ValueStorage *p);
 
-    void initialize() { setvars(true); }
+    void initialize()
+    {
+        allocateBuffers();
+        setvars(true);
+    }
     void processBlock(float *__restrict L, float *__restrict R);
 
     void suspendProcessing() { initialize(); }
@@ -204,18 +209,43 @@ template <typename FXConfig> struct Reverb2 : core::EffectTemplateBase<FXConfig>
     void update_rtime();
     void setvars(bool);
     void calc_size(float);
+    void allocateBuffers();
+
+    core::EffectMemoryBlock<FXConfig> bufferMemory{this};
+    double bufferSampleRate{0};
 
     int ringout_time;
     allpass _input_allpass[NUM_INPUT_ALLPASSES];
-    allpass _allpass[NUM_BLOCKS][NUM_ALLPASSES_PER_BLOCK];
-    onepole_filter _hf_damper[NUM_BLOCKS];
-    onepole_filter _lf_damper[NUM_BLOCKS];
-    delay _delay[NUM_BLOCKS];
     predelay _predelay;
-    int _tap_timeL[NUM_BLOCKS];
-    int _tap_timeR[NUM_BLOCKS];
-    float _tap_gainL[NUM_BLOCKS];
-    float _tap_gainR[NUM_BLOCKS];
+
+    /*
+     * The four tank blocks run as the four lanes of a SIMD register. Each block reads
+     * its delay before writing it, so every block's delay output, and with it the input
+     * to the next block, is known at the top of the sample; the allpass, damper and
+     * delay chains of all four blocks then run side by side. The lines live in
+     * bufferMemory and each lane addresses its own by offset from the start, so the
+     * reads are gathers and the writes are scatters.
+     */
+    struct Tank
+    {
+        float *base{nullptr};
+        int apOffset alignas(16)[NUM_ALLPASSES_PER_BLOCK][NUM_BLOCKS]{};
+        int apSize alignas(16)[NUM_ALLPASSES_PER_BLOCK][NUM_BLOCKS]{};
+        int apLen alignas(16)[NUM_ALLPASSES_PER_BLOCK][NUM_BLOCKS]{};
+        int apK alignas(16)[NUM_ALLPASSES_PER_BLOCK][NUM_BLOCKS]{};
+        int dlOffset alignas(16)[NUM_BLOCKS]{};
+        int dlMask alignas(16)[NUM_BLOCKS]{};
+        int dlLen alignas(16)[NUM_BLOCKS]{};
+        int dlK alignas(16)[NUM_BLOCKS]{};
+        float hfDamp alignas(16)[NUM_BLOCKS]{};
+        float lfDamp alignas(16)[NUM_BLOCKS]{};
+    } _tank;
+    void processTank(const float *in, float *wetL, float *wetR);
+
+    int _tap_timeL alignas(16)[NUM_BLOCKS];
+    int _tap_timeR alignas(16)[NUM_BLOCKS];
+    float _tap_gainL alignas(16)[NUM_BLOCKS];
+    float _tap_gainR alignas(16)[NUM_BLOCKS];
     float _state;
     sdsp::lipol<float, FXConfig::blockSize, true> _decay_multiply;
     sdsp::lipol<float, FXConfig::blockSize, true> _diffusion;
@@ -260,16 +290,88 @@ Reverb2<FXConfig>::Reverb2(typename FXConfig::GlobalStorage *s, typename FXConfi
     _state = 0.f;
 }
 
+template <typename FXConfig> void Reverb2<FXConfig>::allocateBuffers()
+{
+    auto sr = this->sampleRate();
+    if (bufferMemory.data && sr == bufferSampleRate)
+        return;
+
+    auto apSize = [&](float ms) { return msToSamples(ms, maxRoomScale, sr) + 2; };
+    auto dlSize = [&](int b) {
+        auto ms = std::max({delayMs[b], tapMsL[b], tapMsR[b]}) * maxRoomScale + maxModulationMs;
+        auto len = msToSamples(ms, 1.f, sr) + 2;
+        int res = 1;
+        while (res < len)
+            res <<= 1;
+        return res;
+    };
+    int pdSize = std::min(PREDELAY_BUFFER_SIZE_LIMIT,
+                          (int)std::ceil(sr * maxReachablePredelaySeconds) + 1);
+
+    size_t total = pdSize;
+    for (int i = 0; i < NUM_INPUT_ALLPASSES; ++i)
+        total += apSize(inputAllpassMs[i]);
+    for (int b = 0; b < NUM_BLOCKS; ++b)
+    {
+        for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; ++c)
+            total += apSize(allpassMs[b][c]);
+        total += dlSize(b);
+    }
+
+    bufferMemory.resize(total * sizeof(float));
+    bufferSampleRate = sr;
+
+    auto *d = bufferMemory.template as<float>();
+    _tank.base = d;
+    for (int b = 0; b < NUM_BLOCKS; ++b)
+    {
+        auto sz = dlSize(b);
+        _tank.dlOffset[b] = (int)(d - _tank.base);
+        _tank.dlMask[b] = sz - 1;
+        _tank.dlLen[b] = std::clamp(_tank.dlLen[b], 0, sz - 1);
+        _tank.dlK[b] = 0;
+        d += sz;
+    }
+    for (int i = 0; i < NUM_INPUT_ALLPASSES; ++i)
+    {
+        auto sz = apSize(inputAllpassMs[i]);
+        _input_allpass[i].setBuffer(d, sz);
+        d += sz;
+    }
+    for (int b = 0; b < NUM_BLOCKS; ++b)
+    {
+        for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; ++c)
+        {
+            auto sz = apSize(allpassMs[b][c]);
+            _tank.apOffset[c][b] = (int)(d - _tank.base);
+            _tank.apSize[c][b] = sz;
+            _tank.apLen[c][b] = std::clamp(_tank.apLen[c][b], 0, sz - 1);
+            _tank.apK[c][b] = 0;
+            d += sz;
+        }
+    }
+    _predelay.setBuffer(d, pdSize);
+}
+
 template <typename FXConfig> Reverb2<FXConfig>::allpass::allpass()
 {
     _k = 0;
     _len = 1;
-    memset(_data, 0, MAX_ALLPASS_LEN * sizeof(float));
+    _size = 1;
+    _data = nullptr;
+}
+
+template <typename FXConfig> void Reverb2<FXConfig>::allpass::setBuffer(float *data, int size)
+{
+    _data = data;
+    _size = size;
+    _k = 0;
+    setLen(_len);
 }
 
 template <typename FXConfig> void Reverb2<FXConfig>::allpass::setLen(int len)
 {
-    _len = std::clamp(len, 0, MAX_ALLPASS_LEN - 1);
+    _len = std::clamp(len, 0, _size - 1);
 }
 
 template <typename FXConfig> float Reverb2<FXConfig>::allpass::process(float in, float coeff)
@@ -283,57 +385,6 @@ template <typename FXConfig> float Reverb2<FXConfig>::allpass::process(float in,
     return result;
 }
 
-template <typename FXConfig> Reverb2<FXConfig>::delay::delay()
-{
-    _k = 0;
-    _len = 1;
-    memset(_data, 0, MAX_DELAY_LEN * sizeof(float));
-}
-
-template <typename FXConfig> void Reverb2<FXConfig>::delay::setLen(int len)
-{
-    _len = std::clamp(len, 0, MAX_DELAY_LEN - 1);
-}
-
-template <typename FXConfig>
-float Reverb2<FXConfig>::delay::process(float in, int tap1, float &tap_out1, int tap2,
-                                        float &tap_out2, int modulation)
-{
-    _k = (_k + 1) & DELAY_LEN_MASK;
-
-    tap_out1 = _data[(_k - tap1) & DELAY_LEN_MASK];
-    tap_out2 = _data[(_k - tap2) & DELAY_LEN_MASK];
-
-    int modulation_int = modulation >> DELAY_SUBSAMPLE_BITS;
-    int modulation_frac1 = modulation & (DELAY_SUBSAMPLE_RANGE - 1);
-    int modulation_frac2 = DELAY_SUBSAMPLE_RANGE - modulation_frac1;
-
-    float d1 = _data[(_k - _len + modulation_int + 1) & DELAY_LEN_MASK];
-    float d2 = _data[(_k - _len + modulation_int) & DELAY_LEN_MASK];
-    const float multiplier = 1.f / (float)(DELAY_SUBSAMPLE_RANGE);
-
-    float result = (d1 * (float)modulation_frac1 + d2 * (float)modulation_frac2) * multiplier;
-    _data[_k] = in;
-
-    return result;
-}
-
-template <typename FXConfig> Reverb2<FXConfig>::onepole_filter::onepole_filter() { a0 = 0.f; }
-
-template <typename FXConfig>
-float Reverb2<FXConfig>::onepole_filter::process_lowpass(float x, float c0)
-{
-    a0 = a0 * c0 + x * (1.f - c0);
-    return a0;
-}
-
-template <typename FXConfig>
-float Reverb2<FXConfig>::onepole_filter::process_highpass(float x, float c0)
-{
-    a0 = a0 * (1.f - c0) + x * c0;
-    return x - a0;
-}
-
 template <typename FXConfig> void Reverb2<FXConfig>::update_rtime()
 {
     auto ts = this->temposyncRatio(rev2_predelay);
@@ -350,35 +401,22 @@ template <typename FXConfig> void Reverb2<FXConfig>::calc_size(float scale)
     float m = scale;
 
     auto sr = this->sampleRate();
-    _tap_timeL[0] = msToSamples(80.3, m, sr);
-    _tap_timeL[1] = msToSamples(59.3, m, sr);
-    _tap_timeL[2] = msToSamples(97.7, m, sr);
-    _tap_timeL[3] = msToSamples(122.6, m, sr);
-    _tap_timeR[0] = msToSamples(35.5, m, sr);
-    _tap_timeR[1] = msToSamples(101.6, m, sr);
-    _tap_timeR[2] = msToSamples(73.9, m, sr);
-    _tap_timeR[3] = msToSamples(80.3, m, sr);
-
-    _input_allpass[0].setLen(msToSamples(4.76, m, sr));
-    _input_allpass[1].setLen(msToSamples(6.81, m, sr));
-    _input_allpass[2].setLen(msToSamples(10.13, m, sr));
-    _input_allpass[3].setLen(msToSamples(16.72, m, sr));
-
-    _allpass[0][0].setLen(msToSamples(38.2, m, sr));
-    _allpass[0][1].setLen(msToSamples(53.4, m, sr));
-    _delay[0].setLen(msToSamples(178.8, m, sr));
-
-    _allpass[1][0].setLen(msToSamples(44.0, m, sr));
-    _allpass[1][1].setLen(msToSamples(41, m, sr));
-    _delay[1].setLen(msToSamples(126.5, m, sr));
-
-    _allpass[2][0].setLen(msToSamples(48.3, m, sr));
-    _allpass[2][1].setLen(msToSamples(60.5, m, sr));
-    _delay[2].setLen(msToSamples(106.1, m, sr));
-
-    _allpass[3][0].setLen(msToSamples(38.9, m, sr));
-    _allpass[3][1].setLen(msToSamples(42.2, m, sr));
-    _delay[3].setLen(msToSamples(139.4, m, sr));
+    for (int b = 0; b < NUM_BLOCKS; ++b)
+    {
+        _tap_timeL[b] = msToSamples(tapMsL[b], m, sr);
+        _tap_timeR[b] = msToSamples(tapMsR[b], m, sr);
+    }
+
+    for (int i = 0; i < NUM_INPUT_ALLPASSES; ++i)
+        _input_allpass[i].setLen(msToSamples(inputAllpassMs[i], m, sr));
+
+    for (int b = 0; b < NUM_BLOCKS; ++b)
+    {
+        for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; ++c)
+            _tank.apLen[c][b] =
+                std::clamp(msToSamples(allpassMs[b][c], m, sr), 0, _tank.apSize[c][b] - 1);
+        _tank.dlLen[b] = std::clamp(msToSamples(delayMs[b], m, sr), 0, _tank.dlMask[b]);
+    }
 }
 
 template <typename FXConfig> void Reverb2<FXConfig>::setvars(bool init)
@@ -398,6 +436,16 @@ template <typename FXConfig> void Reverb2<FXConfig>::setvars(bool init)
 
 template <typename FXConfig> void Reverb2<FXConfig>::processBlock(float *dataL, float *dataR)
 {
+    auto profile = this->processProfileScope(streamingName);
+    // initialize() and onSampleRateChanged() size the buffers. Until they have run at
+    // this rate, output silence rather than allocate on the audio thread.
+    if (bufferSampleRate != this->sampleRate())
+    {
+        mech::clear_block<FXConfig::blockSize>(dataL);
+        mech::clear_block<FXConfig::blockSize>(dataR);
+        return;
+    }
+
     float scale = powf(2.f, 1.f * this->floatValue(rev2_room_size));
     calc_size(scale);
 
@@ -426,8 +474,9 @@ template <typename FXConfig> void Reverb2<FXConfig>::processBlock(float *dataL,
 
     int pdt = std::clamp((int)(this->sampleRate() * pow(2.f, this->floatValue(rev2_predelay)) *
                                this->temposyncRatioInv(rev2_predelay)),
-                         1, PREDELAY_BUFFER_SIZE_LIMIT - 1);
+                         1, _predelay.size() - 1);
 
+    float tankIn alignas(16)[FXConfig::blockSize];
     for (int k = 0; k < FXConfig::blockSize; k++)
     {
         float in = (dataL[k] + dataR[k]) * 0.5f;
@@ -438,55 +487,147 @@ template <typename FXConfig> void Reverb2<FXConfig>::processBlock(float *dataL,
         in = _input_allpass[1].process(in, _diffusion.v);
         in = _input_allpass[2].process(in, _diffusion.v);
         in = _input_allpass[3].process(in, _diffusion.v);
-        float x = _state;
+        tankIn[k] = in;
+        _diffusion.process();
+    }
 
-        float outL = 0.f;
-        float outR = 0.f;
+    processTank(tankIn, wetL, wetR);
 
-        float lfos[NUM_BLOCKS];
-        lfos[0] = _lfo.r;
-        lfos[1] = _lfo.i;
-        lfos[2] = -_lfo.r;
-        lfos[3] = -_lfo.i;
+    // scale width and mix
+    this->applyWidthAndMix(dataL, dataR, wetL, wetR, widthS, widthM, mix);
+}
 
-        auto hdc = std::clamp(_hf_damp_coefficent.v, 0.01f, 0.99f);
-        auto ldc = std::clamp(_lf_damp_coefficent.v, 0.01f, 0.99f);
-        for (int b = 0; b < NUM_BLOCKS; b++)
+template <typename FXConfig>
+inline void Reverb2<FXConfig>::processTank(const float *in, float *wetL, float *wetR)
+{
+    static_assert(NUM_BLOCKS == 4, "The tank runs one block per SIMD lane");
+    auto &t = _tank;
+    auto *base = t.base;
+
+    auto gather = [base](SIMD_M128I idx) {
+        int i alignas(16)[4];
+        SIMD_MM(store_si128)((SIMD_M128I *)i, idx);
+        return SIMD_MM(setr_ps)(base[i[0]], base[i[1]], base[i[2]], base[i[3]]);
+    };
+    auto scatter = [base](SIMD_M128I idx, SIMD_M128 v) {
+        int i alignas(16)[4];
+        float f alignas(16)[4];
+        SIMD_MM(store_si128)((SIMD_M128I *)i, idx);
+        SIMD_MM(store_ps)(f, v);
+        base[i[0]] = f[0];
+        base[i[1]] = f[1];
+        base[i[2]] = f[2];
+        base[i[3]] = f[3];
+    };
+
+    const auto one = SIMD_MM(set1_ps)(1.f);
+    const auto onei = SIMD_MM(set1_epi32)(1);
+    const auto fracMask = SIMD_MM(set1_epi32)(DELAY_SUBSAMPLE_RANGE - 1);
+    const auto range = SIMD_MM(set1_epi32)(DELAY_SUBSAMPLE_RANGE);
+    const auto rangef = SIMD_MM(set1_ps)((float)DELAY_SUBSAMPLE_RANGE);
+    const auto multiplier = SIMD_MM(set1_ps)(1.f / (float)(DELAY_SUBSAMPLE_RANGE));
+
+    SIMD_M128I apOffset[NUM_ALLPASSES_PER_BLOCK], apLen[NUM_ALLPASSES_PER_BLOCK],
+        apK[NUM_ALLPASSES_PER_BLOCK];
+    for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; ++c)
+    {
+        apOffset[c] = SIMD_MM(load_si128)((const SIMD_M128I *)t.apOffset[c]);
+        apLen[c] = SIMD_MM(load_si128)((const SIMD_M128I *)t.apLen[c]);
+        apK[c] = SIMD_MM(load_si128)((const SIMD_M128I *)t.apK[c]);
+    }
+    const auto dlOffset = SIMD_MM(load_si128)((const SIMD_M128I *)t.dlOffset);
+    const auto dlMask = SIMD_MM(load_si128)((const SIMD_M128I *)t.dlMask);
+    const auto dlLen = SIMD_MM(load_si128)((const SIMD_M128I *)t.dlLen);
+    const auto tapL = SIMD_MM(load_si128)((const SIMD_M128I *)_tap_timeL);
+    const auto tapR = SIMD_MM(load_si128)((const SIMD_M128I *)_tap_timeR);
+    const auto gainL = SIMD_MM(load_ps)(_tap_gainL);
+    const auto gainR = SIMD_MM(load_ps)(_tap_gainR);
+    auto dlK = SIMD_MM(load_si128)((const SIMD_M128I *)t.dlK);
+    auto hf = SIMD_MM(load_ps)(t.hfDamp);
+    auto lf = SIMD_MM(load_ps)(t.lfDamp);
+    auto state = SIMD_MM(set_ss)(_state);
+
+    // the lf damping is held for the block, as it always has been
+    const auto ldc = SIMD_MM(set1_ps)(std::clamp(_lf_damp_coefficent.v, 0.01f, 0.99f));
+    const auto ldcm1 = SIMD_MM(sub_ps)(one, ldc);
+
+    for (int k = 0; k < FXConfig::blockSize; k++)
+    {
+        auto hdc = SIMD_MM(set1_ps)(std::clamp(_hf_damp_coefficent.v, 0.01f, 0.99f));
+        auto hdcm1 = SIMD_MM(sub_ps)(one, hdc);
+        auto buildup = SIMD_MM(set1_ps)(_buildup.v);
+        auto lfos = SIMD_MM(setr_ps)(_lfo.r, _lfo.i, -_lfo.r, -_lfo.i);
+
+        dlK = SIMD_MM(and_si128)(SIMD_MM(add_epi32)(dlK, onei), dlMask);
+
+        // the taps and the modulated read, all before any block writes
+        auto iL = SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(dlK, tapL), dlMask);
+        auto iR = SIMD_MM(and_si128)(SIMD_MM(sub_epi32)(dlK, tapR), dlMask);
+        auto outL4 = SIMD_MM(mul_ps)(gather(SIMD_MM(add_epi32)(iL, dlOffset)), gainL);
+        auto outR4 = SIMD_MM(mul_ps)(gather(SIMD_MM(add_epi32)(iR, dlOffset)), gainR);
+
+        auto modulation = SIMD_MM(cvttps_epi32)(
+            SIMD_MM(mul_ps)(SIMD_MM(mul_ps)(SIMD_MM(set1_ps)(_modulation.v), lfos), rangef));
+        auto modInt = SIMD_MM(srai_epi32)(modulation, DELAY_SUBSAMPLE_BITS);
+        auto frac1 = SIMD_MM(and_si128)(modulation, fracMask);
+        auto frac2 = SIMD_MM(sub_epi32)(range, frac1);
+        auto i2 = SIMD_MM(add_epi32)(SIMD_MM(sub_epi32)(dlK, dlLen), modInt);
+        auto i1 = SIMD_MM(and_si128)(SIMD_MM(add_epi32)(i2, onei), dlMask);
+        i2 = SIMD_MM(and_si128)(i2, dlMask);
+        auto d1 = gather(SIMD_MM(add_epi32)(i1, dlOffset));
+        auto d2 = gather(SIMD_MM(add_epi32)(i2, dlOffset));
+        auto dout = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(d1, SIMD_MM(cvtepi32_ps)(frac1)),
+                                    SIMD_MM(mul_ps)(d2, SIMD_MM(cvtepi32_ps)(frac2)));
+        dout = SIMD_MM(mul_ps)(dout, multiplier);
+
+        // block b is fed by block b - 1 and block 0 by the last sample of block 3
+        auto fed = SIMD_MM(mul_ps)(dout, SIMD_MM(set1_ps)(_decay_multiply.v));
+        auto rot = SIMD_MM(shuffle_ps)(fed, fed, SIMD_MM_SHUFFLE(2, 1, 0, 3));
+        auto x = SIMD_MM(add_ps)(SIMD_MM(move_ss)(rot, state), SIMD_MM(set1_ps)(in[k]));
+        state = rot;
+
+        for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; c++)
         {
-            x = x + in;
-            for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; c++)
-            {
-                x = _allpass[b][c].process(x, _buildup.v);
-            }
-
-            x = _hf_damper[b].process_lowpass(x, hdc);
-            x = _lf_damper[b].process_highpass(x, ldc);
-
-            int modulation = (int)(_modulation.v * lfos[b] * (float)DELAY_SUBSAMPLE_RANGE);
-            float tap_outL = 0.f;
-            float tap_outR = 0.f;
-            x = _delay[b].process(x, _tap_timeL[b], tap_outL, _tap_timeR[b], tap_outR, modulation);
-            outL += tap_outL * _tap_gainL[b];
-            outR += tap_outR * _tap_gainR[b];
-
-            x *= _decay_multiply.v;
+            apK[c] = SIMD_MM(add_epi32)(apK[c], onei);
+            apK[c] = SIMD_MM(and_si128)(apK[c], SIMD_MM(cmplt_epi32)(apK[c], apLen[c]));
+            auto idx = SIMD_MM(add_epi32)(apK[c], apOffset[c]);
+            auto d = gather(idx);
+            auto delay_in = SIMD_MM(sub_ps)(x, SIMD_MM(mul_ps)(buildup, d));
+            x = SIMD_MM(add_ps)(d, SIMD_MM(mul_ps)(buildup, delay_in));
+            scatter(idx, delay_in);
         }
 
+        hf = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(hf, hdc), SIMD_MM(mul_ps)(x, hdcm1));
+        lf = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(lf, ldcm1), SIMD_MM(mul_ps)(hf, ldc));
+        x = SIMD_MM(sub_ps)(hf, lf);
+        scatter(SIMD_MM(add_epi32)(dlK, dlOffset), x);
+
+        // sum the taps in block order
+        float oL alignas(16)[4], oR alignas(16)[4];
+        SIMD_MM(store_ps)(oL, outL4);
+        SIMD_MM(store_ps)(oR, outR4);
+        float outL = 0.f, outR = 0.f;
+        for (int b = 0; b < NUM_BLOCKS; ++b)
+        {
+            outL += oL[b];
+            outR += oR[b];
+        }
         wetL[k] = outL;
         wetR[k] = outR;
-        _state = x;
+
         _decay_multiply.process();
-        _diffusion.process();
         _buildup.process();
         _hf_damp_coefficent.process();
         _lfo.process();
         _modulation.process();
     }
 
-    // scale width
-    this->applyWidth(wetL, wetR, widthS, widthM);
-
-    mix.fade_2_blocks_inplace(dataL, wetL, dataR, wetR);
+    for (int c = 0; c < NUM_ALLPASSES_PER_BLOCK; ++c)
+        SIMD_MM(store_si128)((SIMD_M128I *)t.apK[c], apK[c]);
+    SIMD_MM(store_si128)((SIMD_M128I *)t.dlK, dlK);
+    SIMD_MM(store_ps)(t.hfDamp, hf);
+    SIMD_MM(store_ps)(t.lfDamp, lf);
+    _state = SIMD_MM(cvtss_f32)(state);
 }
 
 } // namespace sst::effects::reverb2
@@ -22,6 +22,7 @@
 #define INCLUDE_SST_EFFECTS_ROTARYSPEAKER_H
 
 #include "sst/waveshapers.h"
+#include <cmath>
 #include <cstring>
 #include "EffectCore.h"
 #include "sst/basic-blocks/params/ParamMetadata.h"
@@ -32,6 +33,7 @@
 #include "sst/basic-blocks/mechanics/simd-ops.h"
 #include "sst/basic-blocks/dsp/QuadratureOscillators.h"
 #include "sst/basic-blocks/tables/SincTableProvider.h"
+#include "sst/effects-shared/SIMDKernels.h"
 
 namespace sst::effects::rotaryspeaker
 {
@@ -132,8 +134,16 @@ template <typename FXConfig> struct RotarySpeaker : core::EffectTemplateBase<FXC
     };
 
   protected:
-    static constexpr int maxDelayLength{1 << 18};
-    float buffer[maxDelayLength];
+    /*
+     * The horn delay is at most doppler (0..1) * 1.8ms * the horn to ear distance,
+     * which is under 4, so the line is sized for that at the current sample rate
+     * rather than a fixed 2^18 samples, plus FIRipol_N samples mirroring its start.
+     */
+    static constexpr float maxHornDelaySeconds{0.0018f * 4.f};
+    void allocateBuffer();
+    int maxDelayLength{0};
+    float *buffer{nullptr};
+    core::EffectMemoryBlock<FXConfig> bufferMemory{this};
     int wpos;
     // filter *lp[2],*hp[2];
     // biquadunit rotor_lpL,rotor_lpR;
@@ -159,9 +169,23 @@ template <typename FXConfig> struct RotarySpeaker : core::EffectTemplateBase<FXC
     }
 };
 
+template <typename FXConfig> inline void RotarySpeaker<FXConfig>::allocateBuffer()
+{
+    auto samples = (int)std::ceil(maxHornDelaySeconds * this->sampleRate()) +
+                   sincTable.FIRipol_N + FXConfig::blockSize + 1;
+    int len{FXConfig::blockSize};
+    while (len < samples)
+        len <<= 1;
+
+    maxDelayLength = len;
+    if (!bufferMemory.resize((maxDelayLength + sincTable.FIRipol_N) * sizeof(float)))
+        bufferMemory.clear();
+    buffer = bufferMemory.template as<float>();
+}
+
 template <typename FXConfig> inline void RotarySpeaker<FXConfig>::initialize()
 {
-    memset(buffer, 0, maxDelayLength * sizeof(float));
+    allocateBuffer();
 
     wpos = 0;
 
@@ -207,6 +231,10 @@ template <typename FXConfig> inline void RotarySpeaker<FXConfig>::processOnlyCon
 template <typename FXConfig>
 inline void RotarySpeaker<FXConfig>::processBlock(float *__restrict dataL, float *__restrict dataR)
 {
+    auto profile = this->processProfileScope(streamingName);
+    // initialize() sizes the line; this only catches hosts which process first
+    if (!buffer)
+        initialize();
     setvars(false);
 
     double frate = this->floatValue(rot_horn_rate) * this->temposyncRatio(rot_horn_rate);
@@ -369,6 +397,15 @@ inline void RotarySpeaker<FXConfig>::processBlock(float *__restrict dataL, float
 
     xover.process_block(lower);
 
+    /*
+     * The horn reads are at least a block old, so write the whole block into the line
+     * first and then interpolate it in one go. The line mirrors its first FIRipol_N
+     * samples past its end so every sinc window is contiguous.
+     */
+    constexpr int N{sst::basic_blocks::tables::SurgeSincTableProvider::FIRipol_N};
+    const int maxDTime = maxDelayLength - N - FXConfig::blockSize - 1;
+    int rpLs[FXConfig::blockSize], rpRs[FXConfig::blockSize];
+    int sincLs[FXConfig::blockSize], sincRs[FXConfig::blockSize];
     for (k = 0; k < FXConfig::blockSize; k++)
     {
         // feed delay input
@@ -376,37 +413,33 @@ inline void RotarySpeaker<FXConfig>::processBlock(float *__restrict dataL, float
         lower_sub[k] = lower[k];
         upper[k] -= lower[k];
         buffer[wp] = upper[k];
+        if (wp < N)
+            buffer[wp + maxDelayLength] = upper[k];
 
-        int i_dtimeL = std::max<int>(FXConfig::blockSize,
-                                     std::min((int)dL.v, maxDelayLength - sincTable.FIRipol_N - 1));
-        int i_dtimeR = std::max<int>(FXConfig::blockSize,
-                                     std::min((int)dR.v, maxDelayLength - sincTable.FIRipol_N - 1));
+        int i_dtimeL = std::max<int>(FXConfig::blockSize, std::min((int)dL.v, maxDTime));
+        int i_dtimeR = std::max<int>(FXConfig::blockSize, std::min((int)dR.v, maxDTime));
 
-        int rpL = (wpos - i_dtimeL + k);
-        int rpR = (wpos - i_dtimeR + k);
+        // the window for output k is the N samples ending at wpos + k - i_dtime
+        rpLs[k] = (wpos - i_dtimeL + k - N + 1) & (maxDelayLength - 1);
+        rpRs[k] = (wpos - i_dtimeR + k - N + 1) & (maxDelayLength - 1);
 
         assert(sincTable.FIRipol_M - 1 > 0);
-        int sincL = sincTable.FIRipol_N *
-                    std::clamp((int)(sincTable.FIRipol_M * (float(i_dtimeL + 1) - dL.v)), 0,
-                               sincTable.FIRipol_M - 1);
-        int sincR = sincTable.FIRipol_N *
-                    std::clamp((int)(sincTable.FIRipol_M * (float(i_dtimeR + 1) - dR.v)), 0,
-                               sincTable.FIRipol_M - 1);
-
-        // get delay output
-        tbufferL[k] = 0;
-        tbufferR[k] = 0;
-        for (int i = 0; i < sincTable.FIRipol_N; i++)
-        {
-            tbufferL[k] += buffer[(rpL - i) & (maxDelayLength - 1)] *
-                           sincTable.sinctable1X[sincL + sincTable.FIRipol_N - i];
-            tbufferR[k] += buffer[(rpR - i) & (maxDelayLength - 1)] *
-                           sincTable.sinctable1X[sincR + sincTable.FIRipol_N - i];
-        }
+        // the scalar reference ran the window backwards against table[sinc + N - i]
+        sincLs[k] = 1 + N * std::clamp((int)(sincTable.FIRipol_M * (float(i_dtimeL + 1) - dL.v)),
+                                       0, sincTable.FIRipol_M - 1);
+        sincRs[k] = 1 + N * std::clamp((int)(sincTable.FIRipol_M * (float(i_dtimeR + 1) - dR.v)),
+                                       0, sincTable.FIRipol_M - 1);
+
         dL.process();
         dR.process();
     }
 
+    // get delay output
+    namespace kern = sst::effects_shared::kernels;
+    kern::dispatch<kern::SincReadBlock2<N>>(sincTable.sinctable1X, sincLs, sincRs, buffer, buffer,
+                                            rpLs, rpRs, tbufferL, tbufferR,
+                                            (int)FXConfig::blockSize);
+
     lowbass.process_block(lower_sub);
 
     for (k = 0; k < FXConfig::blockSize; k++)
@@ -423,10 +456,8 @@ inline void RotarySpeaker<FXConfig>::processBlock(float *__restrict dataL, float
         hornamp[1].process();
     }
 
-    // scale width
-    this->applyWidth(wbL, wbR, widthS, widthM);
-
-    mix.fade_2_blocks_inplace(dataL, wbL, dataR, wbR, FXConfig::blockSize >> 2);
+    // scale width and mix
+    this->applyWidthAndMix(dataL, dataR, wbL, wbR, widthS, widthM, mix);
 
     wpos += FXConfig::blockSize;
     wpos = wpos & (maxDelayLength - 1);
@@ -73,6 +73,7 @@ struct TreeMonster
 
     void processBlock(float *__restrict L, float *__restrict R)
     {
+        auto profile = this->processProfileScope(streamingName);
         this->processWithMixAndWidth(L, R);
     }
 
@@ -31,6 +31,7 @@
 #include "sst/basic-blocks/dsp/BlockInterpolators.h"
 #include "sst/filters/BiquadFilter.h"
 #include "sst/filters/CytomicSVF.h"
+#include "sst/effects-shared/RingoutTracker.h"
 
 #include <type_traits>
 #include <concepts>
@@ -88,6 +89,9 @@ template <VoiceEffectConfig VFXConfig> struct VoiceEffectTemplateBase : public V
     using config_t = VFXConfig;
     // All core constraints are now enforced by the VoiceEffectConfig concept
 
+    // Hosts can use this to skip processing once an effect has rung out
+    using RingoutTracker = effects_shared::RingoutTracker<VFXConfig::blockSize>;
+
     typename VFXConfig::BaseClass *asBase()
     {
         return static_cast<typename VFXConfig::BaseClass *>(this);
@@ -194,9 +198,42 @@ template <VoiceEffectConfig VFXConfig> struct VoiceEffectTemplateBase : public V
     HASMEM(isDeactivated, bool getIsDeactivated(int index), return false, (asBase(), index));
     HASMEM(preReserveSingleInstancePool, void preReserveSingleInstancePool(size_t s),
            throw std::logic_error("this effect requires single instance pools"), (asBase(), s));
+    HASMEM(onProcessBegin, void processProfileBegin(const char *n), return, (asBase(), n));
+    HASMEM(onProcessEnd, void processProfileEnd(const char *n), return, (asBase(), n));
 
 #undef HASMEM
 
+    /*
+     * A VFXConfig may optionally provide static
+     *   void onProcessBegin(BaseClass *, const char *streamingName);
+     *   void onProcessEnd(BaseClass *, const char *streamingName);
+     * which effects call around processStereo / processMonoToStereo / processMonoToMono
+     * by opening this scope at the top of the call. Without the hooks the scope is empty.
+     */
+    template <bool hasHooks, typename D = void> struct ProcessProfileScope
+    {
+        ProcessProfileScope(VoiceEffectTemplateBase *, const char *) {}
+        ~ProcessProfileScope() {} // user provided so an unused scope doesn't warn
+    };
+    template <typename D> struct ProcessProfileScope<true, D>
+    {
+        VoiceEffectTemplateBase *that;
+        const char *name;
+        ProcessProfileScope(VoiceEffectTemplateBase *t, const char *n) : that(t), name(n)
+        {
+            that->processProfileBegin(name);
+        }
+        ~ProcessProfileScope() { that->processProfileEnd(name); }
+        ProcessProfileScope(const ProcessProfileScope &) = delete;
+        ProcessProfileScope &operator=(const ProcessProfileScope &) = delete;
+    };
+
+    auto processProfileScope(const char *streamingName)
+    {
+        return ProcessProfileScope<has_onProcessBegin<VFXConfig>::value ||
+                                   has_onProcessEnd<VFXConfig>::value>(this, streamingName);
+    }
+
     using BiquadFilterType =
         sst::filters::Biquad::BiquadFilter<VoiceEffectTemplateBase<VFXConfig>, VFXConfig::blockSize,
                                            VoiceEffectTemplateBase<VFXConfig>>;
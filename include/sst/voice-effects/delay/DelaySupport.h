@@ -22,7 +22,9 @@
 #define INCLUDE_SST_VOICE_EFFECTS_DELAY_DELAYSUPPORT_H
 
 #include "sst/basic-blocks/dsp/SSESincDelayLine.h"
+#include "sst/basic-blocks/mechanics/simd-ops.h"
 #include <cassert>
+#include <cstring>
 
 namespace sst::voice_effects::delay::details
 {
@@ -204,6 +206,85 @@ template <template <int N> typename lineType> struct DelayLineSupport
                      nullptr, nullptr, nullptr, nullptr};
 };
 
+/*
+ * Two sinc interpolated lines of the same length sharing a write position, for the two
+ * strings of a resonator. Each line reads as SSESincDelayLine::read does, but a paired read
+ * runs both dot products side by side and sums them in one reduction. A user which only
+ * needs one line reads and writes the first.
+ */
+template <int COMB_SIZE> struct PairedSincDelayLine
+{
+    using SincTable = sst::basic_blocks::tables::SurgeSincTableProvider;
+    static constexpr int FIRipol_N{SincTable::FIRipol_N};
+    static_assert(FIRipol_N % 4 == 0);
+
+    float buffer alignas(16)[2][COMB_SIZE + FIRipol_N];
+    int wp{0};
+    const SincTable &st;
+
+    PairedSincDelayLine(const SincTable &st) : st(st) { clear(); }
+
+    void clear()
+    {
+        memset(buffer, 0, sizeof(buffer));
+        wp = 0;
+    }
+
+    void write(float one, float two)
+    {
+        buffer[0][wp] = one;
+        buffer[1][wp] = two;
+        if (wp < FIRipol_N)
+        {
+            buffer[0][wp + COMB_SIZE] = one;
+            buffer[1][wp + COMB_SIZE] = two;
+        }
+        wp = (wp + 1) & (COMB_SIZE - 1);
+    }
+
+    void write(float one)
+    {
+        buffer[0][wp] = one;
+        if (wp < FIRipol_N)
+            buffer[0][wp + COMB_SIZE] = one;
+        wp = (wp + 1) & (COMB_SIZE - 1);
+    }
+
+    float read(float delay)
+    {
+        return SIMD_MM(cvtss_f32)(sst::basic_blocks::mechanics::sum_ps_to_ss(dot(0, delay)));
+    }
+
+    void read(float delayOne, float delayTwo, float &one, float &two)
+    {
+        auto a = dot(0, delayOne);
+        auto b = dot(1, delayTwo);
+
+        // a0+a2 b0+b2 a1+a3 b1+b3, then fold the top pair down
+        auto s = SIMD_MM(add_ps)(SIMD_MM(unpacklo_ps)(a, b), SIMD_MM(unpackhi_ps)(a, b));
+        s = SIMD_MM(add_ps)(s, SIMD_MM(movehl_ps)(s, s));
+        one = SIMD_MM(cvtss_f32)(s);
+        two = SIMD_MM(cvtss_f32)(SIMD_MM(shuffle_ps)(s, s, SIMD_MM_SHUFFLE(1, 1, 1, 1)));
+    }
+
+  protected:
+    SIMD_M128 dot(int line, float delay)
+    {
+        auto iDelay = (int)delay;
+        auto fracDelay = delay - iDelay;
+        auto so = (int)((1 - fracDelay) * SincTable::FIRipol_M) * FIRipol_N * 2;
+        auto rp = (wp - iDelay - (FIRipol_N >> 1)) & (COMB_SIZE - 1);
+
+        auto *t = st.sinctable + so;
+        auto *b = buffer[line] + rp;
+        auto acc = SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(t), SIMD_MM(loadu_ps)(b));
+        for (int i = 4; i < FIRipol_N; i += 4)
+            acc = SIMD_MM(add_ps)(
+                acc, SIMD_MM(mul_ps)(SIMD_MM(loadu_ps)(t + i), SIMD_MM(loadu_ps)(b + i)));
+        return acc;
+    }
+};
+
 struct quadDelayLineSupport
 {
   protected:
@@ -298,6 +298,7 @@ template <typename VFXConfig> struct MicroGate : core::VoiceEffectTemplateBase<V
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         lineSupport[0].dispatch(recSize, [&](auto N) {
             auto *line0 = lineSupport[0].template getLinePointer<N>();
             auto *line1 = lineSupport[1].template getLinePointer<N>();
@@ -308,6 +309,7 @@ template <typename VFXConfig> struct MicroGate : core::VoiceEffectTemplateBase<V
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         lineSupport[0].dispatch(recSize, [&](auto N) {
             auto *line = lineSupport[1].template getLinePointer<N>();
             monoImpl(line, datain, dataout);
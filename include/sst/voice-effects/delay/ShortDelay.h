@@ -280,6 +280,7 @@ template <typename VFXConfig> struct ShortDelay : core::VoiceEffectTemplateBase<
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         // a very rare case where [&] is appropriate, binding the entire argument set for one call
         lineSupport[0].dispatch(lineSize(), [&](auto N) {
             auto *line0 = lineSupport[0].template getLinePointer<N>();
@@ -297,6 +298,7 @@ template <typename VFXConfig> struct ShortDelay : core::VoiceEffectTemplateBase<
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         lineSupport[0].dispatch(lineSize(), [&](auto N) {
             auto *line = lineSupport[0].template getLinePointer<N>();
             monoImpl(line, datain, dataout);
@@ -158,6 +158,7 @@ template <typename VFXConfig> struct Widener : core::VoiceEffectTemplateBase<VFX
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (isShort)
         {
             processOntoLine(lineSupport.getLinePointer<shortLineSize>(), datainL, datainR, dataoutL,
@@ -121,6 +121,7 @@ template <typename VFXConfig> struct BitCrusher : core::VoiceEffectTemplateBase<
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         bool filterSwitch = this->getIntParam(ipFilterSwitch);
         int filtMode = this->getIntParam(ipFilterMode);
         sst::filters::CytomicSVF::Mode mode{};
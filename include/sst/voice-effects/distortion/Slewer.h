@@ -121,6 +121,7 @@ template <typename VFXConfig> struct Slewer : core::VoiceEffectTemplateBase<VFXC
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
         float rate alignas(16)[VFXConfig::blockSize];
         lipolRate.store_block(rate);
@@ -147,6 +148,7 @@ template <typename VFXConfig> struct Slewer : core::VoiceEffectTemplateBase<VFXC
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
         float rate alignas(16)[VFXConfig::blockSize];
         lipolRate.store_block(rate);
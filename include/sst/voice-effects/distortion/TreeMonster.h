@@ -95,6 +95,7 @@ template <typename VFXConfig> struct TreeMonster : core::VoiceEffectTemplateBase
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         coreProc.processWithoutMixOrWith(datainL, datainR, dataoutL, dataoutR);
     }
 
@@ -156,6 +156,7 @@ template <typename VFXConfig> struct AutoWah : core::VoiceEffectTemplateBase<VFX
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto sens = 1 + -1 * this->getFloatParam(fpSens);
         sens *= sens;
         auto thresholdDecibel = amplitudeToDecibels(sens);
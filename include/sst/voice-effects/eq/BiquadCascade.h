@@ -0,0 +1,201 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_VOICE_EFFECTS_EQ_BIQUADCASCADE_H
+#define INCLUDE_SST_VOICE_EFFECTS_EQ_BIQUADCASCADE_H
+
+#include <cmath>
+#include <cstring>
+
+#include "sst/basic-blocks/simd/setup.h"
+
+namespace sst::voice_effects::eq
+{
+/*
+ * A series of biquads as a preallocated structure of arrays, one band per slot with L and
+ * R as the two double lanes of a SIMD register, run a sample at a time through every
+ * active band. Coefficients follow their targets with the same one pole lag as
+ * BiquadFilter, so a band here sounds as that filter's process_block_to would.
+ *
+ * Which bands run is decided once per block, as is whether any of them is still gliding;
+ * a band whose coefficients have come within rounding of their targets lands on them.
+ */
+template <int NBands, int blockSize> struct BiquadCascade
+{
+    static constexpr double lagRate{0.004}; // BiquadFilter's coefficient lag
+
+    // a coefficient is target + offset, and the lag only ever shrinks the offset
+    double target alignas(16)[5][NBands][2]{}; // b0, b1, b2, a1, a2
+    double offset alignas(16)[5][NBands][2]{};
+    double z1 alignas(16)[NBands][2]{};
+    double z2 alignas(16)[NBands][2]{};
+    double decay alignas(16)[blockSize][2];
+    bool firstRun[NBands];
+    bool active[NBands];
+    bool gliding[NBands];
+
+    BiquadCascade()
+    {
+        double d{1.0};
+        for (int s = 0; s < blockSize; ++s)
+        {
+            d *= 1.0 - lagRate;
+            decay[s][0] = decay[s][1] = d;
+        }
+        for (int i = 0; i < NBands; ++i)
+        {
+            firstRun[i] = true;
+            active[i] = true;
+            gliding[i] = false;
+        }
+    }
+
+    // as BiquadFilter::suspend, the next coefficients the band gets are taken immediately
+    void suspend(int b)
+    {
+        z1[b][0] = z1[b][1] = 0.0;
+        z2[b][0] = z2[b][1] = 0.0;
+        firstRun[b] = true;
+    }
+
+    void setActive(int b, bool a) { active[b] = a; }
+
+    void setCoefficients(int b, double b0, double b1, double b2, double a1, double a2)
+    {
+        const double t[5]{b0, b1, b2, a1, a2};
+        for (int k = 0; k < 5; ++k)
+        {
+            auto o = firstRun[b] ? 0.0 : target[k][b][0] + offset[k][b][0] - t[k];
+            target[k][b][0] = target[k][b][1] = t[k];
+            offset[k][b][0] = offset[k][b][1] = o;
+        }
+        gliding[b] = !firstRun[b];
+        firstRun[b] = false;
+    }
+
+    // take the coefficients a BiquadFilter coeff_ call has just designed
+    template <typename Filter> void setCoefficientsFrom(int b, const Filter &f)
+    {
+        setCoefficients(b, f.b0.target_v, f.b1.target_v, f.b2.target_v, f.a1.target_v,
+                        f.a2.target_v);
+    }
+
+    void processBlock(const float *const inL, const float *const inR, float *outL, float *outR)
+    {
+        int run[NBands];
+        bool glide{false};
+        auto n = prepare(run, glide);
+        if (glide)
+            processWith<true, true>(run, n, inL, inR, outL, outR);
+        else
+            processWith<false, true>(run, n, inL, inR, outL, outR);
+    }
+
+    // a mono voice runs in the left lane, as BiquadFilter's mono process_block_to does
+    void processBlock(const float *const in, float *out)
+    {
+        int run[NBands];
+        bool glide{false};
+        auto n = prepare(run, glide);
+        if (glide)
+            processWith<true, false>(run, n, in, nullptr, out, nullptr);
+        else
+            processWith<false, false>(run, n, in, nullptr, out, nullptr);
+    }
+
+  protected:
+    int prepare(int *run, bool &glide)
+    {
+        int n{0};
+        for (int i = 0; i < NBands; ++i)
+        {
+            if (!active[i])
+                continue;
+            run[n++] = i;
+
+            if (gliding[i])
+            {
+                bool settled{true};
+                for (int k = 0; k < 5; ++k)
+                    settled = settled && std::fabs(offset[k][i][0]) <=
+                                             1e-12 * (1.0 + std::fabs(target[k][i][0]));
+                if (settled)
+                    for (int k = 0; k < 5; ++k)
+                        offset[k][i][0] = offset[k][i][1] = 0.0;
+                gliding[i] = !settled;
+            }
+            glide = glide || gliding[i];
+        }
+        return n;
+    }
+
+    template <bool glide, bool stereo>
+    void processWith(const int *run, int n, const float *const inL, const float *const inR,
+                     float *outL, float *outR)
+    {
+        // the lag is geometric, so each sample's coefficients come straight from the offset
+        auto coef = [this](int k, int i, auto d) {
+            auto c = SIMD_MM(load_pd)(target[k][i]);
+            if constexpr (glide)
+                c = SIMD_MM(add_pd)(c, SIMD_MM(mul_pd)(SIMD_MM(load_pd)(offset[k][i]), d));
+            return c;
+        };
+
+        for (int s = 0; s < blockSize; ++s)
+        {
+            auto x =
+                SIMD_MM(cvtps_pd)(SIMD_MM(setr_ps)(inL[s], stereo ? inR[s] : 0.f, 0.f, 0.f));
+            auto d = SIMD_MM(load_pd)(decay[s]);
+            for (int j = 0; j < n; ++j)
+            {
+                auto i = run[j];
+                auto b0 = coef(0, i, d), b1 = coef(1, i, d), b2 = coef(2, i, d);
+                auto a1 = coef(3, i, d), a2 = coef(4, i, d);
+                auto s1 = SIMD_MM(load_pd)(z1[i]), s2 = SIMD_MM(load_pd)(z2[i]);
+
+                // transposed direct form 2, as BiquadFilter::process_sample
+                auto y = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(x, b0), s1);
+                s1 = SIMD_MM(add_pd)(
+                    SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, b1), SIMD_MM(mul_pd)(a1, y)), s2);
+                s2 = SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, b2), SIMD_MM(mul_pd)(a2, y));
+                SIMD_MM(store_pd)(z1[i], s1);
+                SIMD_MM(store_pd)(z2[i], s2);
+                x = y;
+            }
+            auto out = SIMD_MM(cvtpd_ps)(x);
+            outL[s] = SIMD_MM(cvtss_f32)(out);
+            if constexpr (stereo)
+                outR[s] = SIMD_MM(cvtss_f32)(
+                    SIMD_MM(shuffle_ps)(out, out, SIMD_MM_SHUFFLE(1, 1, 1, 1)));
+        }
+
+        if constexpr (glide)
+        {
+            auto d = SIMD_MM(load_pd)(decay[blockSize - 1]);
+            for (int j = 0; j < n; ++j)
+                for (int k = 0; k < 5; ++k)
+                    SIMD_MM(store_pd)(offset[k][run[j]],
+                                      SIMD_MM(mul_pd)(SIMD_MM(load_pd)(offset[k][run[j]]), d));
+        }
+    }
+};
+} // namespace sst::voice_effects::eq
+
+#endif // INCLUDE_SST_VOICE_EFFECTS_EQ_BIQUADCASCADE_H
@@ -77,6 +77,7 @@ template <typename VFXConfig> struct EqGraphic6Band : core::VoiceEffectTemplateB
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
         sst::basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(datainL, dataoutL);
         sst::basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(datainR, dataoutR);
@@ -90,6 +91,7 @@ template <typename VFXConfig> struct EqGraphic6Band : core::VoiceEffectTemplateB
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
         sst::basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(datainL, dataoutL);
 
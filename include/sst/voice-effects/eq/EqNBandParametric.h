@@ -25,6 +25,7 @@
 #include "sst/basic-blocks/dsp/QuadratureOscillators.h"
 
 #include "../VoiceEffectCore.h"
+#include "BiquadCascade.h"
 
 #include <iostream>
 
@@ -117,26 +118,16 @@ struct EqNBandParametric : core::VoiceEffectTemplateBase<VFXConfig>
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
-        auto *inL = datainL;
-        auto *inR = datainR;
-        for (int i = 0; i < NBands; ++i)
-        {
-            mParametric[i].process_block_to(inL, inR, dataoutL, dataoutR);
-            inL = dataoutL;
-            inR = dataoutR;
-        }
+        cascade.processBlock(datainL, datainR, dataoutL, dataoutR);
     }
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
-        auto *inL = datainL;
-        for (int i = 0; i < NBands; ++i)
-        {
-            mParametric[i].process_block_to(inL, dataoutL);
-            inL = dataoutL;
-        }
+        cascade.processBlock(datainL, dataoutL);
     }
 
     float calc_GB_type_B(bool b, float x)
@@ -178,6 +169,8 @@ struct EqNBandParametric : core::VoiceEffectTemplateBase<VFXConfig>
                 mParametric[i].coeff_orfanidisEQ(mParametric[i].calc_omega(param[1 + bs] / 12.f),
                                                  param[2 + bs], this->dbToLinear(param[0 + bs]),
                                                  calc_GB_type_B(iparam[0 + i], param[0 + bs]), 1);
+                cascade.setCoefficientsFrom(i, mParametric[i]);
+                mParametric[i].coeff_instantize();
             }
             mLastParam = param;
             mLastIParam = iparam;
@@ -199,8 +192,10 @@ struct EqNBandParametric : core::VoiceEffectTemplateBase<VFXConfig>
   protected:
     std::array<float, NBands * 3> mLastParam{};
     std::array<int, NBands> mLastIParam{};
+    // mParametric designs the bands and draws the graph, the cascade runs them
     std::array<typename core::VoiceEffectTemplateBase<VFXConfig>::BiquadFilterType, NBands>
         mParametric;
+    BiquadCascade<NBands, VFXConfig::blockSize> cascade;
 
   public:
     static constexpr int16_t streamingVersion{1};
@@ -26,6 +26,7 @@
 #include "sst/basic-blocks/mechanics/block-ops.h"
 
 #include "../VoiceEffectCore.h"
+#include "BiquadCascade.h"
 
 #include <iostream>
 #include <array>
@@ -296,37 +297,19 @@ template <typename VFXConfig> struct MorphEQ : core::VoiceEffectTemplateBase<VFX
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
         gain.multiply_2_blocks_to(datainL, datainR, dataoutL, dataoutR);
-
-        float *inL = dataoutL;
-        float *inR = dataoutR;
-        for (int i = 0; i < numFilters; ++i)
-        {
-            if (mActive[i])
-            {
-                mParametric[i].process_block_to(inL, inR, dataoutL, dataoutR);
-                inL = dataoutL;
-                inR = dataoutR;
-            }
-        }
+        cascade.processBlock(dataoutL, dataoutR, dataoutL, dataoutR);
     }
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         calc_coeffs();
 
         gain.multiply_block_to(datainL, dataoutL);
-        float *inL = dataoutL;
-
-        for (int i = 0; i < numFilters; ++i)
-        {
-            if (mActive[i])
-            {
-                mParametric[i].process_block_to(inL, dataoutL);
-                inL = dataoutL;
-            }
-        }
+        cascade.processBlock(dataoutL, dataoutL);
     }
 
     // includeInternal means the band graphic evaluators work but it takes some more CPU.
@@ -355,9 +338,10 @@ template <typename VFXConfig> struct MorphEQ : core::VoiceEffectTemplateBase<VFX
             if (idiff)
             {
                 // snapshot changed so reset all the filters
-                for (auto &filt : mParametric)
+                for (int i = 0; i < numFilters; ++i)
                 {
-                    filt.suspend();
+                    mParametric[i].suspend();
+                    cascade.suspend(i);
                 }
             }
 
@@ -366,6 +350,7 @@ template <typename VFXConfig> struct MorphEQ : core::VoiceEffectTemplateBase<VFX
             {
                 mActive[i] = s0.bands[i].active || s1.bands[i].active;
                 mAnyActive = mAnyActive || mActive[i];
+                cascade.setActive(i, mActive[i]);
             }
 
             float morph = std::clamp(param[0], 0.f, 1.f);
@@ -436,6 +421,15 @@ template <typename VFXConfig> struct MorphEQ : core::VoiceEffectTemplateBase<VFX
                 }
             }
 
+            for (int i = 0; i < numFilters; ++i)
+            {
+                if (mActive[i])
+                {
+                    cascade.setCoefficientsFrom(i, mParametric[i]);
+                    mParametric[i].coeff_instantize();
+                }
+            }
+
             mLastParam = param;
             mLastIParam = iparam;
         }
@@ -492,6 +486,7 @@ template <typename VFXConfig> struct MorphEQ : core::VoiceEffectTemplateBase<VFX
 
     std::array<typename core::VoiceEffectTemplateBase<VFXConfig>::BiquadFilterType, numFilters>
         mParametricC0, mParametricC1;
+    BiquadCascade<numFilters, VFXConfig::blockSize> cascade;
 
     std::array<bool, numFilters> mActive{};
     bool mAnyActive{false};
@@ -90,12 +90,14 @@ template <typename VFXConfig> struct TiltEQ : core::VoiceEffectTemplateBase<VFXC
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         setCoeffs(pitch);
         tilter.template processBlock<VFXConfig::blockSize>(datainL, datainR, dataoutL, dataoutR);
     }
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         setCoeffs(pitch);
         tilter.template processBlock<VFXConfig::blockSize>(datainL, dataoutL);
     }
@@ -28,15 +28,21 @@
 
 #include "../VoiceEffectCore.h"
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <cmath>
 #include <cassert>
 
 namespace sst::voice_effects::filter
 {
+template <typename VFXConfig, filtersplusplus::FilterModel Model> struct FiltersPlusPlusPair;
+
 template <typename VFXConfig, filtersplusplus::FilterModel Model>
 struct FiltersPlusPlus : core::VoiceEffectTemplateBase<VFXConfig>
 {
+    friend struct FiltersPlusPlusPair<VFXConfig, Model>;
+
     static constexpr auto nameFn()
     {
         constexpr size_t maxFN{40};
@@ -581,6 +587,7 @@ struct FiltersPlusPlus : core::VoiceEffectTemplateBase<VFXConfig>
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         setCoeffs<true, true>(pitch);
 
         filter.prepareBlock();
@@ -615,6 +622,7 @@ struct FiltersPlusPlus : core::VoiceEffectTemplateBase<VFXConfig>
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam(ipStereo) > 0)
             setCoeffs<false, false>(pitch);
         else
@@ -763,5 +771,157 @@ struct FiltersPlusPlus : core::VoiceEffectTemplateBase<VFXConfig>
     }
 };
 
+/*
+ * FiltersPlusPlus runs a stereo voice in lanes 0 and 1 of a quad filter and leaves 2 and 3
+ * idle. FiltersPlusPlusPair runs two stereo voices through one quad filter instead, voice A
+ * in lanes 0/1 and voice B in lanes 2/3, so a pair costs about what one voice did.
+ *
+ * The voices are ordinary FiltersPlusPlus instances which keep their own parameters,
+ * keytrack and pitch, and which must both have had initVoiceEffect called. Since one filter
+ * has one configuration, they need the same passband / slope / drive / submodel and sample
+ * rate; when they don't, processStereo2Voices falls back to running each voice on its own.
+ * Filter state lives in the pair, so set it up with initPair when the two voices start and
+ * again if either of them is restarted.
+ *
+ * Comb uses all four lanes for a single stereo voice, so it can't be paired.
+ */
+template <typename VFXConfig, filtersplusplus::FilterModel Model> struct FiltersPlusPlusPair
+{
+    static_assert(Model != filtersplusplus::FilterModel::Comb,
+                  "The comb filter uses all four lanes for one voice and can't be paired");
+
+    using voice_t = FiltersPlusPlus<VFXConfig, Model>;
+
+    FiltersPlusPlusPair()
+    {
+        filter.init();
+        filter.setFilterModel(Model);
+        filter.setQuad();
+    }
+
+    static bool canShareFilter(const voice_t &a, const voice_t &b)
+    {
+        for (int i = voice_t::ipPassband; i < voice_t::numIntParams; ++i)
+        {
+            if (a.getIntParam(i) != b.getIntParam(i))
+                return false;
+        }
+        return a.getSampleRate() == b.getSampleRate();
+    }
+
+    void initPair(voice_t &a, voice_t &b)
+    {
+        filter.init();
+        filter.setFilterModel(Model);
+        filter.setQuad();
+        filter.setSampleRateAndBlockSize(a.getSampleRate(), VFXConfig::blockSize);
+        setupFilter(a);
+        priorConfig = configKey(a);
+    }
+
+    void processStereo2Voices(voice_t &a, const float *const datainAL, const float *const datainAR,
+                              float *dataoutAL, float *dataoutAR, float pitchA, voice_t &b,
+                              const float *const datainBL, const float *const datainBR,
+                              float *dataoutBL, float *dataoutBR, float pitchB)
+    {
+        if (!canShareFilter(a, b))
+        {
+            a.processStereo(datainAL, datainAR, dataoutAL, dataoutAR, pitchA);
+            b.processStereo(datainBL, datainBR, dataoutBL, dataoutBR, pitchB);
+            return;
+        }
+
+        // the shared block is reported once, against voice A
+        auto profile = a.processProfileScope(voice_t::streamingName);
+        auto cfg = configKey(a);
+        if (cfg != priorConfig)
+        {
+            setupFilter(a);
+            priorConfig = cfg;
+        }
+
+        setLaneCoeffs(a, pitchA, 0);
+        setLaneCoeffs(b, pitchB, 2);
+
+        filter.prepareBlock();
+        float res alignas(16)[4];
+        for (int i = 0; i < VFXConfig::blockSize; ++i)
+        {
+            auto in = SIMD_MM(set_ps)(datainBR[i], datainBL[i], datainAR[i], datainAL[i]);
+            SIMD_MM(store_ps)(res, filter.processSample(in));
+            dataoutAL[i] = res[0];
+            dataoutAR[i] = res[1];
+            dataoutBL[i] = res[2];
+            dataoutBR[i] = res[3];
+        }
+        filter.concludeBlock();
+    }
+
+  protected:
+    filtersplusplus::Filter filter = filtersplusplus::Filter();
+    std::array<float, 12> priorCoeffs{};
+    int priorConfig{-1};
+
+    static int configKey(const voice_t &v)
+    {
+        int cfg{0};
+        for (int i = voice_t::ipPassband; i < voice_t::numIntParams; ++i)
+        {
+            cfg = cfg * 31 + v.getIntParam(i);
+        }
+        return cfg;
+    }
+
+    void setupFilter(voice_t &v)
+    {
+        filter.setModelConfiguration(v.configFilter());
+        filter.setQuad();
+        if (!filter.prepareInstance())
+        {
+            filter.setFilterModel(filtersplusplus::FilterModel::CytomicSVF);
+            filter.setPassband(filtersplusplus::Passband::LP);
+            filter.setQuad();
+            filter.prepareInstance();
+        }
+        std::fill(priorCoeffs.begin(), priorCoeffs.end(), -1000.f);
+    }
+
+    // Makes the coefficients for voice v in lanes lane and lane + 1, matching
+    // FiltersPlusPlus::setCoeffs
+    void setLaneCoeffs(voice_t &v, float pitch, int lane)
+    {
+        auto reso = std::clamp(v.getFloatParam(voice_t::fpResonance), 0.f, 1.f);
+        auto extra =
+            std::clamp(v.getFloatParam(voice_t::fpExtra), v.extraBounds[0], v.extraBounds[1]);
+        if constexpr (Model == filtersplusplus::FilterModel::CytomicSVF)
+        {
+            // Andy assumes A = pow(10, dB/40), our converter uses dB/20, hence the * .5f
+            extra = v.dbToLinear(0.5f * extra);
+        }
+
+        auto freqL = v.getFloatParam(voice_t::fpCutoffL) + v.keytrackOn * pitch;
+        auto freqR = freqL;
+        if (v.getIntParam(voice_t::ipStereo) > 0)
+            freqR = v.getFloatParam(voice_t::fpCutoffR) + v.keytrackOn * pitch;
+
+        float freq[2]{freqL, freqR};
+        for (int c = 0; c < 2; ++c)
+        {
+            auto *prior = &priorCoeffs[(lane + c) * 3];
+            if (prior[0] == freq[c] && prior[1] == reso && prior[2] == extra)
+            {
+                filter.freezeCoefficientsFor(lane + c);
+            }
+            else
+            {
+                filter.makeCoefficients(lane + c, freq[c], reso, extra);
+                prior[0] = freq[c];
+                prior[1] = reso;
+                prior[2] = extra;
+            }
+        }
+    }
+};
+
 } // namespace sst::voice_effects::filter
 #endif // FILTERSPLUSPLUS_H
@@ -155,6 +155,7 @@ template <typename VFXConfig> struct StaticPhaser : core::VoiceEffectTemplateBas
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace mech = sst::basic_blocks::mechanics;
 
         calc_coeffs(pitch);
@@ -191,6 +192,7 @@ template <typename VFXConfig> struct StaticPhaser : core::VoiceEffectTemplateBas
 
     void processMonoToMono(const float *const dataIn, float *dataOut, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace mech = sst::basic_blocks::mechanics;
 
         this->calc_coeffs(pitch);
@@ -219,6 +219,7 @@ template <typename VFXConfig> struct UtilityFilters : core::VoiceEffectTemplateB
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         setCoeffs(pitch);
 
         basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(datainL, dataoutL);
@@ -238,6 +239,7 @@ template <typename VFXConfig> struct UtilityFilters : core::VoiceEffectTemplateB
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         setCoeffs(pitch);
 
         basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(datain, dataout);
@@ -142,6 +142,7 @@ template <typename VFXConfig> struct ThreeOpPhaseMod : core::VoiceEffectTemplate
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace mech = sst::basic_blocks::mechanics;
 
         setupForBlock(pitch);
@@ -189,6 +190,7 @@ template <typename VFXConfig> struct ThreeOpPhaseMod : core::VoiceEffectTemplate
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace mech = sst::basic_blocks::mechanics;
 
         setupForBlock(pitch);
@@ -21,6 +21,8 @@
 #ifndef INCLUDE_SST_VOICE_EFFECTS_GENERATOR_ELLIPTICBLEPWAVEFORMS_H
 #define INCLUDE_SST_VOICE_EFFECTS_GENERATOR_ELLIPTICBLEPWAVEFORMS_H
 
+#include <type_traits>
+
 #include "sst/basic-blocks/params/ParamMetadata.h"
 #include "sst/basic-blocks/dsp/EllipticBlepOscillators.h"
 
@@ -30,6 +32,8 @@
 #include "sst/basic-blocks/dsp/OscillatorDriftUnisonCharacter.h"
 #include "sst/basic-blocks/dsp/PanLaws.h"
 
+#include "UnisonEBSaw.h"
+
 namespace sst::voice_effects::generator
 {
 template <typename VFXConfig>
@@ -155,9 +159,9 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
 
     void initVoiceEffect()
     {
+        sawOscs.setSampleRate(this->getSampleRate());
         for (int i = 0; i < maxUnison; ++i)
         {
-            sawOscs[i].setSampleRate(this->getSampleRate());
             semisinOscs[i].setSampleRate(this->getSampleRate());
             sinOscs[i].setSampleRate(this->getSampleRate());
             triOscs[i].setSampleRate(this->getSampleRate());
@@ -169,7 +173,7 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
 
             for (int i = 0; i < maxUnison; ++i)
             {
-                sawOscs[i].setInitialPhase(rng.unif01(), sr);
+                sawOscs.setInitialPhase(i, rng.unif01(), sr);
                 semisinOscs[i].setInitialPhase(rng.unif01(), sr);
                 sinOscs[i].setInitialPhase(rng.unif01(), sr);
                 triOscs[i].setInitialPhase(rng.unif01(), sr);
@@ -183,9 +187,15 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
     }
     void initVoiceEffectParams() { this->initToParamMetadataDefault(this); }
 
+    /*
+     * The saw runs its unison stack in SIMD lanes, set up here a voice at a time and then
+     * stepped and panned as one; the other waves step an oscillator per voice.
+     */
     template <bool toStereo, typename T>
-    void genericProcess(std::array<T, maxUnison> &t, float *dataoutL, float *dataoutR, float pitch)
+    void genericProcess(T &t, float *dataoutL, float *dataoutR, float pitch)
     {
+        static constexpr bool inLanes{std::is_same_v<T, saw_t>};
+
         auto uc = std::max(this->getIntParam(ipUnisonVoices), 1);
         auto ue = this->getIntParam(ipUnisonExtend);
         auto upw = this->getFloatParam(fpUniWidth);
@@ -204,6 +214,8 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
         float tune = this->getFloatParam(fpOffset);
 
         auto sr = this->note_to_pitch_ignoring_tuning(this->getFloatParam(fpSync));
+        if constexpr (inLanes)
+            t.setSyncRatio(sr);
 
         // Drift I just normalized by ear here
 
@@ -226,6 +238,7 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
             }
         }
 
+        float gainL alignas(16)[saw_t::maxVoices]{}, gainR alignas(16)[saw_t::maxVoices]{};
         auto driftLevel = this->getFloatParam(fpDrift);
         for (int u = 0; u < uc; ++u)
         {
@@ -234,43 +247,62 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
             auto baseFreq = 440.0 * this->note_to_pitch_ignoring_tuning(
                                         (keytrackOn) ? tune + driftVal + pitch + dt * uni.detune(u)
                                                      : tune + driftVal + dt * uni.detune(u));
-            t[u].setFrequency(baseFreq);
-            t[u].setSyncRatio(sr);
-            if (toStereo)
+            if constexpr (inLanes)
             {
-                if (u == 0)
-                {
-                    for (int i = 0; i < VFXConfig::blockSize; ++i)
-                    {
-                        auto s = t[u].step() * uni.attenuation();
-                        dataoutL[i] = uniPans[u][0] * s;
-                        dataoutR[i] = uniPans[u][3] * s;
-                    }
-                }
-                else
-                {
-                    for (int i = 0; i < VFXConfig::blockSize; ++i)
-                    {
-                        auto s = t[u].step() * uni.attenuation();
-                        dataoutL[i] += uniPans[u][0] * s;
-                        dataoutR[i] += uniPans[u][3] * s;
-                    }
-                }
+                t.setFrequency(u, baseFreq);
+                gainL[u] = (toStereo ? uniPans[u][0] : 1.f) * uni.attenuation();
+                gainR[u] = (toStereo ? uniPans[u][3] : 1.f) * uni.attenuation();
             }
             else
             {
-                if (u == 0)
+                t[u].setFrequency(baseFreq);
+                t[u].setSyncRatio(sr);
+                stepVoice<toStereo>(t[u], u, dataoutL, dataoutR);
+            }
+        }
+
+        if constexpr (inLanes)
+            t.template process<toStereo>(uc, gainL, gainR, dataoutL, dataoutR);
+    }
+
+    // one oscillator's block; the first voice writes the outputs and the rest add to them
+    template <bool toStereo, typename T>
+    void stepVoice(T &osc, int u, float *dataoutL, float *dataoutR)
+    {
+        if (toStereo)
+        {
+            if (u == 0)
+            {
+                for (int i = 0; i < VFXConfig::blockSize; ++i)
                 {
-                    for (int i = 0; i < VFXConfig::blockSize; ++i)
-                        dataoutL[i] = t[u].step() * uni.attenuation();
+                    auto s = osc.step() * uni.attenuation();
+                    dataoutL[i] = uniPans[u][0] * s;
+                    dataoutR[i] = uniPans[u][3] * s;
                 }
-                else
+            }
+            else
+            {
+                for (int i = 0; i < VFXConfig::blockSize; ++i)
                 {
-                    for (int i = 0; i < VFXConfig::blockSize; ++i)
-                        dataoutL[i] += t[u].step() * uni.attenuation();
+                    auto s = osc.step() * uni.attenuation();
+                    dataoutL[i] += uniPans[u][0] * s;
+                    dataoutR[i] += uniPans[u][3] * s;
                 }
             }
         }
+        else
+        {
+            if (u == 0)
+            {
+                for (int i = 0; i < VFXConfig::blockSize; ++i)
+                    dataoutL[i] = osc.step() * uni.attenuation();
+            }
+            else
+            {
+                for (int i = 0; i < VFXConfig::blockSize; ++i)
+                    dataoutL[i] += osc.step() * uni.attenuation();
+            }
+        }
     }
 
     template <bool toStereo> void processTo(float *dataoutL, float *dataoutR, float pitch)
@@ -319,18 +351,21 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         uniPanValid = false;
         processTo<false>(dataoutL, nullptr, pitch);
     }
     void processMonoToStereo(const float *const datainL, float *dataoutL, float *dataoutR,
                              float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         processTo<true>(dataoutL, dataoutR, pitch);
     }
 
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         processTo<true>(dataoutL, dataoutR, pitch);
     }
 
@@ -351,13 +386,14 @@ struct EllipticBlepWaveforms : core::VoiceEffectTemplateBase<VFXConfig>
     sst::basic_blocks::dsp::lipol_sse<VFXConfig::blockSize, true> sLevelLerp;
 
     using bpi_t = sst::basic_blocks::dsp::BlockInterpSmoothingStrategy<VFXConfig::blockSize>;
-    using saw_t = sst::basic_blocks::dsp::EBSaw<bpi_t>;
+    using saw_t = UnisonEBSaw<VFXConfig::blockSize>;
     using semisin_t = sst::basic_blocks::dsp::EBApproxSemiSin<bpi_t>;
     using pulse_t = sst::basic_blocks::dsp::EBPulse<bpi_t>;
     using tri_t = sst::basic_blocks::dsp::EBTri<bpi_t>;
     using sin_t = sst::basic_blocks::dsp::EBApproxSin<bpi_t>;
 
-    std::array<saw_t, maxUnison> sawOscs;
+    saw_t sawOscs;
+    static_assert(maxUnison <= saw_t::maxVoices);
     std::array<semisin_t, maxUnison> semisinOscs;
     std::array<pulse_t, maxUnison> pulseOscs;
     std::array<tri_t, maxUnison> triOscs;
@@ -340,6 +340,7 @@ template <typename VFXConfig> struct FourVoiceResonator : core::VoiceEffectTempl
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         voices.dispatch(lineSize(), [&](auto N) {
             auto *lines = voices.template getLinePointer<N>();
             stereoImpl(lines, datainL, datainR, dataoutL, dataoutR, pitch);
@@ -360,6 +361,7 @@ template <typename VFXConfig> struct FourVoiceResonator : core::VoiceEffectTempl
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         voices.dispatch(lineSize(), [&](auto N) {
             auto *lines = voices.template getLinePointer<N>();
             monoImpl(lines, datain, dataout, pitch);
@@ -107,10 +107,11 @@ struct GenCorrelatedNoise
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto isStereo = this->getIntParam(ipStereo) != 0;
         if (!isStereo)
         {
-            processMonoToMono(datainL, dataoutL, pitch);
+            generateMono(dataoutL);
             basic_blocks::mechanics::copy_from_to<VFXConfig::blockSize>(dataoutL, dataoutR);
             return;
         }
@@ -147,6 +148,22 @@ struct GenCorrelatedNoise
     }
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
+    {
+        auto profile = this->processProfileScope(streamingName);
+        generateMono(dataoutL);
+    }
+
+    void processMonoToStereo(const float *const datainL, float *dataoutL, float *dataoutR,
+                             float pitch)
+    {
+        processStereo(datainL, datainL, dataoutL, dataoutR, pitch);
+    }
+
+    bool getMonoToStereoSetting() const { return this->getIntParam(ipStereo) > 0; }
+    bool checkParameterConsistency() const { return true; }
+
+  protected:
+    void generateMono(float *dataoutL)
     {
         auto levT = std::clamp(this->getFloatParam(fpLevel), 0.f, 1.f);
         levT = levT * levT * levT;
@@ -168,16 +185,6 @@ struct GenCorrelatedNoise
         mLevelLerp.multiply_block(dataoutL);
     }
 
-    void processMonoToStereo(const float *const datainL, float *dataoutL, float *dataoutR,
-                             float pitch)
-    {
-        processStereo(datainL, datainL, dataoutL, dataoutR, pitch);
-    }
-
-    bool getMonoToStereoSetting() const { return this->getIntParam(ipStereo) > 0; }
-    bool checkParameterConsistency() const { return true; }
-
-  protected:
     float mPrior[2][2]{{0.f, 0.f}, {0.f, 0.f}};
 
     sst::basic_blocks::dsp::lipol_sse<VFXConfig::blockSize, true> mLevelLerp, mWidthS, mWidthM;
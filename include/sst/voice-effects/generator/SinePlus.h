@@ -160,6 +160,7 @@ template <typename VFXConfig> struct SinePlus : core::VoiceEffectTemplateBase<VF
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto freq = this->getFloatParam(fpBaseFrequency);
         if (keytrackOn)
             freq += pitch;
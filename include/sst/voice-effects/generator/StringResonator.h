@@ -74,11 +74,7 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
         std::fill(mLastParam.begin(), mLastParam.end(), -188888.f);
     }
 
-    ~StringResonator()
-    {
-        lineSupport[0].returnAll(this);
-        lineSupport[1].returnAll(this);
-    }
+    ~StringResonator() { lineSupport.returnAll(this); }
 
     basic_blocks::params::ParamMetaData paramAt(int idx) const
     {
@@ -185,11 +181,8 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
 
     void initVoiceEffect()
     {
-        for (int i = 0; i < 2; ++i)
-        {
-            lineSupport[i].returnAllExcept(lineSize(), this);
-            lineSupport[i].reservePrepareAndClear(lineSize(), this, sSincTable);
-        }
+        lineSupport.returnAllExcept(lineSize(), this);
+        lineSupport.reservePrepareAndClear(lineSize(), this, sSincTable);
     }
     void initVoiceEffectParams() { this->initToParamMetadataDefault(this); }
 
@@ -232,8 +225,8 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
     }
 
     template <typename T>
-    void stereoDualString(const std::array<T *, 2> &lines, const float *const datainL,
-                          const float *const datainR, float *dataoutL, float *dataoutR, float pitch)
+    void stereoDualString(T *lines, const float *const datainL, const float *const datainR,
+                          float *dataoutL, float *dataoutR, float pitch)
     {
         namespace mech = sst::basic_blocks::mechanics;
         namespace sdsp = sst::basic_blocks::dsp;
@@ -306,8 +299,8 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
 
         for (int i = 0; i < VFXConfig::blockSize; ++i)
         {
-            auto fromLineOne = lines[0]->read(frequencyOne[i]);
-            auto fromLineTwo = lines[1]->read(frequencyTwo[i]);
+            float fromLineOne, fromLineTwo;
+            lines->read(frequencyOne[i], frequencyTwo[i], fromLineOne, fromLineTwo);
 
             float toLineOne = 0.f;
             float toLineTwo = 0.f;
@@ -327,8 +320,7 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
                 hp.process_sample(toLineOne, toLineTwo, toLineOne, toLineTwo);
             }
 
-            lines[0]->write(toLineOne);
-            lines[1]->write(toLineTwo);
+            lines->write(toLineOne, toLineTwo);
 
             float leftOutOne = 0.f, rightOutOne = 0.f;
             float leftOutTwo = 0.f, rightOutTwo = 0.f;
@@ -433,8 +425,7 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
     }
 
     template <typename T>
-    void monoDualString(const std::array<T *, 2> &lines, const float *const datainL,
-                        float *dataoutL, float pitch)
+    void monoDualString(T *lines, const float *const datainL, float *dataoutL, float pitch)
     {
         namespace mech = sst::basic_blocks::mechanics;
         namespace sdsp = sst::basic_blocks::dsp;
@@ -490,8 +481,8 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
 
         for (int i = 0; i < VFXConfig::blockSize; ++i)
         {
-            auto fromLineOne = lines[0]->read(frequencyOne[i]);
-            auto fromLineTwo = lines[1]->read(frequencyTwo[i]);
+            float fromLineOne, fromLineTwo;
+            lines->read(frequencyOne[i], frequencyTwo[i], fromLineOne, fromLineTwo);
 
             float toLineOne = 0.f;
             float toLineTwo = 0.f;
@@ -508,8 +499,7 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
                 hp.process_sample(toLineOne, toLineTwo, toLineOne, toLineTwo);
             }
 
-            lines[0]->write(toLineOne);
-            lines[1]->write(toLineTwo);
+            lines->write(toLineOne, toLineTwo);
 
             dataoutL[i] = toLineOne * levelOne[i] + toLineTwo * levelTwo[i];
         }
@@ -650,19 +640,18 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam(ipDualString))
         {
-            lineSupport[0].dispatch(lineSize(), [&](auto N) {
-                auto *line0 = lineSupport[0].template getLinePointer<N>();
-                auto *line1 = lineSupport[1].template getLinePointer<N>();
-                std::array<decltype(line0), 2> lines = {line0, line1};
+            lineSupport.dispatch(lineSize(), [&](auto N) {
+                auto *lines = lineSupport.template getLinePointer<N>();
                 stereoDualString(lines, datainL, datainR, dataoutL, dataoutR, pitch);
             });
         }
         else
         {
-            lineSupport[0].dispatch(lineSize(), [&](auto N) {
-                auto *line = lineSupport[0].template getLinePointer<N>();
+            lineSupport.dispatch(lineSize(), [&](auto N) {
+                auto *line = lineSupport.template getLinePointer<N>();
                 stereoSingleString(line, datainL, datainR, dataoutL, dataoutR, pitch);
             });
         }
@@ -676,19 +665,18 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam(ipDualString))
         {
-            lineSupport[0].dispatch(lineSize(), [&](auto N) {
-                auto *line0 = lineSupport[0].template getLinePointer<N>();
-                auto *line1 = lineSupport[1].template getLinePointer<N>();
-                std::array<decltype(line0), 2> lines = {line0, line1};
+            lineSupport.dispatch(lineSize(), [&](auto N) {
+                auto *lines = lineSupport.template getLinePointer<N>();
                 monoDualString(lines, datain, dataout, pitch);
             });
         }
         else
         {
-            lineSupport[0].dispatch(lineSize(), [&](auto N) {
-                auto *line = lineSupport[0].template getLinePointer<N>();
+            lineSupport.dispatch(lineSize(), [&](auto N) {
+                auto *line = lineSupport.template getLinePointer<N>();
                 monoSingleString(line, datain, dataout, pitch);
             });
         }
@@ -709,8 +697,8 @@ template <typename VFXConfig> struct StringResonator : core::VoiceEffectTemplate
 
   protected:
     bool keytrackOn{true};
-    std::array<delay::details::DelayLineSupport<sst::basic_blocks::dsp::SSESincDelayLine>, 2>
-        lineSupport;
+    // both strings in one paired line, the single string mode using its first
+    delay::details::DelayLineSupport<delay::details::PairedSincDelayLine> lineSupport;
     bool firstPitch{false};
 
     std::array<float, numFloatParams> mLastParam{};
@@ -123,6 +123,7 @@ struct TiltNoise : core::VoiceEffectTemplateBase<VFXConfig>,
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         bool stereo = this->getIntParam(ipStereo);
 
         float tilt = this->getFloatParam(fpTilt);
@@ -165,6 +166,7 @@ struct TiltNoise : core::VoiceEffectTemplateBase<VFXConfig>,
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         float level = this->getFloatParam(fpLevel);
         level = level * level * level;
         levelLerp.set_target(level);
@@ -196,6 +198,7 @@ struct TiltNoise : core::VoiceEffectTemplateBase<VFXConfig>,
     void processMonoToStereo(const float *const datainL, float *dataoutL, float *dataoutR,
                              float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         float level = this->getFloatParam(fpLevel);
         level = level * level * level;
         levelLerp.set_target(level);
@@ -0,0 +1,307 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_VOICE_EFFECTS_GENERATOR_UNISONEBSAW_H
+#define INCLUDE_SST_VOICE_EFFECTS_GENERATOR_UNISONEBSAW_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "sst/basic-blocks/simd/setup.h"
+#include "sst/basic-blocks/mechanics/simd-ops.h"
+
+namespace sst::voice_effects::generator
+{
+/*
+ * Up to eight hard syncable elliptic BLEP saws, one per SIMD lane across two registers, so
+ * a unison stack steps as one oscillator and is mixed down to one or two channels with a
+ * gain per voice as it runs.
+ *
+ * Each edge is corrected in the manner of the elliptic BLEP oscillators in sst-basic-blocks,
+ * by adding the step response of an elliptic lowpass (order 7, 0.5dB ripple, 70dB down,
+ * edge at 0.8 of nyquist) less the ideal step to a bank of one pole states: three complex,
+ * whose conjugates are folded in, and one real. Where an edge falls between samples the
+ * state it lands with is a polynomial in the fraction, fitted to the exact exponential to
+ * within float rounding.
+ *
+ * Frequencies ramp over the block from where the last block left them. With sync the saw's
+ * phase restarts whenever a master phase at the voice frequency wraps, and it is heard at
+ * the voice frequency times the sync ratio.
+ */
+template <int blockSize> struct UnisonEBSaw
+{
+    static constexpr int maxVoices{8};
+    static constexpr int nPoles{4}; // the last one real
+    // the lowpass's delay at DC, in samples; the ramp is read this late to line up with
+    // the corrected edges, which keeps the saw free of DC at any frequency
+    static constexpr float groupDelay{1.995627698f};
+
+    // exp(pole), for a sample of decay and turn
+    static constexpr float stepRe[nPoles]{-7.441460581e-01f, -4.152512403e-01f,
+                                          1.192787370e-01f, 4.540669547e-01f};
+    static constexpr float stepIm[nPoles]{5.251990883e-01f, 5.911547297e-01f, 5.226900348e-01f,
+                                          0.f};
+
+    // residue / pole * exp(pole * t), doubled for the complex ones, over an edge t samples
+    // back, as ascending powers of t; real parts then imaginary parts
+    static constexpr int polyOrder{8};
+    static constexpr float blepRe[nPoles][polyOrder]{
+        {-7.631601002e-02f, -4.921157405e-02f, 2.486955178e-01f, 3.611289361e-02f,
+         -1.305610131e-01f, -1.549050111e-02f, 4.078978116e-02f, -8.937392643e-03f},
+        {2.061118783e-01f, 4.875605001e-01f, -6.606935740e-01f, -2.519025449e-01f,
+         3.057915776e-01f, 2.996484954e-02f, -6.503200677e-02f, 1.277788877e-02f},
+        {7.631603281e-02f, -1.384386316e+00f, 7.789736009e-01f, 1.844216807e-01f,
+         -2.011502334e-01f, 3.138622245e-02f, 6.599692385e-03f, -2.012092742e-03f},
+        {-1.206111907e+00f, 9.522381407e-01f, -3.759008053e-01f, 9.892386227e-02f,
+         -1.951740897e-02f, 3.064921560e-03f, -3.833479042e-04f, 3.098406025e-05f}};
+    static constexpr float blepIm[nPoles - 1][polyOrder]{
+        {2.229372723e-02f, -1.949441458e-01f, -5.284290258e-02f, 2.092753689e-01f,
+         2.523861099e-02f, -8.209747361e-02f, 1.327896561e-02f, 3.127094271e-03f},
+        {-2.540229590e-01f, 5.325827006e-01f, 4.453283327e-01f, -5.266601035e-01f,
+         -1.041309959e-01f, 1.604731360e-01f, -2.165676727e-02f, -4.586122251e-03f},
+        {9.928528455e-01f, -5.161749267e-01f, -7.710844717e-01f, 5.096649341e-01f,
+         -1.666947754e-02f, -5.353173664e-02f, 1.429853280e-02f, -1.039825205e-03f}};
+
+    // the saw's phase, and the master phase which restarts it under sync
+    float phase alignas(16)[maxVoices]{}, masterPhase alignas(16)[maxVoices]{};
+    // per sample phase increments, where the last block ended and where this one ends
+    float dPhase alignas(16)[maxVoices]{}, nextDPhase alignas(16)[maxVoices]{};
+    float dMaster alignas(16)[maxVoices]{}, nextDMaster alignas(16)[maxVoices]{};
+    float blepStateRe alignas(16)[nPoles][maxVoices]{};
+    float blepStateIm alignas(16)[nPoles - 1][maxVoices]{};
+    bool firstBlock[maxVoices];
+
+    double srInv{1.0 / 48000.0};
+    float syncRatio{1.f};
+
+    UnisonEBSaw() { reset(); }
+
+    void setSampleRate(double sr) { srInv = 1.0 / sr; }
+
+    void reset()
+    {
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            phase[v] = 0.f;
+            masterPhase[v] = 0.f;
+            for (int p = 0; p < nPoles; ++p)
+                blepStateRe[p][v] = 0.f;
+            for (int p = 0; p < nPoles - 1; ++p)
+                blepStateIm[p][v] = 0.f;
+            firstBlock[v] = true;
+        }
+    }
+
+    // as EBSaw::setInitialPhase, with the synced saw placed where the master puts it
+    void setInitialPhase(int v, float ph, float sr)
+    {
+        masterPhase[v] = ph;
+        phase[v] = ph * sr - std::floor(ph * sr);
+    }
+
+    // shared by every voice; 1 runs the saws free
+    void setSyncRatio(float sr) { syncRatio = std::max(sr, 1.f); }
+
+    // the frequency voice v reaches by the end of the coming block
+    void setFrequency(int v, double freq)
+    {
+        auto dm = std::clamp((float)(freq * srInv), 0.f, 0.5f);
+        nextDMaster[v] = dm;
+        nextDPhase[v] = std::min(dm * syncRatio, 0.5f);
+        if (firstBlock[v])
+        {
+            dMaster[v] = nextDMaster[v];
+            dPhase[v] = nextDPhase[v];
+            firstBlock[v] = false;
+        }
+    }
+
+    /*
+     * Run the first nVoices for a block, mixing voice v into outL with gainL[v] and, when
+     * stereo, into outR with gainR[v]. Voices past nVoices hold their state.
+     */
+    template <bool stereo>
+    void process(int nVoices, const float *gainL, const float *gainR, float *outL, float *outR)
+    {
+        SIMD_M128 accL[blockSize], accR[blockSize];
+        for (int k = 0; k < blockSize; ++k)
+        {
+            accL[k] = SIMD_MM(setzero_ps)();
+            accR[k] = SIMD_MM(setzero_ps)();
+        }
+
+        for (int v0 = 0; v0 < nVoices; v0 += 4)
+        {
+            if (syncRatio > 1.f)
+                processLanes<true, stereo>(v0, nVoices, gainL, gainR, accL, accR);
+            else
+                processLanes<false, stereo>(v0, nVoices, gainL, gainR, accL, accR);
+        }
+
+        namespace mech = sst::basic_blocks::mechanics;
+        for (int k = 0; k < blockSize; ++k)
+        {
+            SIMD_MM(store_ss)(outL + k, mech::sum_ps_to_ss(accL[k]));
+            if constexpr (stereo)
+                SIMD_MM(store_ss)(outR + k, mech::sum_ps_to_ss(accR[k]));
+        }
+    }
+
+  protected:
+    // the correction for an edge of the given size t samples back, added to the states
+    static void addBlep(SIMD_M128 t, SIMD_M128 size, SIMD_M128 re[nPoles],
+                        SIMD_M128 im[nPoles - 1])
+    {
+        auto poly = [t](const float *c) {
+            auto r = SIMD_MM(set1_ps)(c[polyOrder - 1]);
+            for (int i = polyOrder - 2; i >= 0; --i)
+                r = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(r, t), SIMD_MM(set1_ps)(c[i]));
+            return r;
+        };
+        for (int p = 0; p < nPoles; ++p)
+            re[p] = SIMD_MM(add_ps)(re[p], SIMD_MM(mul_ps)(size, poly(blepRe[p])));
+        for (int p = 0; p < nPoles - 1; ++p)
+            im[p] = SIMD_MM(add_ps)(im[p], SIMD_MM(mul_ps)(size, poly(blepIm[p])));
+    }
+
+    template <bool sync, bool stereo>
+    void processLanes(int v0, int nVoices, const float *gainL, const float *gainR,
+                      SIMD_M128 *accL, SIMD_M128 *accR)
+    {
+        const auto zero = SIMD_MM(setzero_ps)();
+        const auto one = SIMD_MM(set1_ps)(1.f);
+        const auto two = SIMD_MM(set1_ps)(2.f);
+        const auto bsInv = SIMD_MM(set1_ps)(1.f / blockSize);
+        const auto delay = SIMD_MM(set1_ps)(groupDelay);
+
+        auto on = SIMD_MM(cmplt_ps)(SIMD_MM(setr_ps)(v0, v0 + 1.f, v0 + 2.f, v0 + 3.f),
+                                    SIMD_MM(set1_ps)((float)nVoices));
+        auto ramp = [&](float *from, const float *to, SIMD_M128 &d, SIMD_M128 &dd) {
+            auto was = SIMD_MM(load_ps)(from + v0);
+            auto next = SIMD_MM(load_ps)(to + v0);
+            d = SIMD_MM(and_ps)(was, on);
+            dd = SIMD_MM(and_ps)(SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(next, was), bsInv), on);
+            SIMD_MM(store_ps)(from + v0, SIMD_MM(or_ps)(SIMD_MM(and_ps)(on, next),
+                                                        SIMD_MM(andnot_ps)(on, was)));
+        };
+
+        SIMD_M128 ds, dds, dm, ddm;
+        ramp(dPhase, nextDPhase, ds, dds);
+        ramp(dMaster, nextDMaster, dm, ddm);
+        auto gL = SIMD_MM(and_ps)(SIMD_MM(loadu_ps)(gainL + v0), on);
+        auto gR = stereo ? SIMD_MM(and_ps)(SIMD_MM(loadu_ps)(gainR + v0), on) : zero;
+
+        auto s = SIMD_MM(load_ps)(phase + v0);
+        auto m = SIMD_MM(load_ps)(masterPhase + v0);
+        SIMD_M128 re[nPoles], im[nPoles - 1], stRe[nPoles], stIm[nPoles - 1];
+        for (int p = 0; p < nPoles; ++p)
+        {
+            re[p] = SIMD_MM(load_ps)(blepStateRe[p] + v0);
+            stRe[p] = SIMD_MM(set1_ps)(stepRe[p]);
+        }
+        for (int p = 0; p < nPoles - 1; ++p)
+        {
+            im[p] = SIMD_MM(load_ps)(blepStateIm[p] + v0);
+            stIm[p] = SIMD_MM(set1_ps)(stepIm[p]);
+        }
+
+        for (int k = 0; k < blockSize; ++k)
+        {
+            // the increments land on the new frequency at the last sample, as lipol_sse does
+            ds = SIMD_MM(add_ps)(ds, dds);
+
+            SIMD_M128 tm{zero}, restart{zero};
+            if constexpr (sync)
+            {
+                dm = SIMD_MM(add_ps)(dm, ddm);
+                m = SIMD_MM(add_ps)(m, dm);
+                restart = SIMD_MM(cmpge_ps)(m, one);
+                // how far back the master wrapped, and the saw with it
+                tm = SIMD_MM(and_ps)(restart, SIMD_MM(div_ps)(SIMD_MM(sub_ps)(m, one), dm));
+                m = SIMD_MM(sub_ps)(m, SIMD_MM(and_ps)(restart, one));
+            }
+
+            // the saw as far as the restart, or the whole sample without one
+            s = SIMD_MM(add_ps)(s, SIMD_MM(mul_ps)(ds, SIMD_MM(sub_ps)(one, tm)));
+            auto wrap = SIMD_MM(cmpge_ps)(s, one);
+            if (SIMD_MM(movemask_ps)(wrap))
+            {
+                auto t = SIMD_MM(add_ps)(
+                    SIMD_MM(and_ps)(wrap, SIMD_MM(div_ps)(SIMD_MM(sub_ps)(s, one), ds)), tm);
+                s = SIMD_MM(sub_ps)(s, SIMD_MM(and_ps)(wrap, one));
+                addBlep(SIMD_MM(min_ps)(t, one), SIMD_MM(and_ps)(wrap, SIMD_MM(set1_ps)(-2.f)),
+                        re, im);
+            }
+            if constexpr (sync)
+            {
+                if (SIMD_MM(movemask_ps)(restart))
+                {
+                    // from wherever the saw had got to back down to -1
+                    addBlep(SIMD_MM(min_ps)(tm, one),
+                            SIMD_MM(and_ps)(restart, SIMD_MM(mul_ps)(s, SIMD_MM(set1_ps)(-2.f))),
+                            re, im);
+                    s = SIMD_MM(or_ps)(SIMD_MM(and_ps)(restart, SIMD_MM(mul_ps)(ds, tm)),
+                                       SIMD_MM(andnot_ps)(restart, s));
+                }
+            }
+
+            auto y = SIMD_MM(sub_ps)(
+                SIMD_MM(mul_ps)(two, SIMD_MM(sub_ps)(s, SIMD_MM(mul_ps)(delay, ds))), one);
+            y = SIMD_MM(add_ps)(y, SIMD_MM(add_ps)(SIMD_MM(add_ps)(re[0], re[1]),
+                                                   SIMD_MM(add_ps)(re[2], re[3])));
+            accL[k] = SIMD_MM(add_ps)(accL[k], SIMD_MM(mul_ps)(y, gL));
+            if constexpr (stereo)
+                accR[k] = SIMD_MM(add_ps)(accR[k], SIMD_MM(mul_ps)(y, gR));
+
+            for (int p = 0; p < nPoles - 1; ++p)
+            {
+                auto r = SIMD_MM(sub_ps)(SIMD_MM(mul_ps)(re[p], stRe[p]),
+                                         SIMD_MM(mul_ps)(im[p], stIm[p]));
+                im[p] = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(re[p], stIm[p]),
+                                        SIMD_MM(mul_ps)(im[p], stRe[p]));
+                re[p] = r;
+            }
+            re[nPoles - 1] = SIMD_MM(mul_ps)(re[nPoles - 1], stRe[nPoles - 1]);
+        }
+
+        // a free running saw is its own master, so sync can come in without a jump
+        if constexpr (!sync)
+            m = s;
+        auto keep = [&](float *to, SIMD_M128 now) {
+            SIMD_MM(store_ps)(to + v0, SIMD_MM(or_ps)(SIMD_MM(and_ps)(on, now),
+                                                      SIMD_MM(andnot_ps)(on, SIMD_MM(load_ps)(
+                                                                                 to + v0))));
+        };
+        // a state far below hearing goes to zero, so it never decays into denormals
+        const auto floor = SIMD_MM(set1_ps)(1e-15f), sign = SIMD_MM(set1_ps)(-0.f);
+        auto flush = [&](SIMD_M128 x) {
+            return SIMD_MM(and_ps)(x, SIMD_MM(cmpge_ps)(SIMD_MM(andnot_ps)(sign, x), floor));
+        };
+        keep(phase, s);
+        keep(masterPhase, m);
+        for (int p = 0; p < nPoles; ++p)
+            keep(blepStateRe[p], flush(re[p]));
+        for (int p = 0; p < nPoles - 1; ++p)
+            keep(blepStateIm[p], flush(im[p]));
+    }
+};
+} // namespace sst::voice_effects::generator
+
+#endif // INCLUDE_SST_VOICE_EFFECTS_GENERATOR_UNISONEBSAW_H
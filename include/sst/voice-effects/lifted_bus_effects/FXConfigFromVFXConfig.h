@@ -87,6 +87,17 @@ template <typename BASE> struct FXConfigFromVFXConfig
     }
 
     static inline float dbToLinear(GlobalStorage *s, float f) { return s->dbToLinear(f); }
+
+    // Runtime sized bus effect memory comes from the voice effect pool
+    static inline void preReservePool(GlobalStorage *s, size_t sz) { s->preReservePool(sz); }
+    static inline uint8_t *checkoutBlock(GlobalStorage *s, size_t sz)
+    {
+        return s->checkoutBlock(sz);
+    }
+    static inline void returnBlock(GlobalStorage *s, uint8_t *d, size_t sz)
+    {
+        s->returnBlock(d, sz);
+    }
 };
 
 template <typename Inside, typename FX> struct LiftHelper
@@ -169,6 +169,7 @@ template <typename VFXConfig> struct FMFilter : core::VoiceEffectTemplateBase<VF
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         DCfilter.retainCoeffForBlock<VFXConfig::blockSize>();
 
         auto res = std::clamp(this->getFloatParam(fpRes), 0.f, 1.f);
@@ -222,6 +223,7 @@ template <typename VFXConfig> struct FMFilter : core::VoiceEffectTemplateBase<VF
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         DCfilter.retainCoeffForBlock<VFXConfig::blockSize>();
 
         auto res = std::clamp(this->getFloatParam(fpRes), 0.f, 1.f);
@@ -369,6 +369,7 @@ template <typename VFXConfig> struct VoiceFlanger : core::VoiceEffectTemplateBas
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         modLines.dispatch(lineSize(), [&](auto N) {
             auto *lines = modLines.template getLinePointer<N>();
             stereoImpl(lines, datainL, datainR, dataoutL, dataoutR, pitch);
@@ -389,6 +390,7 @@ template <typename VFXConfig> struct VoiceFlanger : core::VoiceEffectTemplateBas
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         modLines.dispatch(lineSize(), [&](auto N) {
             auto *lines = modLines.template getLinePointer<N>();
             monoImpl(lines, datain, dataout, pitch);
@@ -117,6 +117,7 @@ template <typename VFXConfig> struct FreqShiftMod : core::VoiceEffectTemplateBas
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto coarse = this->getFloatParam((int)FreqShiftModFloatParams::coarse);
         if (keytrackOn)
         {
@@ -152,6 +153,7 @@ template <typename VFXConfig> struct FreqShiftMod : core::VoiceEffectTemplateBas
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam((int)FreqShiftModIntParams::stereo))
         {
             processStereoImpl<true>(datainL, datainR, dataoutL, dataoutR, pitch);
@@ -165,6 +167,7 @@ template <typename VFXConfig> struct FreqShiftMod : core::VoiceEffectTemplateBas
     void processMonoToStereo(const float *const datainL, float *dataoutR, float *dataoutL,
                              float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         processStereoImpl<true>(datainL, datainL, dataoutL, dataoutR, pitch);
     }
 
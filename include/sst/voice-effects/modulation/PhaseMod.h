@@ -97,6 +97,7 @@ template <typename VFXConfig> struct PhaseMod : core::VoiceEffectTemplateBase<VF
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace sdsp = sst::basic_blocks::dsp;
         namespace mech = sst::basic_blocks::mechanics;
         using mode = sst::filters::CytomicSVF::Mode;
@@ -174,6 +175,7 @@ template <typename VFXConfig> struct PhaseMod : core::VoiceEffectTemplateBase<VF
 
     void processMonoToMono(const float *const datain, float *dataout, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace sdsp = sst::basic_blocks::dsp;
         namespace mech = sst::basic_blocks::mechanics;
         using mode = sst::filters::CytomicSVF::Mode;
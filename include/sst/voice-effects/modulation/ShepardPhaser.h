@@ -27,6 +27,7 @@
 #include <iostream>
 
 #include "sst/basic-blocks/mechanics/block-ops.h"
+#include "sst/basic-blocks/mechanics/simd-ops.h"
 #include "sst/basic-blocks/modulators/SimpleLFO.h"
 #include "sst/basic-blocks/dsp/RNG.h"
 
@@ -98,18 +99,7 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
         return pmd().asInt().withName("Error");
     }
 
-    void initVoiceEffect()
-    {
-        for (int i = 0; i < 24; ++i)
-        {
-            filters[i].init();
-            if (i < 12)
-            {
-                priorLevelL[i] = -12345.f;
-                priorLevelR[i] = -12345.f;
-            }
-        }
-    }
+    void initVoiceEffect() { bank.init(); }
 
     void initVoiceEffectParams() { this->initToParamMetadataDefault(this); }
 
@@ -133,6 +123,7 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto stereo = this->getIntParam(ipStereo);
         auto range = std::clamp(this->getFloatParam(fpEndFreq), -60.f, 70.f) -
                      std::clamp(this->getFloatParam(fpStartFreq), -60.f, 70.f);
@@ -154,9 +145,8 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
         phasor.process_block(lfoRate, 0.f, lfo_t::RAMP);
         auto phasorValue = phasor.lastTarget * .5f + .5f;
 
-        namespace mech = sst::basic_blocks::mechanics;
-        mech::clear_block<VFXConfig::blockSize>(dataoutL);
-        mech::clear_block<VFXConfig::blockSize>(dataoutR);
+        auto startFreq = this->getFloatParam(fpStartFreq);
+        auto srInv = this->getSampleRateInv();
 
         if (stereo)
         {
@@ -174,49 +164,13 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
                 auto iTriR = triangle(iPhaseR);
                 iTriL = iTriL * iTriL * iTriL;
                 iTriR = iTriR * iTriR * iTriR;
-                if (priorLevelL[i] < 0) // true on first block
-                {
-                    priorLevelL[i] = iTriL; // start from the first value
-                }
-                if (priorLevelR[i] < 0) // same for the right side
-                {
-                    priorLevelR[i] = iTriR;
-                }
-                // set the smoothers to start on the prior value
-                levelLerpL.set_target_instant(priorLevelL[i]);
-                levelLerpR.set_target_instant(priorLevelR[i]);
-                // and aim for the current value
-                levelLerpL.set_target(iTriL);
-                levelLerpR.set_target(iTriR);
-                // and save the index's value to start from on the next block
-                priorLevelL[i] = iTriL;
-                priorLevelR[i] = iTriR;
-                // A float per filter is a lot less memory than a lipol_sse per filter
-
-                auto freqL = 440.f * this->note_to_pitch_ignoring_tuning(
-                                         this->getFloatParam(fpStartFreq) + (range * iPhaseL));
-                auto freqR = 440.f * this->note_to_pitch_ignoring_tuning(
-                                         this->getFloatParam(fpStartFreq) + (range * iPhaseR));
-
-                filters[i].template setCoeffForBlock<VFXConfig::blockSize>(
-                    sst::filters::CytomicSVF::Mode::Bandpass, freqL, freqR, res, res,
-                    this->getSampleRateInv(), 1.f, 1.f);
-
-                float tmpL alignas(16)[VFXConfig::blockSize];
-                float tmpR alignas(16)[VFXConfig::blockSize];
-                mech::copy_from_to<VFXConfig::blockSize>(datainL, tmpL);
-                mech::copy_from_to<VFXConfig::blockSize>(datainR, tmpR);
-
-                for (int k = 0; k < VFXConfig::blockSize; ++k)
-                {
-                    filters[i].processBlockStep(tmpL[k], tmpR[k]);
-                }
-
-                levelLerpL.multiply_block(tmpL);
-                levelLerpR.multiply_block(tmpR);
+                bank.setLevel(i, iTriL, iTriR);
 
-                mech::scale_accumulate_from_to<VFXConfig::blockSize>(tmpL, tmpR, gainScale,
-                                                                     dataoutL, dataoutR);
+                auto freqL =
+                    440.f * this->note_to_pitch_ignoring_tuning(startFreq + (range * iPhaseL));
+                auto freqR =
+                    440.f * this->note_to_pitch_ignoring_tuning(startFreq + (range * iPhaseR));
+                bank.setFreq(i, freqL, freqR);
             }
         }
         else
@@ -224,46 +178,28 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
             for (int i = 0; i < peaks; ++i)
             {
                 auto offset = static_cast<double>(i) / static_cast<double>(peaks);
-                auto halfway = 0.5 / static_cast<double>(peaks);
                 auto iPhase = std::fmod(phasorValue + offset, 1.0);
 
                 auto iTri = triangle(iPhase);
                 iTri = iTri * iTri * iTri;
-                if (priorLevelL[i] < 0)
-                {
-                    priorLevelL[i] = iTri;
-                }
-                levelLerpL.set_target_instant(priorLevelL[i]);
-                levelLerpL.set_target(iTri);
-                priorLevelL[i] = iTri;
-
-                auto freq = 440.f * this->note_to_pitch_ignoring_tuning(
-                                        this->getFloatParam(fpStartFreq) + (range * iPhase));
-
-                filters[i].template setCoeffForBlock<VFXConfig::blockSize>(
-                    sst::filters::CytomicSVF::Mode::Bandpass, freq, freq, res, res,
-                    this->getSampleRateInv(), 1.f, 1.f);
-
-                float tmpL alignas(16)[VFXConfig::blockSize];
-                float tmpR alignas(16)[VFXConfig::blockSize];
-                mech::copy_from_to<VFXConfig::blockSize>(datainL, tmpL);
-                mech::copy_from_to<VFXConfig::blockSize>(datainR, tmpR);
-
-                for (int k = 0; k < VFXConfig::blockSize; ++k)
-                {
-                    filters[i].processBlockStep(tmpL[k], tmpR[k]);
-                }
+                bank.setLevel(i, iTri, iTri);
 
-                levelLerpL.multiply_2_blocks(tmpL, tmpR);
-
-                mech::scale_accumulate_from_to<VFXConfig::blockSize>(tmpL, tmpR, gainScale,
-                                                                     dataoutL, dataoutR);
+                auto freq =
+                    440.f * this->note_to_pitch_ignoring_tuning(startFreq + (range * iPhase));
+                bank.setFreq(i, freq, freq);
             }
         }
+
+        bank.setCoefficients(peaks, res, srInv);
+
+        const float *const in[2]{datainL, datainR};
+        float *const out[2]{dataoutL, dataoutR};
+        bank.template process<2>(peaks, in, gainScale, out);
     }
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto range = std::clamp(this->getFloatParam(fpEndFreq), -60.f, 70.f) -
                      std::clamp(this->getFloatParam(fpStartFreq), -60.f, 70.f);
         auto res = std::clamp(this->getFloatParam(fpResonance) * .08f + .9f, 0.f, .98f);
@@ -284,9 +220,6 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
         phasor.process_block(lfoRate, 0.f, lfo_t::RAMP);
         auto phasorValue = phasor.lastTarget * .5f + .5f;
 
-        namespace mech = sst::basic_blocks::mechanics;
-        mech::clear_block<VFXConfig::blockSize>(dataoutL);
-
         for (int i = 0; i < peaks; ++i)
         {
             auto offset = static_cast<double>(i) / static_cast<double>(peaks);
@@ -294,36 +227,17 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
 
             float iTri = triangle(iPhase);
             iTri = iTri * iTri * iTri;
-
-            if (isFirst)
-            {
-                priorLevelL[i] = iTri;
-                if (i == peaks - 1)
-                {
-                    isFirst = false;
-                }
-            }
-            levelLerpL.set_target_instant(priorLevelL[i]);
-            levelLerpL.set_target(iTri);
-            priorLevelL[i] = iTri;
+            bank.setLevel(i, iTri, iTri);
 
             auto freqMod = this->getFloatParam(fpStartFreq) + (range * iPhase);
             auto freq = 440.f * this->note_to_pitch_ignoring_tuning(freqMod);
-            filters[i].template setCoeffForBlock<VFXConfig::blockSize>(
-                sst::filters::CytomicSVF::Mode::Bandpass, freq, res, this->getSampleRateInv(), 1.f);
-
-            float tmp alignas(16)[VFXConfig::blockSize];
-            mech::copy_from_to<VFXConfig::blockSize>(datainL, tmp);
-
-            for (int k = 0; k < VFXConfig::blockSize; ++k)
-            {
-                filters[i].processBlockStep(tmp[k]);
-            }
-
-            levelLerpL.multiply_block(tmp);
-
-            mech::scale_accumulate_from_to<VFXConfig::blockSize>(tmp, gainScale, dataoutL);
+            bank.setFreq(i, freq, freq);
         }
+        bank.setCoefficients(peaks, res, this->getSampleRateInv());
+
+        const float *const in[2]{datainL, nullptr};
+        float *const out[2]{dataoutL, nullptr};
+        bank.template process<1>(peaks, in, gainScale, out);
     }
 
     void processMonoToStereo(const float *const datainL, float *dataoutL, float *dataoutR,
@@ -336,11 +250,204 @@ template <typename VFXConfig> struct ShepardPhaser : core::VoiceEffectTemplateBa
     size_t silentSamplesLength() const { return 10; }
 
   protected:
-    std::array<sst::filters::CytomicSVF, 12> filters;
+    /*
+     * The peaks' bandpasses, Cytomic SVFs as in sst::filters::CytomicSVF, held four peaks
+     * to a SIMD register with a register set per channel, so all the peaks run in one pass
+     * over the block. The caller fills in each running peak's level and frequency and then
+     * calls setCoefficients and process. Coefficients and levels ramp to their new values
+     * over the block; peaks beyond those running keep their state, coefficients and level.
+     */
+    struct BandpassBank
+    {
+        static constexpr int maxPeaks{12};
 
-    sst::basic_blocks::dsp::lipol_sse<VFXConfig::blockSize, true> levelLerpL, levelLerpR;
-    float priorLevelL[12];
-    float priorLevelR[12];
+        float freq alignas(16)[2][maxPeaks]{};
+        // negative means the next setLevel starts from its value
+        float level alignas(16)[2][maxPeaks]{}, nextLevel alignas(16)[2][maxPeaks]{};
+
+        // a1, a2, a3 of each [channel][peak], ramping from coef to target over a block
+        float coef alignas(16)[3][2][maxPeaks]{}, target alignas(16)[3][2][maxPeaks]{};
+        float ic1eq alignas(16)[2][maxPeaks]{}, ic2eq alignas(16)[2][maxPeaks]{};
+        bool coefSet[maxPeaks]{};
+
+        void init()
+        {
+            for (int c = 0; c < 2; ++c)
+            {
+                for (int p = 0; p < maxPeaks; ++p)
+                {
+                    ic1eq[c][p] = 0.f;
+                    ic2eq[c][p] = 0.f;
+                    level[c][p] = -12345.f;
+                }
+            }
+            for (auto &cs : coefSet)
+                cs = false;
+        }
+
+        void setLevel(int p, float levelL, float levelR)
+        {
+            float l[2]{levelL, levelR};
+            for (int c = 0; c < 2; ++c)
+            {
+                if (level[c][p] < 0)
+                    level[c][p] = l[c];
+                nextLevel[c][p] = l[c];
+            }
+        }
+
+        void setFreq(int p, float freqL, float freqR)
+        {
+            freq[0][p] = freqL;
+            freq[1][p] = freqR;
+        }
+
+        // tan(pi * x) for 0 <= x < 1/2, with the cephes tanf polynomial on [0, pi/4]
+        static SIMD_M128 tanPi(SIMD_M128 x)
+        {
+            const auto quarter = SIMD_MM(set1_ps)(0.25f);
+            auto big = SIMD_MM(cmpgt_ps)(x, quarter);
+            auto r = SIMD_MM(sub_ps)(SIMD_MM(set1_ps)(0.5f), x);
+            r = SIMD_MM(or_ps)(SIMD_MM(and_ps)(big, r), SIMD_MM(andnot_ps)(big, x));
+            auto z = SIMD_MM(mul_ps)(r, SIMD_MM(set1_ps)((float)M_PI));
+            auto zz = SIMD_MM(mul_ps)(z, z);
+            auto p = SIMD_MM(set1_ps)(9.38540185543e-3f);
+            p = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(p, zz), SIMD_MM(set1_ps)(3.11992232697e-3f));
+            p = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(p, zz), SIMD_MM(set1_ps)(2.44301354525e-2f));
+            p = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(p, zz), SIMD_MM(set1_ps)(5.34112807005e-2f));
+            p = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(p, zz), SIMD_MM(set1_ps)(1.33387994085e-1f));
+            p = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(p, zz), SIMD_MM(set1_ps)(3.33331568548e-1f));
+            auto t = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(SIMD_MM(mul_ps)(p, zz), z), z);
+            return SIMD_MM(or_ps)(
+                SIMD_MM(and_ps)(big, SIMD_MM(div_ps)(SIMD_MM(set1_ps)(1.f), t)),
+                SIMD_MM(andnot_ps)(big, t));
+        }
+
+        // the bandpass coefficient targets for the first nPeaks from freq, four at a time
+        void setCoefficients(int nPeaks, float res, float srInv)
+        {
+            const auto one = SIMD_MM(set1_ps)(1.f);
+            const auto k = SIMD_MM(set1_ps)(2.f - 2.f * res);
+            const auto sri = SIMD_MM(set1_ps)(srInv);
+            const auto lo = SIMD_MM(setzero_ps)(), hi = SIMD_MM(set1_ps)(0.499f);
+            for (int c = 0; c < 2; ++c)
+            {
+                for (int p0 = 0; p0 < nPeaks; p0 += 4)
+                {
+                    auto x = SIMD_MM(mul_ps)(SIMD_MM(load_ps)(freq[c] + p0), sri);
+                    auto g = tanPi(SIMD_MM(min_ps)(SIMD_MM(max_ps)(x, lo), hi));
+                    auto a1 = SIMD_MM(div_ps)(
+                        one, SIMD_MM(add_ps)(one, SIMD_MM(mul_ps)(g, SIMD_MM(add_ps)(g, k))));
+                    auto a2 = SIMD_MM(mul_ps)(g, a1);
+                    SIMD_MM(store_ps)(target[0][c] + p0, a1);
+                    SIMD_MM(store_ps)(target[1][c] + p0, a2);
+                    SIMD_MM(store_ps)(target[2][c] + p0, SIMD_MM(mul_ps)(g, a2));
+                }
+            }
+            // a peak's first coefficients apply at once
+            for (int p = 0; p < nPeaks; ++p)
+            {
+                if (coefSet[p])
+                    continue;
+                for (int i = 0; i < 3; ++i)
+                    for (int c = 0; c < 2; ++c)
+                        coef[i][c][p] = target[i][c][p];
+                coefSet[p] = true;
+            }
+        }
+
+        // out[c] = scale * sum over the peaks of level * bandpass(in[c]), for c < nChannels
+        template <int nChannels>
+        void process(int nPeaks, const float *const in[2], float scale, float *const out[2])
+        {
+            static constexpr int bs{VFXConfig::blockSize};
+            const auto bsInv = SIMD_MM(set1_ps)(1.f / bs);
+            const auto two = SIMD_MM(set1_ps)(2.f);
+            const auto peakCount = SIMD_MM(set1_ps)((float)nPeaks);
+
+            SIMD_M128 acc[nChannels][bs];
+            for (int c = 0; c < nChannels; ++c)
+                for (int k = 0; k < bs; ++k)
+                    acc[c][k] = SIMD_MM(setzero_ps)();
+
+            for (int p0 = 0; p0 < nPeaks; p0 += 4)
+            {
+                auto on = SIMD_MM(cmplt_ps)(SIMD_MM(setr_ps)(p0, p0 + 1.f, p0 + 2.f, p0 + 3.f),
+                                            peakCount);
+                auto ramp = [&](const float *from, const float *to, SIMD_M128 &v, SIMD_M128 &dv) {
+                    v = SIMD_MM(load_ps)(from + p0);
+                    dv = SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(SIMD_MM(load_ps)(to + p0), v), bsInv);
+                    dv = SIMD_MM(and_ps)(dv, on);
+                };
+                auto keep = [&](SIMD_M128 now, SIMD_M128 was) {
+                    return SIMD_MM(or_ps)(SIMD_MM(and_ps)(on, now), SIMD_MM(andnot_ps)(on, was));
+                };
+
+                // one channel at a time keeps a chain's state and ramps in registers
+                SIMD_M128 a1[nChannels], a2[nChannels], a3[nChannels], da1[nChannels],
+                    da2[nChannels], da3[nChannels], lv[nChannels], dlv[nChannels],
+                    ic1[nChannels], ic2[nChannels];
+                for (int c = 0; c < nChannels; ++c)
+                {
+                    ramp(coef[0][c], target[0][c], a1[c], da1[c]);
+                    ramp(coef[1][c], target[1][c], a2[c], da2[c]);
+                    ramp(coef[2][c], target[2][c], a3[c], da3[c]);
+                    // levels land on the new value at the last sample, as lipol_sse does
+                    ramp(level[c], nextLevel[c], lv[c], dlv[c]);
+                    lv[c] = SIMD_MM(and_ps)(SIMD_MM(add_ps)(lv[c], dlv[c]), on);
+                    ic1[c] = SIMD_MM(load_ps)(ic1eq[c] + p0);
+                    ic2[c] = SIMD_MM(load_ps)(ic2eq[c] + p0);
+                }
+
+                for (int c = 0; c < nChannels; ++c)
+                {
+                    for (int k = 0; k < bs; ++k)
+                    {
+                        auto v3 = SIMD_MM(sub_ps)(SIMD_MM(set1_ps)(in[c][k]), ic2[c]);
+                        auto v1 = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(a1[c], ic1[c]),
+                                                  SIMD_MM(mul_ps)(a2[c], v3));
+                        auto v2 = SIMD_MM(add_ps)(
+                            ic2[c], SIMD_MM(add_ps)(SIMD_MM(mul_ps)(a2[c], ic1[c]),
+                                                    SIMD_MM(mul_ps)(a3[c], v3)));
+                        ic1[c] = SIMD_MM(sub_ps)(SIMD_MM(mul_ps)(two, v1), ic1[c]);
+                        ic2[c] = SIMD_MM(sub_ps)(SIMD_MM(mul_ps)(two, v2), ic2[c]);
+
+                        acc[c][k] = SIMD_MM(add_ps)(acc[c][k], SIMD_MM(mul_ps)(v1, lv[c]));
+
+                        a1[c] = SIMD_MM(add_ps)(a1[c], da1[c]);
+                        a2[c] = SIMD_MM(add_ps)(a2[c], da2[c]);
+                        a3[c] = SIMD_MM(add_ps)(a3[c], da3[c]);
+                        lv[c] = SIMD_MM(add_ps)(lv[c], dlv[c]);
+                    }
+                }
+
+                for (int c = 0; c < nChannels; ++c)
+                {
+                    SIMD_MM(store_ps)(ic1eq[c] + p0,
+                                      keep(ic1[c], SIMD_MM(load_ps)(ic1eq[c] + p0)));
+                    SIMD_MM(store_ps)(ic2eq[c] + p0,
+                                      keep(ic2[c], SIMD_MM(load_ps)(ic2eq[c] + p0)));
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        SIMD_MM(store_ps)(coef[i][c] + p0,
+                                          keep(SIMD_MM(load_ps)(target[i][c] + p0),
+                                               SIMD_MM(load_ps)(coef[i][c] + p0)));
+                    }
+                    SIMD_MM(store_ps)(level[c] + p0, keep(SIMD_MM(load_ps)(nextLevel[c] + p0),
+                                                          SIMD_MM(load_ps)(level[c] + p0)));
+                }
+            }
+
+            namespace mech = sst::basic_blocks::mechanics;
+            for (int c = 0; c < nChannels; ++c)
+            {
+                for (int k = 0; k < bs; ++k)
+                {
+                    out[c][k] = SIMD_MM(cvtss_f32)(mech::sum_ps_to_ss(acc[c][k])) * scale;
+                }
+            }
+        }
+    } bank;
 
     int priorPeaks{0};
     float logOfPeaks{0.f};
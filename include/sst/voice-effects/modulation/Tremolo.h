@@ -457,6 +457,7 @@ template <typename VFXConfig> struct Tremolo : core::VoiceEffectTemplateBase<VFX
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam(ipHarmonic))
         {
             harmonicStereo(datainL, datainR, dataoutL, dataoutR, pitch);
@@ -473,6 +474,7 @@ template <typename VFXConfig> struct Tremolo : core::VoiceEffectTemplateBase<VFX
     // ...this second one if incoming audio is Mono...
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         if (this->getIntParam(ipHarmonic))
         {
             harmonicMono(datainL, dataoutL, pitch);
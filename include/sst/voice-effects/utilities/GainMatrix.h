@@ -80,6 +80,7 @@ template <typename VFXConfig> struct GainMatrix : core::VoiceEffectTemplateBase<
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
 
         llLerp.set_target(this->getFloatParam(fpLeftToLeft));
         float ll alignas(16)[VFXConfig::blockSize];
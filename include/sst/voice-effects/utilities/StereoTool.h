@@ -88,6 +88,7 @@ struct StereoTool : core::VoiceEffectTemplateBase<VFXConfig>,
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         namespace mech = basic_blocks::mechanics;
         namespace pan = basic_blocks::dsp::pan_laws;
 
@@ -86,6 +86,7 @@ template <typename VFXConfig> struct VolumeAndPan : core::VoiceEffectTemplateBas
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         auto pan = (this->getFloatParam(fpPan) + 1) / 2;
         basic_blocks::dsp::pan_laws::panmatrix_t pmat{1, 1, 0, 0};
         basic_blocks::dsp::pan_laws::stereoEqualPower(pan, pmat);
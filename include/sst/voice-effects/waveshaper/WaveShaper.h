@@ -217,6 +217,7 @@ template <typename VFXConfig> struct WaveShaper : core::VoiceEffectTemplateBase<
     void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
                        float *dataoutR, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         bool hpActive = !this->getIsDeactivated((int)WaveShaperFloatParams::highpass);
         bool lpActive = !this->getIsDeactivated((int)WaveShaperFloatParams::lowpass);
         namespace mech = sst::basic_blocks::mechanics;
@@ -254,6 +255,7 @@ template <typename VFXConfig> struct WaveShaper : core::VoiceEffectTemplateBase<
 
     void processMonoToMono(const float *const datainL, float *dataoutL, float pitch)
     {
+        auto profile = this->processProfileScope(streamingName);
         bool hpActive = !this->getIsDeactivated((int)WaveShaperFloatParams::highpass);
         bool lpActive = !this->getIsDeactivated((int)WaveShaperFloatParams::lowpass);
         namespace mech = sst::basic_blocks::mechanics;
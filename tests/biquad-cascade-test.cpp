@@ -0,0 +1,124 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/voice-effects/VoiceEffectCore.h"
+#include "sst/voice-effects/eq/BiquadCascade.h"
+
+#include "vtest-config.h"
+
+static constexpr int bs{VTestConfig::blockSize};
+static constexpr int nBands{6};
+
+using base_t = sst::voice_effects::core::VoiceEffectTemplateBase<VTestConfig>;
+using filter_t = base_t::BiquadFilterType;
+
+TEST_CASE("Biquad Cascade Matches Lagged BiquadFilter Bands")
+{
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::uniform_real_distribution<double> oct(-3, 4), bwd(0.2, 3), dbd(-18, 18);
+
+    // the bands as the EQs ran them before the cascade, one BiquadFilter each
+    base_t base;
+    std::vector<filter_t> ref(nBands, filter_t(&base));
+    sst::voice_effects::eq::BiquadCascade<nBands, bs> cascade;
+    bool active[nBands];
+
+    auto design = [&](int b) {
+        auto &f = ref[b];
+        auto w = f.calc_omega(oct(gen));
+        auto db = dbd(gen);
+        // MorphEQ designs with peakEQ, EqNBandParametric with orfanidisEQ
+        if (b % 2)
+            f.coeff_peakEQ(w, bwd(gen), db);
+        else
+            f.coeff_orfanidisEQ(w, bwd(gen), base.dbToLinear(db), base.dbToLinear(db * 0.5f), 1);
+        cascade.setCoefficientsFrom(b, f);
+    };
+    for (int b = 0; b < nBands; ++b)
+    {
+        active[b] = true;
+        design(b);
+    }
+
+    for (auto stereo : {true, false})
+    {
+        INFO("Stereo " << stereo);
+        for (int blk = 0; blk < 4000; ++blk)
+        {
+            // steady stretches long enough to settle, and runs of per block modulation
+            if (blk % 1000 == 0 || (blk % 1000 > 500 && blk % 1000 < 600))
+                design(blk % nBands);
+            if (blk % 700 == 0)
+            {
+                auto b = (blk / 700) % nBands;
+                active[b] = !active[b];
+                cascade.setActive(b, active[b]);
+            }
+
+            float inL alignas(16)[bs], inR alignas(16)[bs];
+            float outL alignas(16)[bs], outR alignas(16)[bs];
+            for (int i = 0; i < bs; ++i)
+            {
+                inL[i] = noise(gen);
+                inR[i] = noise(gen);
+            }
+
+            if (stereo)
+                cascade.processBlock(inL, inR, outL, outR);
+            else
+                cascade.processBlock(inL, outL);
+
+            // process_block_to doesn't run in place, so the bands ping pong between two
+            float refL alignas(16)[2][bs], refR alignas(16)[2][bs];
+            int cur{0};
+            for (int i = 0; i < bs; ++i)
+            {
+                refL[0][i] = inL[i];
+                refR[0][i] = inR[i];
+            }
+            for (int b = 0; b < nBands; ++b)
+            {
+                if (!active[b])
+                    continue;
+                if (stereo)
+                    ref[b].process_block_to(refL[cur], refR[cur], refL[1 - cur], refR[1 - cur]);
+                else
+                    ref[b].process_block_to(refL[cur], refL[1 - cur]);
+                cur = 1 - cur;
+            }
+
+            for (int i = 0; i < bs; ++i)
+            {
+                INFO("Block " << blk << " sample " << i);
+                REQUIRE(outL[i] == Approx(refL[cur][i]).margin(1e-6));
+                if (stereo)
+                    REQUIRE(outR[i] == Approx(refR[cur][i]).margin(1e-6));
+            }
+        }
+    }
+}
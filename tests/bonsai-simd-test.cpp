@@ -0,0 +1,136 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cmath>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/effects/Bonsai.h"
+
+namespace bon = sst::effects::bonsai;
+
+// 8 is the avx2 width when built for it, 12 is not a multiple of it
+template <size_t bs> void checkHelpers()
+{
+    INFO("Block size " << bs);
+    std::mt19937 gen(8675309);
+    auto fill = [&](float *f, float lo, float hi) {
+        std::uniform_real_distribution<float> dist(lo, hi);
+        for (size_t i = 0; i < bs; ++i)
+            f[i] = dist(gen);
+    };
+    auto requireClose = [](const float *a, const float *b, float tol) {
+        for (size_t i = 0; i < bs; ++i)
+        {
+            INFO("Sample " << i << " " << a[i] << " " << b[i]);
+            REQUIRE(std::isfinite(b[i]));
+            REQUIRE(std::fabs(a[i] - b[i]) <= tol * std::max(1.f, std::fabs(a[i])));
+        }
+    };
+
+    float src alignas(16)[bs], lev alignas(16)[bs], a alignas(16)[bs], b alignas(16)[bs];
+
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        // clippers are driven well past their knee in bonsai
+        fill(src, -40.f, 40.f);
+        fill(lev, 0.01f, 0.3f);
+
+        {
+            INFO("Inverse Sinh");
+            bon::clip_inv_sinh<bs>(0.07f, src, a);
+            bon::simd::clip_inv_sinh<bs>(0.07f, src, b);
+            requireClose(a, b, 1e-6);
+            bon::clip_inv_sinh<bs>(lev, src, a);
+            bon::simd::clip_inv_sinh<bs>(lev, src, b);
+            requireClose(a, b, 1e-6);
+        }
+
+        {
+            INFO("Tanh");
+            bon::clip_tanh78<bs>(lev, src, a);
+            bon::simd::clip_tanh78<bs>(lev, src, b);
+            requireClose(a, b, 0);
+            bon::clip_tanh76<bs>(0.5f, 2.f, src, a);
+            bon::simd::clip_tanh76<bs>(0.5f, 2.f, src, b);
+            requireClose(a, b, 1e-6);
+            bon::clip_tanh_foldback<bs>(0.1f, src, a);
+            bon::simd::clip_tanh_foldback<bs>(0.1f, src, b);
+            requireClose(a, b, 1e-6);
+        }
+
+        {
+            INFO("Sine Tanh");
+            bon::clip_sine_tanh<bs>(0.05f, src, a);
+            bon::simd::clip_sine_tanh<bs>(0.05f, src, b);
+            requireClose(a, b, 2e-5);
+            bon::clip_sine_tanh<bs>(lev, src, a);
+            bon::simd::clip_sine_tanh<bs>(lev, src, b);
+            requireClose(a, b, 2e-5);
+        }
+
+        {
+            INFO("Coefficients");
+            fill(src, 1.f, 23000.f);
+            bon::freq_sr_to_alpha_reaktor<bs>(src, 48000, a);
+            bon::simd::freq_sr_to_alpha_reaktor<bs>(src, 48000, b);
+            requireClose(a, b, 1e-6);
+            bon::freq_twopi_dt_to_alpha<bs>(src, 2 * M_PI / 48000, a);
+            bon::simd::freq_twopi_dt_to_alpha<bs>(src, 2 * M_PI / 48000, b);
+            requireClose(a, b, 1e-5);
+        }
+
+        {
+            INFO("Arithmetic");
+            bon::rerange<bs>(src, -40.f, 40.f, 0.f, 2.f, nullptr, a);
+            bon::simd::rerange<bs>(src, -40.f, 40.f, 0.f, 2.f, nullptr, b);
+            requireClose(a, b, 0);
+            bon::lerp<bs>(src, lev, 0.3f, a);
+            bon::simd::lerp<bs>(src, lev, 0.3f, b);
+            requireClose(a, b, 0);
+            bon::clampbi<bs>(1.f, src, a);
+            bon::simd::clampbi<bs>(1.f, src, b);
+            requireClose(a, b, 0);
+            bon::invsq<bs>(lev, a);
+            bon::simd::invsq<bs>(lev, b);
+            requireClose(a, b, 0);
+        }
+    }
+
+    {
+        INFO("Noise");
+        float la = 1, lb = 1;
+        for (int blk = 0; blk < 20; ++blk)
+        {
+            bon::noise<bs>(la, a);
+            bon::simd::noise<bs>(lb, b);
+            REQUIRE(la == lb);
+            requireClose(a, b, 1e-7);
+        }
+    }
+}
+
+TEST_CASE("Bonsai SIMD Helpers Match Scalar")
+{
+    checkHelpers<16>();
+    checkHelpers<12>();
+}
@@ -0,0 +1,197 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/voice-effects/dynamics/Compressor.h"
+
+#include "vtest-config.h"
+
+using comp_t = sst::voice_effects::dynamics::Compressor<VTestConfig>;
+static constexpr int bs{VTestConfig::blockSize};
+
+TEST_CASE("Compressor Gain Computer Matches dB Functions")
+{
+    std::mt19937 gen(8675309);
+    // envelopes from below the -120dB floor to well over full scale, spread in log
+    std::uniform_real_distribution<float> ldist(-8.f, 1.f);
+
+    for (auto [thresh, ratio] : {std::pair{0.f, 2.f}, {-24.f, 4.f}, {-48.f, 12.f}})
+    {
+        INFO("Threshold " << thresh << " ratio " << ratio);
+        for (int trial = 0; trial < 200; ++trial)
+        {
+            float env alignas(16)[bs], gain alignas(16)[bs];
+            for (int i = 0; i < bs; ++i)
+                env[i] = std::pow(10.f, ldist(gen));
+
+            comp_t::gainComputerBlock(env, thresh, 1 / ratio, gain);
+            for (int i = 0; i < bs; ++i)
+            {
+                auto db = comp_t::amplitudeToDecibels(env[i]);
+                auto red = db > thresh ? thresh + (db - thresh) / ratio - db : 0.f;
+                auto ref = comp_t::decibelsToAmplitude(red);
+                INFO("Envelope " << env[i] << " gain " << gain[i] << " expected " << ref);
+                REQUIRE(gain[i] == Approx(ref).epsilon(2e-6));
+            }
+
+            float again alignas(16)[bs];
+            comp_t::gainComputerBlock(env, thresh, 1 / ratio, again);
+            REQUIRE(memcmp(gain, again, sizeof(gain)) == 0);
+        }
+    }
+}
+
+// the per sample detector and gain computer processStereo and processMonoToMono used to run
+struct PerSampleCompressor : comp_t
+{
+    void processStereo(const float *const datainL, const float *const datainR, float *dataoutL,
+                       float *dataoutR, float pitch)
+    {
+        gainLerp.set_target(decibelsToAmplitude(this->getFloatParam(fpMakeUp)));
+        bool RMS = this->getIntParam(ipDetector);
+        auto threshold_db = this->getFloatParam(fpThreshold);
+        auto ratio_recip = 1 / this->getFloatParam(fpRatio);
+        const auto T = this->getSampleRateInv();
+        auto attack_coeffs = computeBallisticCoeffs(this->getFloatParam(fpAttack), T);
+        auto release_coeffs = computeBallisticCoeffs(this->getFloatParam(fpRelease), T);
+        if (first)
+        {
+            lastEnv = 0.f;
+            RA.reset();
+            first = false;
+        }
+        setTiltCoeffs(pitch);
+
+        for (int i = 0; i < bs; i++)
+        {
+            auto g = gain((datainL[i] + datainR[i]) / 2, RMS, threshold_db, ratio_recip,
+                          attack_coeffs, release_coeffs);
+            dataoutL[i] = datainL[i] * g;
+            dataoutR[i] = datainR[i] * g;
+        }
+        gainLerp.multiply_2_blocks(dataoutL, dataoutR);
+    }
+
+    void processMonoToMono(const float *const datain, float *dataout, float pitch)
+    {
+        gainLerp.set_target(decibelsToAmplitude(this->getFloatParam(fpMakeUp)));
+        bool RMS = this->getIntParam(ipDetector);
+        auto threshold_db = this->getFloatParam(fpThreshold);
+        auto ratio_recip = 1 / this->getFloatParam(fpRatio);
+        const auto T = this->getSampleRateInv();
+        auto attack_coeffs = computeBallisticCoeffs(this->getFloatParam(fpAttack), T);
+        auto release_coeffs = computeBallisticCoeffs(this->getFloatParam(fpRelease), T);
+        if (first)
+        {
+            lastEnv = 0.f;
+            first = false;
+        }
+        setTiltCoeffs(pitch);
+
+        for (int i = 0; i < bs; i++)
+            dataout[i] = datain[i] * gain(datain[i], RMS, threshold_db, ratio_recip,
+                                          attack_coeffs, release_coeffs);
+        gainLerp.multiply_block(dataout);
+    }
+
+    float gain(float sidechain, bool RMS, float threshold_db, float ratio_recip,
+               BallisticCoeffs attack_coeffs, BallisticCoeffs release_coeffs)
+    {
+        filters[0].processBlockStep(sidechain);
+        filters[1].processBlockStep(sidechain);
+        float env = fabsf(sidechain);
+        if (RMS)
+            env = RA.step(env);
+        env = setBallistics(env, lastEnv, attack_coeffs, release_coeffs);
+        env = amplitudeToDecibels(env);
+
+        float reductionFactorDB = 0.0f;
+        if (env > threshold_db)
+            reductionFactorDB = threshold_db + (env - threshold_db) * ratio_recip - env;
+        return decibelsToAmplitude(reductionFactorDB);
+    }
+};
+
+TEST_CASE("Compressor Block Detector Matches Per Sample Path")
+{
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-1.f, 1.f);
+
+    for (auto stereo : {true, false})
+    {
+        for (auto rms : {0, 1})
+        {
+            INFO("Stereo " << stereo << " RMS " << rms);
+            auto fx = std::make_unique<comp_t>();
+            auto ref = std::make_unique<PerSampleCompressor>();
+            for (comp_t *c : {fx.get(), (comp_t *)ref.get()})
+            {
+                c->initVoiceEffect();
+                c->initVoiceEffectParams();
+                c->setFloatParam(comp_t::fpThreshold, -30.f);
+                c->setFloatParam(comp_t::fpRatio, 6.f);
+                c->setFloatParam(comp_t::fpAttack, 0.002f);
+                c->setFloatParam(comp_t::fpRelease, 0.05f);
+                c->setFloatParam(comp_t::fpMakeUp, 6.f);
+                c->setFloatParam(comp_t::fpSCTiltAmt, 9.f);
+                c->setIntParam(comp_t::ipDetector, rms);
+            }
+
+            for (int blk = 0; blk < 2000; ++blk)
+            {
+                // bursts and gaps so the detector both attacks and releases
+                auto level = (blk / 100) % 2 ? 0.9f : 0.02f;
+                float inL alignas(16)[bs], inR alignas(16)[bs];
+                float outL alignas(16)[bs], outR alignas(16)[bs];
+                float refL alignas(16)[bs], refR alignas(16)[bs];
+                for (int i = 0; i < bs; ++i)
+                {
+                    inL[i] = level * noise(gen);
+                    inR[i] = level * noise(gen);
+                }
+
+                if (stereo)
+                {
+                    fx->processStereo(inL, inR, outL, outR, 0.f);
+                    ref->processStereo(inL, inR, refL, refR, 0.f);
+                }
+                else
+                {
+                    fx->processMonoToMono(inL, outL, 0.f);
+                    ref->processMonoToMono(inL, refL, 0.f);
+                }
+
+                for (int i = 0; i < bs; ++i)
+                {
+                    INFO("Block " << blk << " sample " << i);
+                    REQUIRE(outL[i] == Approx(refL[i]).margin(1e-7).epsilon(2e-6));
+                    if (stereo)
+                        REQUIRE(outR[i] == Approx(refR[i]).margin(1e-7).epsilon(2e-6));
+                }
+            }
+        }
+    }
+}
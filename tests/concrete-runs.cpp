@@ -18,7 +18,12 @@
  * https://github.com/surge-synthesizer/sst-effects
  */
 
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "catch2.hpp"
 #include "sst/basic-blocks/simd/setup.h"
@@ -103,4 +108,336 @@ TEST_CASE("Can Run Types with Concrete Config")
     {
         Tester<sst::effects::rotaryspeaker::RotarySpeaker<sfx::core::ConcreteConfig>>::TestFX();
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Ringout Tracker Sleeps and Wakes")
+{
+    using FX = sfx::reverb1::Reverb1<sfx::core::ConcreteConfig>;
+    static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+    fx->initialize();
+
+    FX::RingoutTracker tracker;
+    float L alignas(16)[bs], R alignas(16)[bs];
+
+    float phase = 0.f;
+    for (int blocks = 0; blocks < 100; ++blocks)
+    {
+        for (int s = 0; s < bs; ++s)
+        {
+            L[s] = 0.5f * std::sin(phase);
+            R[s] = L[s];
+            phase += 0.03f;
+        }
+        REQUIRE(tracker.shouldProcess(fx.get(), L, R));
+        fx->processBlock(L, R);
+        tracker.trackOutput(L, R);
+    }
+
+    auto ringout = fx->getRingoutDecay();
+    REQUIRE(ringout > 0);
+
+    int processed{0};
+    for (int blocks = 0; blocks < ringout + 10; ++blocks)
+    {
+        std::fill(L, L + bs, 0.f);
+        std::fill(R, R + bs, 0.f);
+        if (!tracker.shouldProcess(fx.get(), L, R))
+            break;
+        fx->processBlock(L, R);
+        tracker.trackOutput(L, R);
+        processed++;
+    }
+    REQUIRE(tracker.isSleeping());
+    REQUIRE(processed == ringout);
+
+    // and wakes up on the first non-silent block
+    std::fill(L, L + bs, 0.f);
+    std::fill(R, R + bs, 0.f);
+    R[7] = 0.2f;
+    REQUIRE(tracker.shouldProcess(fx.get(), L, R));
+    REQUIRE(!tracker.isSleeping());
+}
+
+template <typename FX> struct MultiBlockTester
+{
+    // processBlocks over uneven spans should match processBlock one block at a time
+    static void TestFX()
+    {
+        INFO("Multi block test with " << FX::streamingName);
+        static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+        static constexpr int nBlocks{200};
+
+        auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+        auto es = sfx::core::ConcreteConfig::EffectStorage();
+        auto fxA = std::make_unique<FX>(&gs, &es, nullptr);
+        auto fxB = std::make_unique<FX>(&gs, &es, nullptr);
+        for (int i = 0; i < FX::numParams; ++i)
+        {
+            fxA->paramStorage[i] = fxA->paramAt(i).defaultVal;
+            fxB->paramStorage[i] = fxB->paramAt(i).defaultVal;
+        }
+        fxA->initialize();
+        fxB->initialize();
+
+        std::vector<float> aL(nBlocks * bs), aR(nBlocks * bs);
+        float phase = 0.f;
+        for (int s = 0; s < nBlocks * bs; ++s)
+        {
+            aL[s] = 0.5f * std::sin(phase);
+            aR[s] = 0.4f * std::sin(phase * 1.3f);
+            phase += 0.03f;
+        }
+        auto bL = aL, bR = aR;
+
+        for (int i = 0; i < nBlocks; ++i)
+            fxA->processBlock(aL.data() + i * bs, aR.data() + i * bs);
+
+        int done{0}, span{1};
+        while (done < nBlocks)
+        {
+            auto n = std::min(span, nBlocks - done);
+            sfx::core::processBlocks(fxB.get(), bL.data() + done * bs, bR.data() + done * bs, n);
+            done += n;
+            span = span * 3 % 37;
+        }
+
+        for (int s = 0; s < nBlocks * bs; ++s)
+        {
+            REQUIRE(aL[s] == bL[s]);
+            REQUIRE(aR[s] == bR[s]);
+        }
+    }
+};
+
+TEST_CASE("Multi Block Processing Matches Single Blocks")
+{
+    SECTION("Reverb1")
+    {
+        MultiBlockTester<sfx::reverb1::Reverb1<sfx::core::ConcreteConfig>>::TestFX();
+    }
+    SECTION("Flanger")
+    {
+        MultiBlockTester<sfx::flanger::Flanger<sfx::core::ConcreteConfig>>::TestFX();
+    }
+}
+
+TEST_CASE("Nimbus Async Mode")
+{
+    using FX = sfx::nimbus::Nimbus<sfx::core::ConcreteConfig>;
+    static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+    fx->initialize();
+
+    REQUIRE(fx->getLatencySamples() == 0);
+    fx->setAsyncProcessing(true);
+
+#if SST_EFFECTS_EURORACK
+    REQUIRE(fx->isAsyncProcessing());
+    REQUIRE(fx->getLatencySamples() == FX::asyncLatencyBlocks * bs);
+
+    // fully wet, so the latency is exact silence whatever the worker is doing
+    fx->paramStorage[FX::nmb_mix] = 1.f;
+    float L alignas(16)[bs], R alignas(16)[bs];
+    float phase = 0.f;
+    for (int blocks = 0; blocks < 4 * FX::asyncLatencyBlocks; ++blocks)
+    {
+        for (int s = 0; s < bs; ++s)
+        {
+            L[s] = 0.5f * std::sin(phase);
+            R[s] = L[s];
+            phase += 0.03f;
+        }
+        fx->processBlock(L, R);
+        for (int s = 0; s < bs; ++s)
+        {
+            if (blocks < FX::asyncLatencyBlocks)
+            {
+                REQUIRE(L[s] == 0.f);
+                REQUIRE(R[s] == 0.f);
+            }
+            REQUIRE(std::isfinite(L[s]));
+            REQUIRE(std::isfinite(R[s]));
+        }
+    }
+
+    // initialize keeps the worker, and switching off goes back to the audio thread
+    fx->initialize();
+    REQUIRE(fx->isAsyncProcessing());
+    fx->setAsyncProcessing(false);
+    REQUIRE(fx->getLatencySamples() == 0);
+    for (int blocks = 0; blocks < 10; ++blocks)
+    {
+        for (int s = 0; s < bs; ++s)
+            L[s] = R[s] = 0.1f;
+        fx->processBlock(L, R);
+        for (int s = 0; s < bs; ++s)
+            REQUIRE(std::isfinite(L[s]));
+    }
+#endif
+}
+
+#if SST_EFFECTS_EURORACK
+// reaches into the async rings to stall the worker and see how far ahead the wet is
+struct NimbusAsyncProbe : sfx::nimbus::Nimbus<sfx::core::ConcreteConfig>
+{
+    using base_t = sfx::nimbus::Nimbus<sfx::core::ConcreteConfig>;
+    using base_t::base_t;
+
+    void stall() { stopWorker(); }
+    void resume()
+    {
+        workerRunning = true;
+        worker = std::thread([this]() { runWorker(); });
+    }
+    void settle()
+    {
+        while (asyncResetPending || !asyncIn->empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    int wetBlocksReady() const { return (int)asyncOut->size(); }
+    int blocksOwed() const { return asyncBlocksOwed; }
+    std::thread::id workerId() const { return worker.get_id(); }
+};
+#endif
+
+TEST_CASE("Nimbus Async Mode Keeps Its Latency When The Worker Falls Behind")
+{
+#if SST_EFFECTS_EURORACK
+    using FX = NimbusAsyncProbe;
+    static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+    static constexpr int latency{FX::asyncLatencyBlocks * bs};
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+    fx->initialize();
+
+    // fully dry, and long enough for the mix to glide all the way there
+    fx->paramStorage[FX::nmb_mix] = 0.f;
+    float L alignas(16)[bs], R alignas(16)[bs];
+    for (int blocks = 0; blocks < 3000; ++blocks)
+    {
+        memset(L, 0, sizeof(L));
+        memset(R, 0, sizeof(R));
+        fx->processBlock(L, R);
+    }
+
+    // so from here the output is exactly the input, as late as the reported latency
+    fx->setAsyncProcessing(true);
+    REQUIRE(fx->getLatencySamples() == latency);
+    auto signal = [](int n) { return n < 0 ? 0.f : 0.5f * std::sin(0.03f * n); };
+    int n{0};
+    auto run = [&](int blocks, bool keepUp) {
+        for (int b = 0; b < blocks; ++b)
+        {
+            for (int s = 0; s < bs; ++s)
+            {
+                L[s] = signal(n + s);
+                R[s] = -L[s];
+            }
+            fx->processBlock(L, R);
+            for (int s = 0; s < bs; ++s)
+            {
+                INFO("Sample " << n + s);
+                REQUIRE(L[s] == Approx(signal(n + s - latency)).margin(1e-20));
+                REQUIRE(R[s] == Approx(-signal(n + s - latency)).margin(1e-20));
+            }
+            n += bs;
+            if (keepUp)
+                fx->settle();
+        }
+    };
+
+    run(FX::asyncLatencyBlocks, true);
+    REQUIRE(fx->wetBlocksReady() == FX::asyncLatencyBlocks);
+    REQUIRE(fx->blocksOwed() == 0);
+
+    // stall for long enough that the wet runs dry and the input ring overflows
+    fx->stall();
+    run(4 * FX::asyncLatencyBlocks, false);
+    REQUIRE(fx->wetBlocksReady() == 0);
+    REQUIRE(fx->blocksOwed() > 0);
+
+    // once the worker catches up, the wet is back to exactly the reported latency ahead
+    fx->resume();
+    fx->settle();
+    run(2, true);
+    REQUIRE(fx->blocksOwed() == 0);
+    REQUIRE(fx->wetBlocksReady() == FX::asyncLatencyBlocks);
+#endif
+}
+
+TEST_CASE("Nimbus Async Initialize Resets Through The Running Worker")
+{
+#if SST_EFFECTS_EURORACK
+    using FX = NimbusAsyncProbe;
+    static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+    static constexpr int latency{FX::asyncLatencyBlocks * bs};
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+    fx->initialize();
+    fx->paramStorage[FX::nmb_mix] = 1.f;
+    fx->setAsyncProcessing(true);
+    auto id = fx->workerId();
+
+    float L alignas(16)[bs], R alignas(16)[bs];
+    auto run = [&](int blocks) {
+        for (int b = 0; b < blocks; ++b)
+        {
+            for (int s = 0; s < bs; ++s)
+                L[s] = R[s] = 0.5f * std::sin(0.03f * (b * bs + s));
+            fx->processBlock(L, R);
+            fx->settle();
+        }
+    };
+    run(4 * FX::asyncLatencyBlocks);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (i == 0)
+            fx->initialize();
+        else if (i == 1)
+            fx->suspendProcessing();
+        else
+            fx->onSampleRateChanged();
+        REQUIRE(fx->workerId() == id);
+        REQUIRE(fx->getLatencySamples() == latency);
+
+        // the reset leaves the worker exactly the latency ahead, with nothing owed, and
+        // the wet starts again from the prefilled silence
+        fx->settle();
+        REQUIRE(fx->wetBlocksReady() == FX::asyncLatencyBlocks);
+        REQUIRE(fx->blocksOwed() == 0);
+        for (int b = 0; b < FX::asyncLatencyBlocks; ++b)
+        {
+            for (int s = 0; s < bs; ++s)
+                L[s] = R[s] = 0.5f;
+            fx->processBlock(L, R);
+            fx->settle();
+            for (int s = 0; s < bs; ++s)
+            {
+                REQUIRE(L[s] == 0.f);
+                REQUIRE(R[s] == 0.f);
+            }
+        }
+        run(2 * FX::asyncLatencyBlocks);
+    }
+#endif
+}
@@ -55,30 +55,8 @@
 #include "sst/voice-effects/lifted_bus_effects/LiftedReverb2.h"
 #include "sst/voice-effects/lifted_bus_effects/LiftedDelay.h"
 
-struct VTestConfig
-{
-    struct BaseClass
-    {
-        std::array<float, 256> fb{};
-        std::array<int, 256> ib{};
-    };
-    static constexpr int blockSize{16};
-    static void setFloatParam(BaseClass *b, int i, float f) { b->fb[i] = f; }
-    static float getFloatParam(const BaseClass *b, int i) { return b->fb[i]; }
+#include "vtest-config.h"
 
-    static void setIntParam(BaseClass *b, int i, int v) { b->ib[i] = v; }
-    static int getIntParam(const BaseClass *b, int i) { return b->ib[i]; }
-
-    static float dbToLinear(const BaseClass *, float f) { return 1.f; }
-    static float equalNoteToPitch(const BaseClass *, float f) { return pow(2.f, (f + 69) / 12.f); }
-    static float getSampleRate(const BaseClass *) { return 48000.f; }
-    static float getSampleRateInv(const BaseClass *) { return 1.0 / 48000.f; }
-
-    static void preReservePool(BaseClass *, size_t) {}
-    static void preReserveSingleInstancePool(BaseClass *, size_t) {}
-    static uint8_t *checkoutBlock(BaseClass *, size_t s) { return (uint8_t *)malloc(s); }
-    static void returnBlock(BaseClass *, uint8_t *p, size_t) { free(p); }
-};
 template <typename T> struct VTester
 {
     template <class... Args> static void TestVFX(Args &&...a)
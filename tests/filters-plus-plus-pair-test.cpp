@@ -0,0 +1,110 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <memory>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/voice-effects/filter/FiltersPlusPlus.h"
+
+#include "vtest-config.h"
+
+template <sst::filtersplusplus::FilterModel Model> void pairMatchesTwoVoices(float extra)
+{
+    using voice_t = sst::voice_effects::filter::FiltersPlusPlus<VTestConfig, Model>;
+    using pair_t = sst::voice_effects::filter::FiltersPlusPlusPair<VTestConfig, Model>;
+    static constexpr int bs{VTestConfig::blockSize};
+
+    // the same two voices twice over, one set run alone and one through the pair
+    auto setup = [extra](voice_t &v, float cutoffL, float cutoffR, bool stereo, bool keytrack) {
+        v.initVoiceEffectParams();
+        v.setFloatParam(voice_t::fpCutoffL, cutoffL);
+        v.setFloatParam(voice_t::fpCutoffR, cutoffR);
+        v.setFloatParam(voice_t::fpResonance, 0.6f);
+        v.setFloatParam(voice_t::fpExtra, extra);
+        v.setIntParam(voice_t::ipStereo, stereo);
+        v.enableKeytrack(keytrack);
+        v.initVoiceEffect();
+    };
+
+    auto soloA = std::make_unique<voice_t>(), soloB = std::make_unique<voice_t>();
+    auto pairedA = std::make_unique<voice_t>(), pairedB = std::make_unique<voice_t>();
+    for (auto *v : {soloA.get(), pairedA.get()})
+        setup(*v, -12.f, -12.f, false, true);
+    for (auto *v : {soloB.get(), pairedB.get()})
+        setup(*v, 5.f, 19.f, true, false);
+
+    auto pair = std::make_unique<pair_t>();
+    REQUIRE(pair_t::canShareFilter(*pairedA, *pairedB));
+    pair->initPair(*pairedA, *pairedB);
+
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f), cutoff(-36.f, 36.f);
+
+    float inAL alignas(16)[bs], inAR alignas(16)[bs], inBL alignas(16)[bs], inBR alignas(16)[bs];
+    float sAL alignas(16)[bs], sAR alignas(16)[bs], sBL alignas(16)[bs], sBR alignas(16)[bs];
+    float pAL alignas(16)[bs], pAR alignas(16)[bs], pBL alignas(16)[bs], pBR alignas(16)[bs];
+    for (int blk = 0; blk < 1000; ++blk)
+    {
+        // voice A sweeps while B holds, so one pair of lanes glides and the other is frozen
+        if (blk % 50 == 0)
+        {
+            auto c = cutoff(gen);
+            soloA->setFloatParam(voice_t::fpCutoffL, c);
+            pairedA->setFloatParam(voice_t::fpCutoffL, c);
+        }
+        for (int i = 0; i < bs; ++i)
+        {
+            inAL[i] = noise(gen);
+            inAR[i] = noise(gen);
+            inBL[i] = noise(gen);
+            inBR[i] = noise(gen);
+        }
+        auto pitchA = 60.f + (blk % 7), pitchB = 48.f;
+
+        soloA->processStereo(inAL, inAR, sAL, sAR, pitchA);
+        soloB->processStereo(inBL, inBR, sBL, sBR, pitchB);
+        pair->processStereo2Voices(*pairedA, inAL, inAR, pAL, pAR, pitchA, *pairedB, inBL, inBR,
+                                   pBL, pBR, pitchB);
+
+        for (int i = 0; i < bs; ++i)
+        {
+            INFO("Block " << blk << " sample " << i);
+            REQUIRE(pAL[i] == Approx(sAL[i]).margin(1e-6));
+            REQUIRE(pAR[i] == Approx(sAR[i]).margin(1e-6));
+            REQUIRE(pBL[i] == Approx(sBL[i]).margin(1e-6));
+            REQUIRE(pBR[i] == Approx(sBR[i]).margin(1e-6));
+        }
+    }
+}
+
+TEST_CASE("Filters++ Pair Matches Two Voices Lane For Lane")
+{
+    SECTION("CytomicSVF")
+    {
+        pairMatchesTwoVoices<sst::filtersplusplus::FilterModel::CytomicSVF>(3.f);
+    }
+    SECTION("VemberClassic")
+    {
+        pairMatchesTwoVoices<sst::filtersplusplus::FilterModel::VemberClassic>(0.f);
+    }
+}
@@ -0,0 +1,269 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+#include "sst/basic-blocks/dsp/SSESincDelayLine.h"
+
+#include "sst/effects/ConcreteConfig.h"
+#include "sst/effects/FloatyDelay.h"
+
+namespace sfx = sst::effects;
+using FX = sfx::floatydelay::FloatyDelay<sfx::core::ConcreteConfig>;
+static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+
+// processBlock as it was before the read head and the line were split: two SSESincDelayLines,
+// read and written one sample at a time
+struct FloatyReference : FX
+{
+    using line_t = sst::basic_blocks::dsp::SSESincDelayLine<max_delay_length>;
+    line_t delayLineL{sincTable};
+    line_t delayLineR{sincTable};
+
+    using FX::FX;
+
+    void initialize()
+    {
+        FX::initialize();
+        delayLineL.clear();
+        delayLineR.clear();
+    }
+
+    void processBlock(float *dataL, float *dataR)
+    {
+        float wr = this->floatValue(fld_warp_rate);
+        float ww = this->floatValue(fld_warp_width);
+        float pd = this->floatValue(fld_pitch_warp_depth);
+        float fd = this->floatValue(fld_filt_warp_depth);
+
+        sineLFO.process_block(wr, 0.f, sine);
+        noiseLFO1.process_block(wr + 1, 0.f, noise);
+        noiseLFO2.process_block(wr + 1, 0.f, noise);
+        float sine = sineLFO.lastTarget;
+        float noise1 = noiseLFO1.lastTarget;
+        float noise2 = noiseLFO2.lastTarget;
+
+        float mL = sine + noise1;
+        float mR = sine + (noise1 * (1 - ww)) + (noise2 * ww);
+
+        auto freqL =
+            440 * this->noteToPitchIgnoringTuning(this->floatValue(fld_cutoff) + mL * fd * 24.f);
+        auto freqR =
+            440 * this->noteToPitchIgnoringTuning(this->floatValue(fld_cutoff) + mR * fd * 24.f);
+        freqL = std::clamp(freqL, 20.f, 20000.f);
+        freqR = std::clamp(freqR, 20.f, 20000.f);
+        auto freqFB = 440 * this->noteToPitchIgnoringTuning(this->floatValue(fld_cutoff) + 31.02f);
+        auto res = this->floatValue(fld_resonance);
+        inputFilter.template setCoeffForBlock<bs>(sst::filters::CytomicSVF::Mode::Lowpass, freqL,
+                                                  freqR, res, res, sampleRateInv, 0.f, 0.f);
+        feedbackFilter.template setCoeffForBlock<bs>(sst::filters::CytomicSVF::Mode::Lowpass,
+                                                     freqFB, freqFB, .55f, .55f, sampleRateInv,
+                                                     0.f, 0.f);
+        DCfilter.template retainCoeffForBlock<bs>();
+
+        float baseTime =
+            std::clamp(rateToSeconds(this->floatValue(fld_time)), .002f, 8.f) * this->sampleRate();
+        timeLerp.set_target(baseTime);
+        float time alignas(16)[bs];
+        timeLerp.store_block(time);
+
+        mL *= pd;
+        mR *= pd;
+        mL *= .01225f * (baseTime - .002f) + .002f;
+        mR *= .01225f * (baseTime - .002f) + .002f;
+
+        modLerpL.set_target(mL);
+        modLerpR.set_target(mR);
+        float modL alignas(16)[bs];
+        float modR alignas(16)[bs];
+        modLerpL.store_block(modL);
+        modLerpR.store_block(modR);
+
+        rateLerp.set_target(this->floatValue(fld_playrate));
+        float playrate alignas(16)[bs];
+        rateLerp.store_block(playrate);
+
+        float fb = this->floatValue(fld_feedback);
+        feedbackLerp.set_target(fb);
+        float feedback alignas(16)[bs];
+        feedbackLerp.store_block(feedback);
+
+        float dBufferL alignas(16)[bs];
+        float dBufferR alignas(16)[bs];
+
+        float smooth{1.f};
+        float smoothWindow = 256.f;
+
+        float HPfreq = 440 * this->noteToPitchIgnoringTuning(this->floatValue(fld_HP_freq));
+        HPfilter.template setCoeffForBlock<bs>(sst::filters::CytomicSVF::Mode::Highpass, HPfreq,
+                                               .55f, sampleRateInv, 0.f);
+
+        for (int i = 0; i < bs; i++)
+        {
+            auto absrate = std::fabs(playrate[i]);
+            auto absRHM = std::fabs(readHeadMove);
+            auto adjustedTime = baseTime * absrate;
+
+            if (absRHM >= adjustedTime)
+            {
+                readHeadMove = 0;
+            }
+
+            auto readPos = adjustedTime;
+            readPos -= (playrate[i] >= 0) ? readHeadMove : readPos - readHeadMove;
+            float increment = (playrate[i] >= 0) ? absrate - 1 : absrate + 1;
+            readHeadMove += increment;
+
+            auto readPosL = readPos + modL[i];
+            auto readPosR = readPos + modR[i];
+
+            readPosL = std::max(readPosL, min_delay_length);
+            readPosR = std::max(readPosR, min_delay_length);
+
+            if (playrate[i] == 1)
+            {
+                smooth = 1.f;
+
+                if (!wasOne)
+                {
+                    if (readHeadMove > 1)
+                    {
+                        readHeadMove -= 1;
+                    }
+                    else if (readHeadMove < 1)
+                    {
+                        readHeadMove += 1;
+                    }
+                    wasOne = true;
+                }
+            }
+            else
+            {
+                wasOne = false;
+                if (playrate[i] < 0)
+                {
+                    smoothWindow = 512.f;
+                }
+                auto s = std::min(std::min(smoothWindow, absRHM),
+                                  std::min(smoothWindow, adjustedTime - absRHM));
+                s = std::clamp(s, 0.f, smoothWindow);
+                smooth = s / smoothWindow;
+            }
+
+            auto fromLineL = delayLineL.read(readPosL) * smooth;
+            auto fromLineR = delayLineR.read(readPosR) * smooth;
+
+            DCfilter.processBlockStep(fromLineL, fromLineR);
+
+            dBufferL[i] = fromLineL;
+            dBufferR[i] = fromLineR;
+
+            auto inL = dataL[i];
+            auto inR = dataR[i];
+            inputFilter.processBlockStep(inL, inR);
+
+            auto toLineL = inL + feedback[i] * dBufferL[i];
+            auto toLineR = inR + feedback[i] * dBufferR[i];
+
+            feedbackFilter.processBlockStep(toLineL, toLineR);
+            softClip(toLineL, toLineR);
+
+            delayLineL.write(toLineL);
+            delayLineR.write(toLineR);
+        }
+
+        HPfilter.template processBlock<bs>(dBufferL, dBufferR, dBufferL, dBufferR);
+
+        mixLerp.set_target(this->floatValue(fld_mix));
+        mixLerp.fade_2_blocks_inplace(dataL, dBufferL, dataR, dBufferR, this->blockSize_quad);
+    }
+};
+
+TEST_CASE("Floaty Delay Matches The Per Sample Line")
+{
+    struct Run
+    {
+        const char *name;
+        float time, rate;
+    };
+    // at the shortest time, rates far from 1 sweep the read head down to the minimum delay,
+    // where the line is run a sample at a time; 0.01 sits there throughout
+    auto run = GENERATE(Run{"forward", -2.3f, 0.73f}, Run{"fast forward", -2.3f, 2.6f},
+                        Run{"reverse", -2.3f, -0.6f}, Run{"fast reverse", -2.3f, -3.1f},
+                        Run{"short forward", -5.64386f, 1.9f},
+                        Run{"short reverse", -5.64386f, -1.4f},
+                        Run{"short and slow", -5.64386f, 0.01f});
+    INFO("Run " << run.name);
+
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto es = sfx::core::ConcreteConfig::EffectStorage();
+    auto fx = std::make_unique<FX>(&gs, &es, nullptr);
+    auto ref = std::make_unique<FloatyReference>(&gs, &es, nullptr);
+    for (int i = 0; i < FX::numParams; ++i)
+    {
+        fx->paramStorage[i] = fx->paramAt(i).defaultVal;
+        ref->paramStorage[i] = ref->paramAt(i).defaultVal;
+    }
+    auto set = [&](int p, float v) {
+        fx->paramStorage[p] = v;
+        ref->paramStorage[p] = v;
+    };
+    set(FX::fld_time, run.time);
+    set(FX::fld_feedback, 0.7f);
+    set(FX::fld_pitch_warp_depth, 0.4f);
+    set(FX::fld_filt_warp_depth, 0.3f);
+    set(FX::fld_warp_width, 0.5f);
+    set(FX::fld_mix, 1.f);
+    fx->initialize();
+    ref->initialize();
+
+    for (int blk = 0; blk < 6000; ++blk)
+    {
+        // away from 1 and back again, so the head winds back as it re-enters rate 1
+        set(FX::fld_playrate, (blk % 2000 < 1500) ? run.rate : 1.f);
+
+        float L alignas(16)[bs], R alignas(16)[bs];
+        for (int k = 0; k < bs; ++k)
+        {
+            L[k] = noise(gen);
+            R[k] = noise(gen);
+        }
+        float rL alignas(16)[bs], rR alignas(16)[bs];
+        std::copy(L, L + bs, rL);
+        std::copy(R, R + bs, rR);
+
+        fx->processBlock(L, R);
+        ref->processBlock(rL, rR);
+        for (int k = 0; k < bs; ++k)
+        {
+            INFO("Block " << blk << " sample " << k);
+            REQUIRE(L[k] == rL[k]);
+            REQUIRE(R[k] == rR[k]);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <memory>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/voice-effects/delay/DelaySupport.h"
+
+TEST_CASE("Paired Sinc Line Reads As Two Sinc Lines")
+{
+    static constexpr int combSize{1 << 12};
+    using table_t = sst::basic_blocks::tables::SurgeSincTableProvider;
+    using paired_t = sst::voice_effects::delay::details::PairedSincDelayLine<combSize>;
+    using line_t = sst::basic_blocks::dsp::SSESincDelayLine<combSize>;
+    auto st = std::make_unique<table_t>();
+
+    auto paired = std::make_unique<paired_t>(*st);
+    auto one = std::make_unique<line_t>(*st);
+    auto two = std::make_unique<line_t>(*st);
+
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> sample(-1.f, 1.f);
+    // from a few samples, through the wrap copy, to most of the line
+    std::uniform_real_distribution<float> delay(2.f, combSize - 64.f);
+
+    // run past the length of the line a few times so reads straddle the wrap
+    for (int i = 0; i < 5 * combSize; ++i)
+    {
+        auto a = sample(gen), b = sample(gen);
+        paired->write(a, b);
+        one->write(a);
+        two->write(b);
+
+        auto dOne = (i % 3 == 0) ? 2.f + (i % 17) * 0.37f : delay(gen);
+        auto dTwo = delay(gen);
+        float pOne, pTwo;
+        paired->read(dOne, dTwo, pOne, pTwo);
+
+        INFO("Sample " << i << " delays " << dOne << " " << dTwo);
+        REQUIRE(pOne == Approx(one->read(dOne)).margin(1e-6));
+        REQUIRE(pTwo == Approx(two->read(dTwo)).margin(1e-6));
+        REQUIRE(paired->read(dOne) == Approx(pOne).margin(1e-6));
+    }
+}
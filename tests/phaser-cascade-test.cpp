@@ -0,0 +1,126 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/effects/ConcreteConfig.h"
+#include "sst/effects/Phaser.h"
+
+namespace sfx = sst::effects;
+using FX = sfx::phaser::Phaser<sfx::core::ConcreteConfig>;
+static constexpr int bs{sfx::core::ConcreteConfig::blockSize};
+
+// the cascade against what it replaced: a BiquadFilter per stage and channel, as the
+// Phaser ran them before
+TEST_CASE("Phaser Allpass Cascade Matches Chained BiquadFilters")
+{
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::uniform_real_distribution<double> wd(0.001, 3.1), qd(1.0, 1.8), ud(0, 1);
+
+    auto gs = sfx::core::ConcreteConfig::GlobalStorage(48000);
+    auto cascade = std::make_unique<FX::AllpassCascade>();
+    std::vector<FX::BiquadFilter> ref(2 * FX::max_stages, FX::BiquadFilter(&gs));
+
+    double omega[FX::max_stages][2];
+    auto design = [&](int n, double q) {
+        for (int i = 0; i < n; ++i)
+        {
+            for (int c = 0; c < 2; ++c)
+            {
+                cascade->omega[i][c] = omega[i][c];
+                ref[2 * i + c].coeff_APF(omega[i][c], q);
+            }
+        }
+        cascade->setAllpassTargets(n, q);
+    };
+    auto pick = [&]() {
+        for (auto &st : omega)
+        {
+            for (auto &w : st)
+            {
+                w = wd(gen);
+                // now and then out of range, where coeff_APF makes the stage a wire
+                auto u = ud(gen);
+                if (u < 0.03)
+                    w = -w;
+                else if (u < 0.06)
+                    w += M_PI;
+            }
+        }
+    };
+
+    // 1 is the legacy mode, which designs two stages and runs one
+    for (auto n : {4, 16, 1, 7, 12})
+    {
+        INFO("Stages " << n);
+        auto designed = n < 2 ? 2 : n;
+        auto q = qd(gen);
+        pick();
+
+        for (int blk = 0; blk < 1500; ++blk)
+        {
+            // steady stretches long enough to settle, then a sweep updated every block
+            if (blk == 0)
+            {
+                design(designed, q);
+            }
+            else if (blk > 500 && blk < 900)
+            {
+                for (auto &st : omega)
+                    for (auto &w : st)
+                        w *= 1.0 + 0.01 * std::sin(blk * 0.05);
+                design(designed, q);
+            }
+            else if (blk == 1200)
+            {
+                // initialize, which should take the next coefficients at once
+                cascade->suspend();
+                for (auto &r : ref)
+                    r.suspend();
+                pick();
+                design(designed, q);
+            }
+
+            cascade->beginBlock(n);
+            for (int s = 0; s < bs; ++s)
+            {
+                float l = noise(gen), r = noise(gen);
+                float rl = l, rr = r;
+                cascade->process(n, s, l, r);
+                for (int i = 0; i < n; ++i)
+                {
+                    rl = ref[2 * i].process_sample(rl);
+                    rr = ref[2 * i + 1].process_sample(rr);
+                }
+                INFO("Block " << blk << " sample " << s);
+                REQUIRE(l == Approx(rl).margin(2e-6));
+                REQUIRE(r == Approx(rr).margin(2e-6));
+            }
+            cascade->endBlock(n);
+        }
+    }
+}
@@ -25,6 +25,9 @@
 #include "sst/basic-blocks/simd/setup.h"
 
 #include "sst/effects/EffectCore.h"
+#include "sst/voice-effects/generator/GenCorrelatedNoise.h"
+
+#include "vtest-config.h"
 
 struct NoExtraConfig
 {
@@ -99,6 +102,41 @@ struct ExtraConfig : NoExtraConfig
     static int deformType(EffectStorage *s, int idx) { return 7; }
 };
 
+struct ProfiledConfig : NoExtraConfig
+{
+    static inline int begins{0}, ends{0};
+    static inline const char *lastName{nullptr};
+    static void onProcessBegin(BaseClass *, const char *n)
+    {
+        begins++;
+        lastName = n;
+    }
+    static void onProcessEnd(BaseClass *, const char *n) { ends++; }
+};
+
+struct ProfiledVConfig : VTestConfig
+{
+    static inline int begins{0}, ends{0};
+    static void onProcessBegin(BaseClass *, const char *) { begins++; }
+    static void onProcessEnd(BaseClass *, const char *) { ends++; }
+};
+
+struct PooledConfig : NoExtraConfig
+{
+    static inline size_t outstanding{0}, reserved{0};
+    static void preReservePool(GlobalStorage *, size_t s) { reserved = s; }
+    static uint8_t *checkoutBlock(GlobalStorage *, size_t s)
+    {
+        outstanding += s;
+        return (uint8_t *)malloc(s);
+    }
+    static void returnBlock(GlobalStorage *, uint8_t *d, size_t s)
+    {
+        outstanding -= s;
+        free(d);
+    }
+};
+
 TEST_CASE("SFINAE gives us extras")
 {
     SECTION("On Missing")
@@ -123,4 +161,86 @@ TEST_CASE("SFINAE gives us extras")
         REQUIRE(ec->temposyncRatioInv(0) == 0.5f);
         REQUIRE(ec->deformType(0) == 7);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("SFINAE gives us profile hooks")
+{
+    SECTION("On Missing")
+    {
+        auto ec = std::make_unique<sst::effects::core::EffectTemplateBase<NoExtraConfig>>(
+            nullptr, nullptr, nullptr);
+        REQUIRE(std::is_empty_v<decltype(ec->processProfileScope("test"))>);
+    }
+
+    SECTION("On Not Missing")
+    {
+        auto ec = std::make_unique<sst::effects::core::EffectTemplateBase<ProfiledConfig>>(
+            nullptr, nullptr, nullptr);
+        {
+            auto profile = ec->processProfileScope("test");
+            REQUIRE(ProfiledConfig::begins == 1);
+            REQUIRE(ProfiledConfig::ends == 0);
+        }
+        REQUIRE(ProfiledConfig::begins == 1);
+        REQUIRE(ProfiledConfig::ends == 1);
+        REQUIRE(std::string(ProfiledConfig::lastName) == "test");
+    }
+}
+
+TEST_CASE("Voice effects scope every process entry point")
+{
+    using fx_t = sst::voice_effects::generator::GenCorrelatedNoise<ProfiledVConfig>;
+    static constexpr int bs{ProfiledVConfig::blockSize};
+    float in alignas(16)[bs]{}, outL alignas(16)[bs], outR alignas(16)[bs];
+
+    auto fx = std::make_unique<fx_t>();
+    fx->initVoiceEffectParams();
+
+    for (auto stereo : {0, 1})
+    {
+        INFO("Stereo switch " << stereo);
+        fx->setIntParam(fx_t::ipStereo, stereo);
+
+        auto expectOnePair = [](auto &&f) {
+            auto b = ProfiledVConfig::begins, e = ProfiledVConfig::ends;
+            f();
+            REQUIRE(ProfiledVConfig::begins == b + 1);
+            REQUIRE(ProfiledVConfig::ends == e + 1);
+        };
+
+        expectOnePair([&]() { fx->processStereo(in, in, outL, outR, 0); });
+        expectOnePair([&]() { fx->processMonoToMono(in, outL, 0); });
+        expectOnePair([&]() { fx->processMonoToStereo(in, outL, outR, 0); });
+    }
+}
+
+TEST_CASE("SFINAE gives us memory pools")
+{
+    SECTION("On Missing")
+    {
+        auto ec = std::make_unique<sst::effects::core::EffectTemplateBase<NoExtraConfig>>(
+            nullptr, nullptr, nullptr);
+        REQUIRE(!ec->hasMemoryPool());
+        sst::effects::core::EffectMemoryBlock<NoExtraConfig> mb(ec.get());
+        REQUIRE(mb.resize(1024));
+        REQUIRE(mb.data);
+        REQUIRE(mb.as<float>()[17] == 0.f);
+        REQUIRE(!mb.resize(1024));
+    }
+
+    SECTION("On Not Missing")
+    {
+        auto ec = std::make_unique<sst::effects::core::EffectTemplateBase<PooledConfig>>(
+            nullptr, nullptr, nullptr);
+        REQUIRE(ec->hasMemoryPool());
+        {
+            sst::effects::core::EffectMemoryBlock<PooledConfig> mb(ec.get());
+            mb.resize(1024);
+            REQUIRE(PooledConfig::reserved == 1024);
+            REQUIRE(PooledConfig::outstanding == 1024);
+            mb.resize(2048);
+            REQUIRE(PooledConfig::outstanding == 2048);
+        }
+        REQUIRE(PooledConfig::outstanding == 0);
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+#include "sst/basic-blocks/dsp/BlockInterpolators.h"
+#include "sst/filters/CytomicSVF.h"
+
+#include "sst/voice-effects/modulation/ShepardPhaser.h"
+
+#include "vtest-config.h"
+
+static constexpr int bs{VTestConfig::blockSize};
+
+struct ShepardBankProbe : sst::voice_effects::modulation::ShepardPhaser<VTestConfig>
+{
+    using bank_t = BandpassBank;
+};
+using bank_t = ShepardBankProbe::bank_t;
+
+// the bank against what it replaced: a CytomicSVF per peak with its level lerped over the
+// block, summed into the output peak by peak, as the ShepardPhaser ran them before
+TEST_CASE("Shepard Phaser Bandpass Bank Matches Lerped CytomicSVFs")
+{
+    using svf_t = sst::filters::CytomicSVF;
+    using lerp_t = sst::basic_blocks::dsp::lipol_sse<bs, true>;
+    static constexpr int maxPeaks{bank_t::maxPeaks};
+    static constexpr float srInv{1.f / 48000.f};
+
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+
+    for (auto stereo : {true, false})
+    {
+        INFO("Stereo " << stereo);
+        auto bank = std::make_unique<bank_t>();
+        bank->init();
+        std::array<svf_t, maxPeaks> ref;
+        lerp_t lerpL, lerpR;
+        float priorL[maxPeaks], priorR[maxPeaks];
+        for (int p = 0; p < maxPeaks; ++p)
+        {
+            ref[p].init();
+            priorL[p] = -1.f;
+            priorR[p] = -1.f;
+        }
+
+        double phase{0};
+        int blk{0};
+        // changing the count drops peaks mid-sweep and brings them back from where they stopped
+        for (auto peaks : {4, 1, 5, 12, 4, 12, 1, 5})
+        {
+            INFO("Peaks " << peaks);
+            auto res = 0.9f + 0.08f * (blk % 3) / 2.f;
+            auto scale = 1.f / std::log2f(peaks + 1.f);
+            for (int b = 0; b < 400; ++b, ++blk)
+            {
+                // the effect's own sweep: ramped frequencies under cubed triangle levels
+                phase = std::fmod(phase + 0.0037, 1.0);
+                float levelL[maxPeaks], levelR[maxPeaks], freqL[maxPeaks], freqR[maxPeaks];
+                for (int p = 0; p < peaks; ++p)
+                {
+                    auto phL = std::fmod(phase + (double)p / peaks, 1.0);
+                    auto phR = stereo ? std::fmod(phL + 0.5 / peaks, 1.0) : phL;
+                    auto tri = [](double x) {
+                        auto t = x < 0.5 ? 4 * x - 1 : 1 - 4 * (x - 0.5);
+                        t = t * .5 + .5;
+                        return (float)(t * t * t);
+                    };
+                    levelL[p] = tri(phL);
+                    levelR[p] = tri(phR);
+                    freqL[p] = 440.f * std::pow(2.f, (float)(-40 + 100 * phL) / 12.f);
+                    freqR[p] = 440.f * std::pow(2.f, (float)(-40 + 100 * phR) / 12.f);
+                    bank->setLevel(p, levelL[p], levelR[p]);
+                    bank->setFreq(p, freqL[p], freqR[p]);
+                }
+                bank->setCoefficients(peaks, res, srInv);
+
+                float inL alignas(16)[bs], inR alignas(16)[bs];
+                for (int k = 0; k < bs; ++k)
+                {
+                    inL[k] = noise(gen);
+                    inR[k] = stereo ? noise(gen) : inL[k];
+                }
+                float outL alignas(16)[bs], outR alignas(16)[bs];
+                const float *const in[2]{inL, inR};
+                float *const out[2]{outL, outR};
+                if (stereo)
+                    bank->template process<2>(peaks, in, scale, out);
+                else
+                    bank->template process<1>(peaks, in, scale, out);
+
+                float refL alignas(16)[bs]{}, refR alignas(16)[bs]{};
+                for (int p = 0; p < peaks; ++p)
+                {
+                    if (priorL[p] < 0)
+                        priorL[p] = levelL[p];
+                    if (priorR[p] < 0)
+                        priorR[p] = levelR[p];
+                    lerpL.set_target_instant(priorL[p]);
+                    lerpR.set_target_instant(priorR[p]);
+                    lerpL.set_target(levelL[p]);
+                    lerpR.set_target(levelR[p]);
+                    priorL[p] = levelL[p];
+                    priorR[p] = levelR[p];
+
+                    float tmpL alignas(16)[bs], tmpR alignas(16)[bs];
+                    if (stereo)
+                    {
+                        ref[p].template setCoeffForBlock<bs>(svf_t::Mode::Bandpass, freqL[p],
+                                                             freqR[p], res, res, srInv, 1.f, 1.f);
+                        for (int k = 0; k < bs; ++k)
+                        {
+                            tmpL[k] = inL[k];
+                            tmpR[k] = inR[k];
+                            ref[p].processBlockStep(tmpL[k], tmpR[k]);
+                        }
+                        lerpL.multiply_block(tmpL);
+                        lerpR.multiply_block(tmpR);
+                    }
+                    else
+                    {
+                        ref[p].template setCoeffForBlock<bs>(svf_t::Mode::Bandpass, freqL[p], res,
+                                                             srInv, 1.f);
+                        for (int k = 0; k < bs; ++k)
+                        {
+                            tmpL[k] = inL[k];
+                            ref[p].processBlockStep(tmpL[k]);
+                        }
+                        lerpL.multiply_block(tmpL);
+                    }
+                    for (int k = 0; k < bs; ++k)
+                    {
+                        refL[k] += tmpL[k] * scale;
+                        if (stereo)
+                            refR[k] += tmpR[k] * scale;
+                    }
+                }
+
+                for (int k = 0; k < bs; ++k)
+                {
+                    INFO("Block " << blk << " sample " << k);
+                    REQUIRE(outL[k] == Approx(refL[k]).margin(2e-5));
+                    if (stereo)
+                        REQUIRE(outR[k] == Approx(refR[k]).margin(2e-5));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,242 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <cstring>
+#include <random>
+#include <vector>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/effects-shared/SIMDKernels.h"
+
+namespace sfxs = sst::effects_shared;
+namespace kern = sst::effects_shared::kernels;
+
+static constexpr size_t bs{16};
+
+// Every level up to the one this machine has, so each wider variant is checked against sse2
+template <typename F> void forEachAvailableLevel(F &&f)
+{
+    for (auto l : {sfxs::SIMDLevel::SSE2, sfxs::SIMDLevel::AVX2, sfxs::SIMDLevel::AVX512})
+    {
+        if (l > sfxs::simdLevel())
+            break;
+        INFO("SIMD level " << sfxs::simdLevelName(l));
+        f(l);
+    }
+}
+
+TEST_CASE("SIMD Dispatch Kernels Match SSE2")
+{
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    auto fill = [&](float *f, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = dist(gen);
+    };
+
+    INFO("Running on " << sfxs::simdLevelName(sfxs::simdLevel()));
+
+    SECTION("Mid Side")
+    {
+        float L[bs], R[bs], M0[bs], S0[bs], L0[bs], R0[bs];
+        fill(L, bs);
+        fill(R, bs);
+        kern::MSEncode<bs>::sse2(L, R, M0, S0);
+        kern::MSDecode<bs>::sse2(M0, S0, L0, R0);
+
+        forEachAvailableLevel([&](auto l) {
+            float M[bs], S[bs], L1[bs], R1[bs];
+            sfxs::DispatchedKernel<kern::MSEncode<bs>>::forLevel(l)(L, R, M, S);
+            sfxs::DispatchedKernel<kern::MSDecode<bs>>::forLevel(l)(M, S, L1, R1);
+            REQUIRE(memcmp(M, M0, sizeof(M)) == 0);
+            REQUIRE(memcmp(S, S0, sizeof(S)) == 0);
+            REQUIRE(memcmp(L1, L0, sizeof(L1)) == 0);
+            REQUIRE(memcmp(R1, R0, sizeof(R1)) == 0);
+        });
+    }
+
+    SECTION("Fade")
+    {
+        float aL[bs], bL[bs], aR[bs], bR[bs], g[bs];
+        fill(aL, bs);
+        fill(bL, bs);
+        fill(aR, bs);
+        fill(bR, bs);
+        fill(g, bs);
+
+        float rL[bs], rR[bs];
+        memcpy(rL, aL, sizeof(rL));
+        memcpy(rR, aR, sizeof(rR));
+        kern::Fade2BlocksInplace<bs>::sse2(rL, bL, rR, bR, g);
+
+        forEachAvailableLevel([&](auto l) {
+            float tL[bs], tR[bs];
+            memcpy(tL, aL, sizeof(tL));
+            memcpy(tR, aR, sizeof(tR));
+            sfxs::DispatchedKernel<kern::Fade2BlocksInplace<bs>>::forLevel(l)(tL, bL, tR, bR, g);
+            REQUIRE(memcmp(tL, rL, sizeof(tL)) == 0);
+            REQUIRE(memcmp(tR, rR, sizeof(tR)) == 0);
+        });
+    }
+
+    SECTION("Width And Mix")
+    {
+        float L[bs], R[bs], wS[bs], wM[bs], dL[bs], dR[bs], g[bs], o[bs];
+        fill(L, bs);
+        fill(R, bs);
+        fill(wS, bs);
+        fill(wM, bs);
+        fill(dL, bs);
+        fill(dR, bs);
+        fill(g, bs);
+        fill(o, bs);
+
+        // the unfused path: encode, scale, decode, then fade
+        float M[bs], S[bs], rL[bs], rR[bs], mL[bs], mR[bs];
+        kern::MSEncode<bs>::sse2(L, R, M, S);
+        for (size_t i = 0; i < bs; ++i)
+        {
+            S[i] *= wS[i];
+            M[i] *= wM[i];
+        }
+        kern::MSDecode<bs>::sse2(M, S, rL, rR);
+        memcpy(mL, dL, sizeof(mL));
+        memcpy(mR, dR, sizeof(mR));
+        kern::Fade2BlocksInplace<bs>::sse2(mL, rL, mR, rR, g);
+
+        forEachAvailableLevel([&](auto l) {
+            float tL[bs], tR[bs];
+            memcpy(tL, L, sizeof(tL));
+            memcpy(tR, R, sizeof(tR));
+            sfxs::DispatchedKernel<kern::MSWidth<bs, true>>::forLevel(l)(tL, tR, wS, wM);
+            REQUIRE(memcmp(tL, rL, sizeof(tL)) == 0);
+            REQUIRE(memcmp(tR, rR, sizeof(tR)) == 0);
+
+            memcpy(tL, dL, sizeof(tL));
+            memcpy(tR, dR, sizeof(tR));
+            sfxs::DispatchedKernel<kern::MSWidthFade2BlocksInplace<bs, true>>::forLevel(l)(
+                tL, L, tR, R, wS, wM, g, nullptr);
+            REQUIRE(memcmp(tL, mL, sizeof(tL)) == 0);
+            REQUIRE(memcmp(tR, mR, sizeof(tR)) == 0);
+        });
+
+        // with an output gain, the faded result multiplied afterwards
+        float oL[bs], oR[bs];
+        for (size_t i = 0; i < bs; ++i)
+        {
+            oL[i] = mL[i] * o[i];
+            oR[i] = mR[i] * o[i];
+        }
+
+        forEachAvailableLevel([&](auto l) {
+            float tL[bs], tR[bs];
+            memcpy(tL, dL, sizeof(tL));
+            memcpy(tR, dR, sizeof(tR));
+            sfxs::DispatchedKernel<kern::MSWidthFade2BlocksInplace<bs, true, true>>::forLevel(
+                l)(tL, L, tR, R, wS, wM, g, o);
+            REQUIRE(memcmp(tL, oL, sizeof(tL)) == 0);
+            REQUIRE(memcmp(tR, oR, sizeof(tR)) == 0);
+        });
+
+        // without scaleMid the mid passes through and wM is ignored
+        kern::MSEncode<bs>::sse2(L, R, M, S);
+        for (size_t i = 0; i < bs; ++i)
+            S[i] *= wS[i];
+        kern::MSDecode<bs>::sse2(M, S, rL, rR);
+
+        forEachAvailableLevel([&](auto l) {
+            float tL[bs], tR[bs];
+            memcpy(tL, L, sizeof(tL));
+            memcpy(tR, R, sizeof(tR));
+            sfxs::DispatchedKernel<kern::MSWidth<bs, false>>::forLevel(l)(tL, tR, wS, wM);
+            REQUIRE(memcmp(tL, rL, sizeof(tL)) == 0);
+            REQUIRE(memcmp(tR, rR, sizeof(tR)) == 0);
+        });
+    }
+
+    SECTION("Sinc Read")
+    {
+        static constexpr int N{12}, lineSize{1024}, tableSize{257 * N};
+        std::vector<float> table(tableSize), line(lineSize + N);
+        fill(table.data(), table.size());
+        fill(line.data(), line.size());
+
+        // unaligned offsets on purpose; callers read at arbitrary phases
+        int tOff[bs], bOff[bs];
+        std::uniform_int_distribution<int> tpos(0, tableSize - N), bpos(0, lineSize - 1);
+        for (size_t k = 0; k < bs; ++k)
+        {
+            tOff[k] = tpos(gen);
+            bOff[k] = bpos(gen);
+        }
+
+        float ref[bs];
+        kern::SincReadBlock<N>::sse2(table.data(), tOff, line.data(), bOff, ref, bs);
+        for (size_t k = 0; k < bs; ++k)
+        {
+            float s{0};
+            for (int i = 0; i < N; ++i)
+                s += table[tOff[k] + i] * line[bOff[k] + i];
+            REQUIRE(ref[k] == Approx(s).margin(1e-5));
+        }
+
+        forEachAvailableLevel([&](auto l) {
+            float out[bs];
+            sfxs::DispatchedKernel<kern::SincReadBlock<N>>::forLevel(l)(table.data(), tOff,
+                                                                        line.data(), bOff, out, bs);
+            REQUIRE(memcmp(out, ref, sizeof(out)) == 0);
+        });
+    }
+
+    SECTION("Stereo Sinc Read")
+    {
+        static constexpr int N{12}, lineSize{1024}, tableSize{257 * N};
+        std::vector<float> table(tableSize), lineL(lineSize + N), lineR(lineSize + N);
+        fill(table.data(), table.size());
+        fill(lineL.data(), lineL.size());
+        fill(lineR.data(), lineR.size());
+
+        int tOffL[bs], tOffR[bs], bOffL[bs], bOffR[bs];
+        std::uniform_int_distribution<int> tpos(0, tableSize - N), bpos(0, lineSize - 1);
+        for (size_t k = 0; k < bs; ++k)
+        {
+            tOffL[k] = tpos(gen);
+            tOffR[k] = tpos(gen);
+            bOffL[k] = bpos(gen);
+            bOffR[k] = bpos(gen);
+        }
+
+        // the same as two mono reads, bit for bit
+        float refL[bs], refR[bs];
+        kern::SincReadBlock<N>::sse2(table.data(), tOffL, lineL.data(), bOffL, refL, bs);
+        kern::SincReadBlock<N>::sse2(table.data(), tOffR, lineR.data(), bOffR, refR, bs);
+
+        forEachAvailableLevel([&](auto l) {
+            float outL[bs], outR[bs];
+            sfxs::DispatchedKernel<kern::SincReadBlock2<N>>::forLevel(l)(
+                table.data(), tOffL, tOffR, lineL.data(), lineR.data(), bOffL, bOffR, outL, outR,
+                bs);
+            REQUIRE(memcmp(outL, refL, sizeof(outL)) == 0);
+            REQUIRE(memcmp(outR, refR, sizeof(outR)) == 0);
+        });
+    }
+}
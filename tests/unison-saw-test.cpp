@@ -0,0 +1,188 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include "catch2.hpp"
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "sst/voice-effects/generator/UnisonEBSaw.h"
+
+static constexpr int bs{16};
+using saw_t = sst::voice_effects::generator::UnisonEBSaw<bs>;
+
+// one voice at a time, with the phase arithmetic done as the lanes do it and each edge's
+// correction from the exact exponentials of the elliptic design the tables were fitted to
+struct ReferenceSaw
+{
+    using cplx = std::complex<double>;
+    // pole, residue; the conjugates of the complex ones are folded in by doubling
+    static constexpr double design[4][2][2]{
+        {{-0.09341338215163536, 2.5270018910049679},
+         {-0.024603569194289718, -0.097466654343888987}},
+        {{-0.32514202851526441, 2.1831585785329821}, {0.24377825929708588, 0.26628424129430339}},
+        {{-0.62338398043627996, 1.346436589761048}, {-0.69219379339362974, -0.2580869207366695}},
+        {{-0.78951061449878912, 0}, {0.9522381529351277, 0}}};
+
+    float s{0}, m{0}, ds{0}, dm{0}, nds{0}, ndm{0};
+    bool first{true};
+    cplx z[4]{};
+
+    void setFrequency(double freq, float ratio, double srInv)
+    {
+        ndm = std::clamp((float)(freq * srInv), 0.f, 0.5f);
+        nds = std::min(ndm * ratio, 0.5f);
+        if (first)
+        {
+            dm = ndm;
+            ds = nds;
+            first = false;
+        }
+    }
+
+    void blep(double t, double size)
+    {
+        for (int p = 0; p < 4; ++p)
+        {
+            cplx pole{design[p][0][0], design[p][0][1]}, res{design[p][1][0], design[p][1][1]};
+            z[p] += size * (p < 3 ? 2.0 : 1.0) * res / pole * std::exp(pole * t);
+        }
+    }
+
+    void block(bool sync, float *out)
+    {
+        auto dds = (nds - ds) * (1.f / bs), ddm = (ndm - dm) * (1.f / bs);
+        for (int k = 0; k < bs; ++k)
+        {
+            ds += dds;
+            float tm{0};
+            bool restart{false};
+            if (sync)
+            {
+                dm += ddm;
+                m += dm;
+                restart = m >= 1.f;
+                if (restart)
+                {
+                    tm = (m - 1.f) / dm;
+                    m -= 1.f;
+                }
+            }
+            s = s + ds * (1.f - tm);
+            if (s >= 1.f)
+            {
+                auto t = (s - 1.f) / ds + tm;
+                s -= 1.f;
+                blep(std::min(t, 1.f), -2.0);
+            }
+            if (restart)
+            {
+                blep(std::min(tm, 1.f), -2.0 * s);
+                s = ds * tm;
+            }
+
+            double y = 2.f * (s - saw_t::groupDelay * ds) - 1.f;
+            for (auto &zp : z)
+                y += zp.real();
+            out[k] = (float)y;
+
+            for (int p = 0; p < 4; ++p)
+                z[p] *= std::exp(cplx{design[p][0][0], design[p][0][1]});
+        }
+        if (!sync)
+            m = s;
+        ds = nds;
+        dm = ndm;
+    }
+};
+
+TEST_CASE("Unison EB Saw Lanes Match Voice At A Time Saws")
+{
+    static constexpr double srInv{1.0 / 48000.0};
+    static constexpr int maxVoices{saw_t::maxVoices};
+
+    std::mt19937 gen(8675309);
+    std::uniform_real_distribution<float> gd(0.1f, 1.f), ph(0.f, 1.f);
+    std::uniform_real_distribution<double> fd(30.0, 6000.0), drift(0.98, 1.02);
+
+    for (auto stereo : {true, false})
+    {
+        INFO("Stereo " << stereo);
+        auto saw = std::make_unique<saw_t>();
+        saw->setSampleRate(48000);
+        ReferenceSaw ref[maxVoices];
+        double freq[maxVoices];
+        float gainL alignas(16)[maxVoices], gainR alignas(16)[maxVoices];
+        for (int v = 0; v < maxVoices; ++v)
+        {
+            auto p = ph(gen);
+            saw->setInitialPhase(v, p, 1.f);
+            ref[v].m = p;
+            ref[v].s = p;
+            freq[v] = fd(gen);
+            gainL[v] = gd(gen);
+            gainR[v] = gd(gen);
+        }
+
+        int blk{0};
+        // voices drop out holding their state and come back; sync comes and goes
+        for (auto [voices, ratio] : {std::pair{7, 1.f}, {1, 1.f}, {5, 3.7f}, {8, 3.7f},
+                                     {4, 1.f}, {8, 1.f}, {3, 1.9f}, {7, 1.f}})
+        {
+            INFO("Voices " << voices << " sync " << ratio);
+            saw->setSyncRatio(ratio);
+            for (int b = 0; b < 300; ++b, ++blk)
+            {
+                float out[2][bs], expect[2][bs]{};
+                for (int v = 0; v < voices; ++v)
+                {
+                    // a drifting frequency, ramped across each block
+                    freq[v] = std::clamp(freq[v] * drift(gen), 30.0, 6000.0);
+                    saw->setFrequency(v, freq[v]);
+                    ref[v].setFrequency(freq[v], ratio, srInv);
+
+                    float y[bs];
+                    ref[v].block(ratio > 1.f, y);
+                    for (int k = 0; k < bs; ++k)
+                    {
+                        expect[0][k] += gainL[v] * y[k];
+                        expect[1][k] += gainR[v] * y[k];
+                    }
+                }
+                if (stereo)
+                    saw->template process<true>(voices, gainL, gainR, out[0], out[1]);
+                else
+                    saw->template process<false>(voices, gainL, gainR, out[0], nullptr);
+
+                for (int k = 0; k < bs; ++k)
+                {
+                    INFO("Block " << blk << " sample " << k);
+                    REQUIRE(out[0][k] == Approx(expect[0][k]).margin(1e-5));
+                    if (stereo)
+                        REQUIRE(out[1][k] == Approx(expect[1][k]).margin(1e-5));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * sst-effects - an open source library of audio effects
+ * built by Surge Synth Team.
+ *
+ * Copyright 2018-2023, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-effects is released under the GNU General Public Licence v3
+ * or later (GPL-3.0-or-later). The license is found in the "LICENSE"
+ * file in the root of this repository, or at
+ * https://www.gnu.org/licenses/gpl-3.0.en.html
+ *
+ * The majority of these effects at initiation were factored from
+ * Surge XT, and so git history prior to April 2023 is found in the
+ * surge repo, https://github.com/surge-synthesizer/surge
+ *
+ * All source in sst-effects available at
+ * https://github.com/surge-synthesizer/sst-effects
+ */
+
+#ifndef INCLUDE_SST_EFFECTS_TESTS_VTEST_CONFIG_H
+#define INCLUDE_SST_EFFECTS_TESTS_VTEST_CONFIG_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// The voice effect config the tests share: a param array base, malloc pooling, 48k
+struct VTestConfig
+{
+    struct BaseClass
+    {
+        std::array<float, 256> fb{};
+        std::array<int, 256> ib{};
+    };
+    static constexpr int blockSize{16};
+    static void setFloatParam(BaseClass *b, int i, float f) { b->fb[i] = f; }
+    static float getFloatParam(const BaseClass *b, int i) { return b->fb[i]; }
+
+    static void setIntParam(BaseClass *b, int i, int v) { b->ib[i] = v; }
+    static int getIntParam(const BaseClass *b, int i) { return b->ib[i]; }
+
+    static float dbToLinear(const BaseClass *, float f) { return std::pow(10.f, f / 20.f); }
+    static float equalNoteToPitch(const BaseClass *, float f) { return pow(2.f, (f + 69) / 12.f); }
+    static float getSampleRate(const BaseClass *) { return 48000.f; }
+    static float getSampleRateInv(const BaseClass *) { return 1.0 / 48000.f; }
+
+    static void preReservePool(BaseClass *, size_t) {}
+    static void preReserveSingleInstancePool(BaseClass *, size_t) {}
+    static uint8_t *checkoutBlock(BaseClass *, size_t s) { return (uint8_t *)malloc(s); }
+    static void returnBlock(BaseClass *, uint8_t *p, size_t) { free(p); }
+};
+
+#endif // INCLUDE_SST_EFFECTS_TESTS_VTEST_CONFIG_H